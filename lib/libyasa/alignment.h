@@ -19,7 +19,7 @@ limitations under the License.
 #ifndef JAPA_ALIGNMENT_H
 #define JAPA_ALIGNMENT_H
 
-#include <list>
+#include <vector>
 #include "dynamictable.h"
 
 namespace japa
@@ -221,28 +221,36 @@ private :
  * \french
  * Construit un alignement de deux textes � partir d'une table dynamique.
  *
+ * La solution est parcourue � rebours et les alignements sont �crits dans un
+ * tableau contigu r�serv� d'avance, de la fin vers le d�but, ce qui �vite une
+ * allocation par alignement.
+ *
  * @param iter Un it�rateur sur la solution du meilleur alignement.
  *
- * @return Les alignements des phrases des textes.
+ * @return Les alignements des phrases des textes, dans l'ordre des textes.
  * \endfrench
  *
  * \english
  * Generate a bi-texte alignment based on a dynamic table.
  *
+ * The solution is walked backwards and the alignments are written into a
+ * contiguous array reserved beforehand, from its end to its beginning, which
+ * avoids one allocation per alignment.
+ *
  * @param iter An iterator on the best alignment solution.
  *
- * @return The alignment between source and target texts.
+ * @return The alignment between source and target texts, in the texts'
+ *         order.
  * \endenglish
  */
 template< class T >
-std::list< Alignment< T > > buildAlignment( 
+std::vector< Alignment< T > > buildAlignment( 
         typename DynamicTable< T >::Iterator& iter )
 {
-    size_t lasti, lastj, i, j;
+    size_t lasti, lastj, i, j, first;
     double score;
     Alignment< T > align;
-    std::list< Alignment< T > > l;
-    
+    std::vector< Alignment< T > > l;
     
     if( iter.hasNext() )
     {
@@ -250,6 +258,11 @@ std::list< Alignment< T > > buildAlignment(
         i = iter.i();
         j = iter.j();
 
+        // Chaque alignement couvre au moins une phrase : il y en a donc au
+        // plus i + j.  Le tableau est rempli � partir de la fin.
+        l.resize( i + j );
+        first = l.size();
+
         // Ajoute les alignements.
         while( iter.hasNext() )
         {       
@@ -264,8 +277,18 @@ std::list< Alignment< T > > buildAlignment(
             align.setTargetLength( lastj - j );
             align.setScore( score );
 
-            l.push_front( align );
+            if( first != 0 )
+            {
+                l[ --first ] = align;
+            }
+            else
+            {
+                l.insert( l.begin(), align );
+            }
         }
+
+        // Retire la place inutilis�e du d�but
+        l.erase( l.begin(), l.begin() + first );
     }
     
     return l;
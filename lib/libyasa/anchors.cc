@@ -0,0 +1,188 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <algorithm>
+
+#include "anchors.h"
+#include "japaexception.h"
+#include "toolbox.h"
+
+namespace japa
+{
+
+/**
+ * V�rifie si un point pr�c�de une case dans l'ordre de la cha�ne, selon x,
+ * puis selon y.
+ *
+ * @param px La coordonn�e en x du point.
+ * @param py La coordonn�e en y du point.
+ * @param x La coordonn�e en x de la case.
+ * @param y La coordonn�e en y de la case.
+ *
+ * @return <code>true</code> si le point pr�c�de strictement la case.
+ */
+static bool isBefore( const int px, const int py, const int x, const int y );
+
+// ------------------------------------------------------------------------ //
+Anchors::Anchors()
+{}
+
+// ------------------------------------------------------------------------ //
+void Anchors::add( const int x, const int y )
+{
+    size_t pos = m_x.size();
+    size_t low = 0;
+
+    // Les points sont tri�s selon x, puis selon y ; un point qui suit le
+    // dernier, comme les d�buts de documents, est simplement ajout� au bout
+    if( pos > 0 && !isBefore( m_x[ pos - 1 ], m_y[ pos - 1 ], x, y ) )
+    {
+        pos--;
+
+        // Recherche binaire du premier point qui n'est pas avant le nouveau
+        while( low < pos )
+        {
+            size_t middle = ( low + pos ) / 2;
+
+            if( isBefore( m_x[ middle ], m_y[ middle ], x, y ) )
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                pos = middle;
+            }
+        }
+    }
+
+    if( pos < m_x.size() && m_x[ pos ] == x && m_y[ pos ] == y )
+    {
+        return;
+    }
+
+    // Le point doit rester entre ses voisins dans les deux textes
+    if( ( pos > 0 && m_y[ pos - 1 ] > y ) ||
+        ( pos < m_y.size() && m_y[ pos ] < y ) )
+    {
+        throw Exception( "Crossing anchors at sentences " +
+                         toString( x + 1 ) + " and " + toString( y + 1 ) );
+    }
+
+    m_x.insert( m_x.begin() + pos, x );
+    m_y.insert( m_y.begin() + pos, y );
+}
+
+// ------------------------------------------------------------------------ //
+size_t Anchors::size() const
+{
+    return m_x.size();
+}
+
+// ------------------------------------------------------------------------ //
+bool Anchors::isEmpty() const
+{
+    return m_x.empty();
+}
+
+// ------------------------------------------------------------------------ //
+int Anchors::getX( const size_t indice ) const
+{
+    return m_x[ indice ];
+}
+
+// ------------------------------------------------------------------------ //
+int Anchors::getY( const size_t indice ) const
+{
+    return m_y[ indice ];
+}
+
+// ------------------------------------------------------------------------ //
+bool Anchors::isComparable( const int x, const int y ) const
+{
+    size_t before = countBefore( x, y );
+
+    // Les points qui ne sont pas avant la case doivent tous �tre apr�s ; le
+    // premier d'entre eux suffit puisque la cha�ne est croissante.
+    return before == m_x.size() ||
+           ( m_x[ before ] >= x && m_y[ before ] >= y );
+}
+
+// ------------------------------------------------------------------------ //
+bool Anchors::allows( const int pi, const int pj,
+                      const int i, const int j ) const
+{
+    size_t before;
+    size_t after;
+
+    if( m_x.empty() )
+    {
+        return true;
+    }
+
+    if( !isComparable( pi, pj ) || !isComparable( i, j ) )
+    {
+        return false;
+    }
+
+    before = countBefore( pi, pj );
+    after = countBefore( i, j );
+
+    // La case courante peut elle-m�me �tre un point d'ancrage
+    if( after > 0 && m_x[ after - 1 ] == i && m_y[ after - 1 ] == j )
+    {
+        after--;
+    }
+
+    // Un point strictement entre les deux cases serait saut�
+    if( after > before )
+    {
+        return false;
+    }
+
+    // Comme � l'origine, un segment commence par des phrases des deux textes,
+    // � moins qu'il n'en compte aucune dans l'un d'eux
+    if( before > 0 && m_x[ before - 1 ] == pi && m_y[ before - 1 ] == pj &&
+        ( i == pi || j == pj ) )
+    {
+        return before < m_x.size() && 
+               ( i == pi ? m_x[ before ] == pi : m_y[ before ] == pj );
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------ //
+size_t Anchors::countBefore( const int x, const int y ) const
+{
+    // Les deux coordonn�es sont croissantes le long de la cha�ne : les points
+    // inf�rieurs � la case forment le plus court des deux pr�fixes.
+    size_t countX = std::upper_bound( m_x.begin(), m_x.end(), x ) -
+                    m_x.begin();
+    size_t countY = std::upper_bound( m_y.begin(), m_y.end(), y ) -
+                    m_y.begin();
+
+    return std::min( countX, countY );
+}
+
+// ------------------------------------------------------------------------ //
+static bool isBefore( const int px, const int py, const int x, const int y )
+{
+    return px < x || ( px == x && py < y );
+}
+
+}// namespace japa
@@ -0,0 +1,260 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_ANCHORS_H
+#define JAPA_ANCHORS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace japa
+{
+
+/**
+ * \french
+ * Une cha�ne de points d'ancrage par lesquels la solution doit passer.
+ *
+ * Un point d'ancrage <code>( x, y )</code> est une case de la table
+ * dynamique o� les phrases sources jusqu'� <code>x</code> et les phrases
+ * cibles jusqu'� <code>y</code> sont align�es entre elles, et les suivantes
+ * entre elles.  Les points forment donc une cha�ne croissante en x et en y,
+ * qui d�coupe l'alignement en segments ind�pendants.
+ * \endfrench
+ *
+ * \english
+ * A chain of anchor points the solution must go through.
+ *
+ * An anchor point <code>( x, y )</code> is a cell of the dynamic table: the
+ * source sentences up to <code>x</code> and the target sentences up to
+ * <code>y</code> are aligned together, and the following ones together.  The
+ * points thus form a chain increasing in x and in y, which splits the
+ * alignment into independent segments.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class Anchors
+{
+public :
+    /**
+     * \french
+     * Constructeur.  La cha�ne est vide.
+     * \endfrench
+     *
+     * \english
+     * Constructor.  The chain is empty.
+     * \endenglish
+     */
+    Anchors();
+
+    /**
+     * \french
+     * Ajoute un point d'ancrage.  Un point d�j� pr�sent est ignor�.
+     *
+     * @param x La coordonn�e en x du point.
+     * @param y La coordonn�e en y du point.
+     *
+     * @throw Exception Si le point croise un point de la cha�ne.
+     * \endfrench
+     *
+     * \english
+     * Adds an anchor point.  A point already in the chain is ignored.
+     *
+     * @param x The point's x coordinate.
+     * @param y The point's y coordinate.
+     *
+     * @throw Exception If the point crosses a point of the chain.
+     * \endenglish
+     */
+    void add( const int x, const int y );
+
+    /**
+     * \french
+     * Retourne le nombre de points d'ancrage.
+     *
+     * @return Le nombre de points.
+     * \endfrench
+     *
+     * \english
+     * Returns the number of anchor points.
+     *
+     * @return The number of points.
+     * \endenglish
+     */
+    size_t size() const;
+
+    /**
+     * \french
+     * V�rifie si la cha�ne est vide.
+     *
+     * @return <code>true</code> si la cha�ne ne contient aucun point.
+     * \endfrench
+     *
+     * \english
+     * Checks if the chain is empty.
+     *
+     * @return <code>true</code> if the chain holds no point.
+     * \endenglish
+     */
+    bool isEmpty() const;
+
+    /**
+     * \french
+     * Retourne la coordonn�e en x d'un point, dans l'ordre de la cha�ne.
+     *
+     * @param indice L'indice du point.
+     *
+     * @return La coordonn�e en x.
+     * \endfrench
+     *
+     * \english
+     * Returns a point's x coordinate, in the chain's order.
+     *
+     * @param indice The point's indice.
+     *
+     * @return The x coordinate.
+     * \endenglish
+     */
+    int getX( const size_t indice ) const;
+
+    /**
+     * \french
+     * Retourne la coordonn�e en y d'un point, dans l'ordre de la cha�ne.
+     *
+     * @param indice L'indice du point.
+     *
+     * @return La coordonn�e en y.
+     * \endfrench
+     *
+     * \english
+     * Returns a point's y coordinate, in the chain's order.
+     *
+     * @param indice The point's indice.
+     *
+     * @return The y coordinate.
+     * \endenglish
+     */
+    int getY( const size_t indice ) const;
+
+    /**
+     * \french
+     * V�rifie qu'une case se trouve avant ou apr�s chaque point d'ancrage.
+     * Les autres cases ne peuvent faire partie de la solution.
+     *
+     * @param x La coordonn�e en x de la case.
+     * @param y La coordonn�e en y de la case.
+     *
+     * @return <code>true</code> si la case peut faire partie de la solution.
+     * \endfrench
+     *
+     * \english
+     * Checks that a cell lies before or after each anchor point.  The other
+     * cells cannot be part of the solution.
+     *
+     * @param x The cell's x coordinate.
+     * @param y The cell's y coordinate.
+     *
+     * @return <code>true</code> if the cell can be part of the solution.
+     * \endenglish
+     */
+    bool isComparable( const int x, const int y ) const;
+
+    /**
+     * \french
+     * V�rifie qu'un passage d'une case � une autre ne saute aucun point
+     * d'ancrage.
+     *
+     * @param pi La colonne de la case pr�c�dente.
+     * @param pj La rang�e de la case pr�c�dente.
+     * @param i La colonne de la case courante.
+     * @param j La rang�e de la case courante.
+     *
+     * @return <code>true</code> si le passage est permis.
+     *
+     * @note Comme � l'origine de la table, un passage qui quitte un point
+     *       d'ancrage prend des phrases dans les deux textes, sauf si le
+     *       segment suivant n'en compte aucune dans l'un d'eux.  Chaque
+     *       segment est ainsi align� comme s'il �tait seul.
+     * \endfrench
+     *
+     * \english
+     * Checks that a step from a cell to another does not jump over an anchor
+     * point.
+     *
+     * @param pi The previous cell's column.
+     * @param pj The previous cell's row.
+     * @param i The current cell's column.
+     * @param j The current cell's row.
+     *
+     * @return <code>true</code> if the step is allowed.
+     *
+     * @note As from the table's origin, a step leaving an anchor point takes
+     *       sentences from both texts, unless the next segment has none in
+     *       one of them.  Each segment is thus aligned as if it were alone.
+     * \endenglish
+     */
+    bool allows( const int pi, const int pj, const int i, const int j ) const;
+
+private :
+    /**
+     * \french
+     * Compte les points d'ancrage situ�s avant une case, ou sur elle.
+     *
+     * @param x La coordonn�e en x de la case.
+     * @param y La coordonn�e en y de la case.
+     *
+     * @return Le nombre de points inf�rieurs ou �gaux � la case.
+     * \endfrench
+     *
+     * \english
+     * Counts the anchor points lying before a cell, or on it.
+     *
+     * @param x The cell's x coordinate.
+     * @param y The cell's y coordinate.
+     *
+     * @return The number of points lower than or equal to the cell.
+     * \endenglish
+     */
+    size_t countBefore( const int x, const int y ) const;
+
+    /**
+     * \french
+     * Les coordonn�es en x des points, en ordre croissant.
+     * \endfrench
+     *
+     * \english
+     * The points' x coordinates, in increasing order.
+     * \endenglish
+     */
+    std::vector< int > m_x;
+
+    /**
+     * \french
+     * Les coordonn�es en y des points, en ordre croissant.
+     * \endfrench
+     *
+     * \english
+     * The points' y coordinates, in increasing order.
+     * \endenglish
+     */
+    std::vector< int > m_y;
+};
+
+}// namespace japa
+
+#endif
@@ -0,0 +1,72 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include "anchorssf.h"
+#include "linearssf.h"
+#include "setsearchspace.h"
+
+namespace japa
+{
+
+// ------------------------------------------------------------------------ //
+AnchorSSF::AnchorSSF( SearchSpaceFiller& filler, SolutionMarker& marker,
+                      const Anchors& anchors )
+        : m_filler( filler ), m_marker( marker ), m_anchors( anchors )
+{}
+
+// ------------------------------------------------------------------------ //
+SearchSpace& AnchorSSF::operator()( SearchSpace& searchspace )
+{
+    SetSearchSpace wide( searchspace.getLowerBoundX(),
+                         searchspace.getLowerBoundY(),
+                         searchspace.getUpperBoundX(),
+                         searchspace.getUpperBoundY() );
+    LinearSSF beam( m_marker );
+
+    m_filler( wide );
+
+    // Chaque point d'ancrage devient un point de passage
+    beam.addPassagePoint( searchspace.getLowerBoundX(),
+                          searchspace.getLowerBoundY() );
+    beam.addPassagePoint( searchspace.getUpperBoundX(),
+                          searchspace.getUpperBoundY() );
+
+    for( size_t k = 0; k < m_anchors.size(); k++ )
+    {
+        beam.addPassagePoint( m_anchors.getX( k ), m_anchors.getY( k ) );
+    }
+
+    beam( wide );
+
+    // Les cases qui chevauchent un point d'ancrage ne peuvent �tre atteintes
+    SearchSpace::Iterator iter = wide.getIterator();
+
+    while( iter.hasNext() )
+    {
+        iter.next();
+
+        if( m_anchors.isComparable( iter.x(), iter.y() ) )
+        {
+            searchspace.addPossibility( iter.x(), iter.y() );
+        }
+    }
+
+    return searchspace;
+}
+
+}// namespace japa
@@ -0,0 +1,116 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_ANCHOR_SSF_H
+#define JAPA_ANCHOR_SSF_H
+
+#include "anchors.h"
+#include "searchspacefiller.h"
+#include "solutionmarker.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Remplit un espace de recherche contraint par des points d'ancrage.
+ *
+ * Un autre emplisseur remplit d'abord l'espace, auquel s'ajoute un faisceau
+ * passant par chaque point d'ancrage, ce qui garantit qu'un chemin relie les
+ * points entre eux.  Seules les cases situ�es avant ou apr�s chaque point
+ * sont ensuite conserv�es.
+ * \endfrench
+ *
+ * \english
+ * Fills a search space constrained by anchor points.
+ *
+ * Another filler first fills the space, to which a beam going through each
+ * anchor point is added, which ensures that a path links the points
+ * together.  Only the cells lying before or after each point are then kept.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class AnchorSSF : public SearchSpaceFiller
+{
+public :
+    /**
+     * \french
+     * Constructeur.
+     *
+     * @note Seules des r�f�rences sont conserv�es, les objets ne doivent donc
+     *       pas �tre d�truits avant celui-ci.
+     *
+     * @param filler L'emplisseur de l'espace de recherche.
+     * @param marker Le marqueur qui trace le faisceau entre les points.
+     * @param anchors Les points d'ancrage.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     *
+     * @note Only references are kept, so these objects should not be
+     *       destructed before this one.
+     *
+     * @param filler The search space filler.
+     * @param marker The marker drawing the beam between the points.
+     * @param anchors The anchor points.
+     * \endenglish
+     */
+    AnchorSSF( SearchSpaceFiller& filler, SolutionMarker& marker,
+               const Anchors& anchors );
+
+    SearchSpace& operator()( SearchSpace& s );
+
+private :
+    /**
+     * \french
+     * L'emplisseur de l'espace de recherche.
+     * \endfrench
+     *
+     * \english
+     * The search space filler.
+     * \endenglish
+     */
+    SearchSpaceFiller& m_filler;
+
+    /**
+     * \french
+     * Le marqueur du faisceau entre les points d'ancrage.
+     * \endfrench
+     *
+     * \english
+     * The marker of the beam between the anchor points.
+     * \endenglish
+     */
+    SolutionMarker& m_marker;
+
+    /**
+     * \french
+     * Les points d'ancrage.
+     * \endfrench
+     *
+     * \english
+     * The anchor points.
+     * \endenglish
+     */
+    const Anchors& m_anchors;
+};
+
+}// namespace japa
+#endif
@@ -119,6 +119,7 @@ bool ArcadeParser::operator()( std::wistream& in, Text& text )
                 break;
             case BEGIN_SENTENCE :
             	text.pushSentence( tok.value );
+                advance();
                 break;
             case BEGIN_PARAGRAPH :
                 text.pushParagraph();
@@ -106,7 +106,26 @@ public :
      */
     ArcadePrinter( const Text& source, const Text& target );
     
-    void operator()( std::wostream& out, const Solution& solution );
+    /**
+     * \french
+     * Ajuste les indices des premi�res phrases de la solution dans les
+     * textes.  La solution peut ainsi ne couvrir qu'une partie des textes.
+     *
+     * @param source L'indice de la premi�re phrase source.
+     * @param target L'indice de la premi�re phrase cible.
+     * \endfrench
+     *
+     * \english
+     * Sets the subscripts of the solution's first sentences in the texts.
+     * The solution can thus cover only a part of the texts.
+     *
+     * @param source The first source sentence's subscript.
+     * @param target The first target sentence's subscript.
+     * \endenglish
+     */
+    void setOrigin( const size_t source, const size_t target );
+
+    void operator()( Utf8Writer& out, const Solution& solution );
 
 private :
     /** 
@@ -130,20 +149,51 @@ private :
      * \endenglish
      */
     const Text& m_target;
+
+    /** 
+     * \french
+     * L'indice de la premi�re phrase source de la solution. 
+     * \endfrench
+     *
+     * \english
+     * The solution's first source sentence subscript. 
+     * \endenglish
+     */
+    size_t m_sourceOrigin;
+
+    /** 
+     * \french
+     * L'indice de la premi�re phrase cible de la solution. 
+     * \endfrench
+     *
+     * \english
+     * The solution's first target sentence subscript. 
+     * \endenglish
+     */
+    size_t m_targetOrigin;
 };
 
 // ------------------------------------------------------------------------ //
 template< class T >
 ArcadePrinter< T >::ArcadePrinter( const Text& source, const Text& target ) 
-        : m_source( source ), m_target( target )
+        : m_source( source ), m_target( target ), m_sourceOrigin( 0 ), 
+          m_targetOrigin( 0 )
 {}
 
 // ------------------------------------------------------------------------ //
-template< class T > void ArcadePrinter< T >::operator()( std::wostream& out,
+template< class T >
+void ArcadePrinter< T >::setOrigin( const size_t source, const size_t target )
+{
+    m_sourceOrigin = source;
+    m_targetOrigin = target;
+}
+
+// ------------------------------------------------------------------------ //
+template< class T > void ArcadePrinter< T >::operator()( Utf8Writer& out,
         const Solution& solution )
 {
-    size_t isrc = 0;    // Indice de la phrase dans le texte source
-    size_t itgt = 0;    // Indice de la phrase dans le texte cible
+    size_t isrc = m_sourceOrigin;   // Indice de la phrase dans le texte source
+    size_t itgt = m_targetOrigin;   // Indice de la phrase dans le texte cible
     double previousScore = 0; // Score de l'alignement pr�c�dent
     typename Solution::const_iterator iter;
 
@@ -177,7 +227,7 @@ template< class T > void ArcadePrinter< T >::operator()( std::wostream& out,
         }
 
         out << "\" certainty=\"" << iter -> getScore() - previousScore << "\">"
-            << "</link>" << std::endl;
+            << "</link>" << '\n';
 
         previousScore = iter -> getScore();
     }
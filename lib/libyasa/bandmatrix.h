@@ -0,0 +1,461 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_BAND_MATRIX_H
+#define JAPA_BAND_MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "searchspace.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Une matrice creuse rang�e par bandes.
+ *
+ * Pour chaque colonne d'un espace de recherche, les rang�es comprises entre
+ * la plus petite et la plus grande case de la colonne sont stock�es de fa�on
+ * contigu�.  La matrice offre les m�mes acc�s que <code>SparseMatrix</code>,
+ * sans table de hachage, mais seules les cases de la bande peuvent �tre
+ * assign�es.
+ *
+ * @param T Le type des �l�ments.
+ * \endfrench
+ *
+ * \english
+ * A sparse matrix stored by bands.
+ *
+ * For each column of a search space, the rows between the lowest and the
+ * highest cell of the column are stored contiguously.  The matrix offers the
+ * same accesses as <code>SparseMatrix</code>, without hash tables, but only
+ * the cells of the band can be set.
+ *
+ * @param T The elements' type.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+template< class T >
+class BandMatrix
+{
+public :
+    /**
+     * \french
+     * Constructeur.  La matrice est vide.
+     * \endfrench
+     *
+     * \english
+     * Constructor.  The matrix is empty.
+     * \endenglish
+     */
+    BandMatrix();
+
+    /**
+     * \french
+     * Dimensionne la matrice selon les cases d'un espace de recherche.
+     * Aucune case n'est assign�e.
+     *
+     * @param space L'espace de recherche.
+     * \endfrench
+     *
+     * \english
+     * Sizes the matrix after the cells of a search space.  No cell is set.
+     *
+     * @param space The search space.
+     * \endenglish
+     */
+    void init( const SearchSpace& space );
+
+    /**
+     * \french
+     * Range un �l�ment dans une case.
+     *
+     * @param i La colonne de la case.
+     * @param j La rang�e de la case.
+     * @param info L'�l�ment.
+     *
+     * @return <code>true</code> si la case n'�tait pas encore assign�e.  Une
+     *         case hors de la bande n'est pas assign�e.
+     * \endfrench
+     *
+     * \english
+     * Stores an element in a cell.
+     *
+     * @param i The cell's column.
+     * @param j The cell's row.
+     * @param info The element.
+     *
+     * @return <code>true</code> if the cell was not set yet.  A cell outside
+     *         the band is not set.
+     * \endenglish
+     */
+    bool set( const int i, const int j, const T& info );
+
+    /**
+     * \french
+     * Lit l'�l�ment d'une case.
+     *
+     * @param i La colonne de la case.
+     * @param j La rang�e de la case.
+     * @param info ( out ) L'�l�ment.
+     *
+     * @return <code>false</code> si la case n'est pas assign�e, auquel cas
+     *         <code>info</code> est ind�termin�.
+     * \endfrench
+     *
+     * \english
+     * Reads a cell's element.
+     *
+     * @param i The cell's column.
+     * @param j The cell's row.
+     * @param info ( out ) The element.
+     *
+     * @return <code>false</code> if the cell is not set, in which case
+     *         <code>info</code> is undetermined.
+     * \endenglish
+     */
+    bool get( const int i, const int j, T& info ) const;
+
+    /**
+     * \french
+     * Vide la matrice.
+     * \endfrench
+     *
+     * \english
+     * Empties the matrix.
+     * \endenglish
+     */
+    void clear();
+
+    /**
+     * \french
+     * Estime la m�moire qu'occuperait la matrice pour un espace de
+     * recherche, sans la dimensionner.
+     *
+     * @param space L'espace de recherche.
+     *
+     * @return Le nombre d'octets.
+     * \endfrench
+     *
+     * \english
+     * Estimates the memory the matrix would take for a search space, without
+     * sizing it.
+     *
+     * @param space The search space.
+     *
+     * @return The number of bytes.
+     * \endenglish
+     */
+    static size_t estimateMemory( const SearchSpace& space );
+
+private :
+    /**
+     * \french
+     * Les bornes d'une colonne.
+     * \endfrench
+     *
+     * \english
+     * A column's bounds.
+     * \endenglish
+     */
+    struct Column
+    {
+        int low;        /**< \french La premi�re rang�e. \endfrench
+                             \english The first row. \endenglish */
+        int high;       /**< \french La derni�re rang�e. \endfrench
+                             \english The last row. \endenglish */
+        size_t offset;  /**< \french La position de la premi�re rang�e.
+                             \endfrench
+                             \english The first row's position.
+                             \endenglish */
+    };
+
+    /**
+     * \french
+     * Rep�re les bornes des colonnes d'un espace de recherche et les place
+     * les unes � la suite des autres.
+     *
+     * @param space L'espace de recherche.
+     * @param columns ( out ) Les colonnes.
+     * @param firstColumn ( out ) L'indice de la premi�re colonne.
+     *
+     * @return Le nombre de cases de la bande.
+     * \endfrench
+     *
+     * \english
+     * Finds the bounds of a search space's columns and places them one after
+     * the other.
+     *
+     * @param space The search space.
+     * @param columns ( out ) The columns.
+     * @param firstColumn ( out ) The first column's index.
+     *
+     * @return The number of cells of the band.
+     * \endenglish
+     */
+    static size_t layout( const SearchSpace& space,
+                          std::vector< Column >& columns, int& firstColumn );
+
+    /**
+     * \french
+     * Trouve la position d'une case.
+     *
+     * @param i La colonne de la case.
+     * @param j La rang�e de la case.
+     * @param position ( out ) La position de la case.
+     *
+     * @return <code>false</code> si la case est hors de la bande.
+     * \endfrench
+     *
+     * \english
+     * Finds a cell's position.
+     *
+     * @param i The cell's column.
+     * @param j The cell's row.
+     * @param position ( out ) The cell's position.
+     *
+     * @return <code>false</code> if the cell is outside the band.
+     * \endenglish
+     */
+    bool locate( const int i, const int j, size_t& position ) const;
+
+    /**
+     * \french
+     * L'indice de la premi�re colonne.
+     * \endfrench
+     *
+     * \english
+     * The first column's index.
+     * \endenglish
+     */
+    int m_firstColumn;
+
+    /**
+     * \french
+     * Les bornes des colonnes.
+     * \endfrench
+     *
+     * \english
+     * The columns' bounds.
+     * \endenglish
+     */
+    std::vector< Column > m_columns;
+
+    /**
+     * \french
+     * Les �l�ments, colonne par colonne.
+     * \endfrench
+     *
+     * \english
+     * The elements, column by column.
+     * \endenglish
+     */
+    std::vector< T > m_values;
+
+    /**
+     * \french
+     * Indique pour chaque case si elle est assign�e.
+     * \endfrench
+     *
+     * \english
+     * Tells for each cell if it is set.
+     * \endenglish
+     */
+    std::vector< bool > m_set;
+};
+
+// ------------------------------------------------------------------------ //
+template< class T >
+BandMatrix< T >::BandMatrix() : m_firstColumn( 0 )
+{}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+void BandMatrix< T >::init( const SearchSpace& space )
+{
+    size_t size;
+
+    clear();
+    size = layout( space, m_columns, m_firstColumn );
+
+    m_values.resize( size );
+    m_set.assign( size, false );
+}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+bool BandMatrix< T >::set( const int i, const int j, const T& info )
+{
+    size_t position;
+    bool ret;
+
+    if( !locate( i, j, position ) )
+    {
+        return false;
+    }
+
+    ret = !m_set[ position ];
+    m_values[ position ] = info;
+    m_set[ position ] = true;
+
+    return ret;
+}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+bool BandMatrix< T >::get( const int i, const int j, T& info ) const
+{
+    size_t position;
+
+    if( !locate( i, j, position ) || !m_set[ position ] )
+    {
+        return false;
+    }
+
+    info = m_values[ position ];
+
+    return true;
+}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+void BandMatrix< T >::clear()
+{
+    m_firstColumn = 0;
+    m_columns.clear();
+    m_values.clear();
+    m_set.clear();
+}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+size_t BandMatrix< T >::estimateMemory( const SearchSpace& space )
+{
+    std::vector< Column > columns;
+    int firstColumn;
+    size_t size = layout( space, columns, firstColumn );
+
+    // Un bit par case indique si elle est assign�e
+    return size * sizeof( T ) + ( size + 7 ) / 8 +
+           columns.size() * sizeof( Column );
+}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+size_t BandMatrix< T >::layout( const SearchSpace& space,
+                                std::vector< Column >& columns,
+                                int& firstColumn )
+{
+    Column empty;
+    size_t offset = 0;
+    bool first = true;
+    int lastColumn = 0;
+
+    columns.clear();
+    firstColumn = 0;
+
+    // Une colonne vide a une derni�re rang�e inf�rieure � sa premi�re
+    empty.low = 0;
+    empty.high = -1;
+    empty.offset = 0;
+
+    SearchSpace::Iterator iter = space.getIterator();
+
+    while( iter.hasNext() )
+    {
+        iter.next();
+
+        if( first )
+        {
+            firstColumn = lastColumn = iter.x();
+            first = false;
+        }
+
+        // Les colonnes peuvent �tre parcourues dans n'importe quel ordre
+        if( iter.x() < firstColumn )
+        {
+            columns.insert( columns.begin(), firstColumn - iter.x(), empty );
+            firstColumn = iter.x();
+        }
+        else if( iter.x() > lastColumn )
+        {
+            lastColumn = iter.x();
+        }
+
+        if( columns.size() < ( size_t )( lastColumn - firstColumn + 1 ) )
+        {
+            columns.resize( lastColumn - firstColumn + 1, empty );
+        }
+
+        Column& column = columns[ iter.x() - firstColumn ];
+
+        if( column.high < column.low )
+        {
+            column.low = column.high = iter.y();
+        }
+        else if( iter.y() < column.low )
+        {
+            column.low = iter.y();
+        }
+        else if( iter.y() > column.high )
+        {
+            column.high = iter.y();
+        }
+    }
+
+    for( size_t c = 0; c < columns.size(); c++ )
+    {
+        columns[ c ].offset = offset;
+
+        if( columns[ c ].high >= columns[ c ].low )
+        {
+            offset += columns[ c ].high - columns[ c ].low + 1;
+        }
+    }
+
+    return offset;
+}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+bool BandMatrix< T >::locate( const int i, const int j,
+                              size_t& position ) const
+{
+    if( i < m_firstColumn || i - m_firstColumn >= ( int )m_columns.size() )
+    {
+        return false;
+    }
+
+    const Column& column = m_columns[ i - m_firstColumn ];
+
+    if( j < column.low || j > column.high )
+    {
+        return false;
+    }
+
+    position = column.offset + ( j - column.low );
+
+    return true;
+}
+
+}// namespace japa
+
+#endif
@@ -0,0 +1,304 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+using namespace std;
+
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "binarylexicon.h"
+#include "japaexception.h"
+
+namespace japa
+{
+
+// ------------------------------------------------------------------------ //
+const char BinaryLexicon::MAGIC[ 8 ] = { 'Y', 'A', 'S', 'A', 'L', 'E', 'X', '1' };
+
+// ------------------------------------------------------------------------ //
+BinaryLexicon::BinaryLexicon() : m_data( NULL ), m_size( 0 ), 
+                                 m_header( NULL ), m_sources( NULL ),
+                                 m_firstTargets( NULL ), m_targets( NULL ),
+                                 m_pool( NULL )
+{}
+
+// ------------------------------------------------------------------------ //
+BinaryLexicon::~BinaryLexicon()
+{
+    close();
+}
+
+// ------------------------------------------------------------------------ //
+void BinaryLexicon::open( const std::string& filename )
+{
+    int fd;
+    struct stat st;
+    const char* base;
+    uint64_t expected;
+
+    close();
+
+    fd = ::open( filename.c_str(), O_RDONLY );
+
+    if( fd < 0 || fstat( fd, &st ) != 0 )
+    {
+        if( fd >= 0 )
+        {
+            ::close( fd );
+        }
+
+        throw Exception( "Can't open compiled lexicon : " + filename );
+    }
+
+    if( ( size_t )st.st_size < sizeof( Header ) )
+    {
+        ::close( fd );
+        throw Exception( "Truncated compiled lexicon : " + filename );
+    }
+
+    m_size = st.st_size;
+    m_data = mmap( NULL, m_size, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if( m_data == MAP_FAILED )
+    {
+        m_data = NULL;
+        m_size = 0;
+        throw Exception( "Can't map compiled lexicon : " + filename );
+    }
+
+    // Localise les sections du fichier
+    base = ( const char* )m_data;
+    m_header = ( const Header* )base;
+
+    if( memcmp( m_header -> magic, MAGIC, sizeof( MAGIC ) ) != 0 )
+    {
+        close();
+        throw Exception( "Not a compiled lexicon : " + filename );
+    }
+
+    if( m_header -> byteOrder != ENDIAN_MARK )
+    {
+        close();
+        throw Exception( "Compiled lexicon has a foreign byte order : " + 
+                         filename );
+    }
+
+    // Borne chaque compte par la taille du fichier avant de les multiplier,
+    // pour qu'un en-t�te forg� ne d�borde pas le calcul de la taille.
+    if( m_header -> sourceCount >= m_size / sizeof( Word ) ||
+        m_header -> targetCount > m_size / sizeof( Word ) ||
+        m_header -> poolSize > m_size / sizeof( uint32_t ) )
+    {
+        close();
+        throw Exception( "Corrupted compiled lexicon : " + filename );
+    }
+
+    expected = sizeof( Header ) + 
+               m_header -> sourceCount * sizeof( Word ) +
+               ( m_header -> sourceCount + 1 ) * sizeof( uint64_t ) +
+               m_header -> targetCount * sizeof( Word ) +
+               m_header -> poolSize * sizeof( uint32_t );
+
+    if( expected != m_size )
+    {
+        close();
+        throw Exception( "Corrupted compiled lexicon : " + filename );
+    }
+
+    base += sizeof( Header );
+    m_sources = ( const Word* )base;
+    base += m_header -> sourceCount * sizeof( Word );
+    m_firstTargets = ( const uint64_t* )base;
+    base += ( m_header -> sourceCount + 1 ) * sizeof( uint64_t );
+    m_targets = ( const Word* )base;
+    base += m_header -> targetCount * sizeof( Word );
+    m_pool = ( const uint32_t* )base;
+
+    if( !isConsistent() )
+    {
+        close();
+        throw Exception( "Corrupted compiled lexicon : " + filename );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void BinaryLexicon::close()
+{
+    if( m_data != NULL )
+    {
+        munmap( m_data, m_size );
+    }
+
+    m_data = NULL;
+    m_size = 0;
+    m_header = NULL;
+    m_sources = NULL;
+    m_firstTargets = NULL;
+    m_targets = NULL;
+    m_pool = NULL;
+}
+
+// ------------------------------------------------------------------------ //
+bool BinaryLexicon::isBinaryLexicon( const std::string& filename )
+{
+    char magic[ sizeof( MAGIC ) ];
+    std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+
+    in.read( magic, sizeof( magic ) );
+
+    return in.gcount() == ( std::streamsize )sizeof( magic ) &&
+           memcmp( magic, MAGIC, sizeof( MAGIC ) ) == 0;
+}
+
+// ------------------------------------------------------------------------ //
+size_t BinaryLexicon::getSourceCount() const
+{
+    return m_header != NULL ? m_header -> sourceCount : 0;
+}
+
+// ------------------------------------------------------------------------ //
+size_t BinaryLexicon::addSynonyms( TextDictionary& sourceDict, 
+                                   TextDictionary& targetDict ) const
+{
+    TextDictionary::iterator srcIter;
+    TextDictionary::iterator tgtIter;
+    size_t low = 0;
+    size_t high;
+    size_t middle;
+    size_t count = 0;
+
+    // Les deux vocabulaires sont tri�s : chaque recherche reprend l� o� la
+    // pr�c�dente s'est arr�t�e.
+    for( srcIter = sourceDict.begin(); 
+         srcIter != sourceDict.end() && low < getSourceCount(); srcIter++ )
+    {
+        high = getSourceCount();
+
+        while( low < high )
+        {
+            middle = low + ( high - low ) / 2;
+
+            if( compare( m_sources[ middle ], srcIter -> first ) < 0 )
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        if( low < getSourceCount() && 
+            compare( m_sources[ low ], srcIter -> first ) == 0 )
+        {
+            // Ajoute les traductions pr�sentes dans le texte cible
+            for( uint64_t t = m_firstTargets[ low ]; 
+                 t < m_firstTargets[ low + 1 ]; t++ )
+            {
+                tgtIter = targetDict.find( toWstring( m_targets[ t ] ) );
+
+                if( tgtIter != targetDict.end() )
+                {
+                    ( srcIter -> second ).addSynonym( tgtIter -> second );
+                    count++;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// ------------------------------------------------------------------------ //
+int BinaryLexicon::compare( const Word& word, const wstring& s ) const
+{
+    const uint32_t* w = m_pool + word.offset;
+    size_t length = word.length < s.size() ? word.length : s.size();
+
+    for( size_t i = 0; i < length; i++ )
+    {
+        if( w[ i ] != ( uint32_t )s[ i ] )
+        {
+            return w[ i ] < ( uint32_t )s[ i ] ? -1 : 1;
+        }
+    }
+
+    if( word.length == s.size() )
+    {
+        return 0;
+    }
+
+    return word.length < s.size() ? -1 : 1;
+}
+
+// ------------------------------------------------------------------------ //
+wstring BinaryLexicon::toWstring( const Word& word ) const
+{
+    wstring s( word.length, L' ' );
+
+    for( size_t i = 0; i < word.length; i++ )
+    {
+        s[ i ] = ( wchar_t )m_pool[ word.offset + i ];
+    }
+
+    return s;
+}
+
+// ------------------------------------------------------------------------ //
+bool BinaryLexicon::isConsistent() const
+{
+    if( m_firstTargets[ 0 ] != 0 ||
+        m_firstTargets[ m_header -> sourceCount ] > m_header -> targetCount )
+    {
+        return false;
+    }
+
+    for( uint64_t i = 0; i < m_header -> sourceCount; i++ )
+    {
+        if( m_firstTargets[ i ] > m_firstTargets[ i + 1 ] ||
+            !isInPool( m_sources[ i ] ) )
+        {
+            return false;
+        }
+    }
+
+    for( uint64_t i = 0; i < m_header -> targetCount; i++ )
+    {
+        if( !isInPool( m_targets[ i ] ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------ //
+bool BinaryLexicon::isInPool( const Word& word ) const
+{
+    // Compare sans additionner, pour qu'un d�calage forg� ne d�borde pas
+    return word.length <= m_header -> poolSize && 
+           word.offset <= m_header -> poolSize - word.length;
+}
+
+}// namespace japa
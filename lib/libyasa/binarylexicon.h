@@ -0,0 +1,428 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#ifndef JAPA_BINARY_LEXICON_H
+#define JAPA_BINARY_LEXICON_H
+
+#include <stdint.h>
+#include <string>
+
+#include "text.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Un lexique bilingue compil� et projet� en m�moire (<code>mmap</code>).
+ *
+ * Les mots du fichier sont d�j� normalis�s par <code>Text::prepareWord</code>
+ * et tri�s, ce qui permet de ne parcourir que le vocabulaire des textes et de
+ * chercher chaque mot dans le lexique par dichotomie.  Les fichiers sont
+ * produits par l'outil <code>yasa-lexicon</code>.
+ *
+ * Le fichier contient, dans l'ordre :
+ * <TABLE>
+ * <TR><TD>Header</TD><TD>Signature, ordre des octets et tailles</TD></TR>
+ * <TR><TD>Word[ sourceCount ]</TD><TD>Les mots source tri�s</TD></TR>
+ * <TR><TD>uint64_t[ sourceCount + 1 ]</TD><TD>Premier mot cible de chaque
+ *         mot source</TD></TR>
+ * <TR><TD>Word[ targetCount ]</TD><TD>Les mots cibles</TD></TR>
+ * <TR><TD>uint32_t[ poolSize ]</TD><TD>Les points de code des mots</TD></TR>
+ * </TABLE>
+ * \endfrench
+ *
+ * \english
+ * A compiled bilingual lexicon mapped in memory (<code>mmap</code>).
+ *
+ * The file's words are already normalized by <code>Text::prepareWord</code>
+ * and sorted, so only the texts' vocabulary is walked and each word is
+ * looked up in the lexicon by binary search.  The files are produced by the
+ * <code>yasa-lexicon</code> tool.
+ *
+ * The file contains, in order :
+ * <TABLE>
+ * <TR><TD>Header</TD><TD>Signature, byte order and sizes</TD></TR>
+ * <TR><TD>Word[ sourceCount ]</TD><TD>The sorted source words</TD></TR>
+ * <TR><TD>uint64_t[ sourceCount + 1 ]</TD><TD>First target word of each
+ *         source word</TD></TR>
+ * <TR><TD>Word[ targetCount ]</TD><TD>The target words</TD></TR>
+ * <TR><TD>uint32_t[ poolSize ]</TD><TD>The words' code points</TD></TR>
+ * </TABLE>
+ * \endenglish
+ *
+ * @see BinaryLexiconWriter
+ *
+ * @version 1.1
+ */
+class BinaryLexicon
+{
+public :
+    /**
+     * \french
+     * La signature d'un lexique compil�.
+     * \endfrench
+     *
+     * \english
+     * A compiled lexicon's signature.
+     * \endenglish
+     */
+    static const char MAGIC[ 8 ];
+
+    /**
+     * \french
+     * La valeur qui permet de v�rifier l'ordre des octets du fichier.
+     * \endfrench
+     *
+     * \english
+     * The value used to check the file's byte order.
+     * \endenglish
+     */
+    static const uint32_t ENDIAN_MARK = 0x01020304;
+
+    /**
+     * \french
+     * L'en-t�te d'un lexique compil�.
+     * \endfrench
+     *
+     * \english
+     * A compiled lexicon's header.
+     * \endenglish
+     */
+    struct Header
+    {
+        char magic[ 8 ];        /**< Signature */
+        uint32_t byteOrder;     /**< ENDIAN_MARK as written */
+        uint32_t reserved;      /**< Padding, always 0 */
+        uint64_t sourceCount;   /**< Number of source words */
+        uint64_t targetCount;   /**< Number of target words */
+        uint64_t poolSize;      /**< Number of code points in the pool */
+    };
+
+    /**
+     * \french
+     * Un mot du lexique, d�crit par sa position dans le bassin de points de
+     * code.
+     * \endfrench
+     *
+     * \english
+     * A lexicon word, described by its position in the code point pool.
+     * \endenglish
+     */
+    struct Word
+    {
+        uint64_t offset;        /**< First code point */
+        uint64_t length;        /**< Number of code points */
+    };
+
+    /**
+     * \french
+     * Constructeur.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     * \endenglish
+     */
+    BinaryLexicon();
+
+    /**
+     * \french
+     * Destructeur.  Lib�re la projection du fichier.
+     * \endfrench
+     *
+     * \english
+     * Destructor.  Unmaps the file.
+     * \endenglish
+     */
+    virtual ~BinaryLexicon();
+
+    /**
+     * \french
+     * Projette un lexique compil� en m�moire.
+     *
+     * @param filename Le chemin du lexique.
+     *
+     * @throw Exception Si le fichier ne peut �tre lu ou n'est pas un lexique
+     *                  compil� valide.
+     * \endfrench
+     *
+     * \english
+     * Maps a compiled lexicon in memory.
+     *
+     * @param filename The lexicon's path.
+     *
+     * @throw Exception If the file can't be read or is not a valid compiled
+     *                  lexicon.
+     * \endenglish
+     */
+    void open( const std::string& filename );
+
+    /**
+     * \french
+     * Lib�re la projection du fichier.
+     * \endfrench
+     *
+     * \english
+     * Unmaps the file.
+     * \endenglish
+     */
+    void close();
+
+    /**
+     * \french
+     * V�rifie si un fichier est un lexique compil�.
+     *
+     * @param filename Le chemin du fichier.
+     *
+     * @return <code>true</code> si le fichier commence par la signature.
+     * \endfrench
+     *
+     * \english
+     * Checks if a file is a compiled lexicon.
+     *
+     * @param filename The file's path.
+     *
+     * @return <code>true</code> if the file starts with the signature.
+     * \endenglish
+     */
+    static bool isBinaryLexicon( const std::string& filename );
+
+    /**
+     * \french
+     * Retourne le nombre de mots source du lexique.
+     *
+     * @return Le nombre de mots source.
+     * \endfrench
+     *
+     * \english
+     * Gets the number of source words in the lexicon.
+     *
+     * @return The number of source words.
+     * \endenglish
+     */
+    size_t getSourceCount() const;
+
+    /**
+     * \french
+     * Ajoute les entr�es du lexique dont les deux mots sont pr�sents dans les
+     * dictionnaires aux synonymes des mots source.
+     *
+     * @param sourceDict Le dictionnaire du texte source.
+     * @param targetDict Le dictionnaire du texte cible.
+     *
+     * @return Le nombre de paires ajout�es.
+     * \endfrench
+     *
+     * \english
+     * Adds the lexicon entries whose two words are in the dictionaries to
+     * the source words' synonyms.
+     *
+     * @param sourceDict The source text's dictionary.
+     * @param targetDict The target text's dictionary.
+     *
+     * @return The number of added pairs.
+     * \endenglish
+     */
+    size_t addSynonyms( TextDictionary& sourceDict, 
+                        TextDictionary& targetDict ) const;
+
+private :
+    /**
+     * \french
+     * Copie interdite : la projection appartient � un seul objet.
+     * \endfrench
+     *
+     * \english
+     * Copy is forbidden : the mapping belongs to a single object.
+     * \endenglish
+     */
+    BinaryLexicon( const BinaryLexicon& );
+
+    /**
+     * \french
+     * Affectation interdite.
+     * \endfrench
+     *
+     * \english
+     * Assignment is forbidden.
+     * \endenglish
+     */
+    BinaryLexicon& operator=( const BinaryLexicon& );
+
+    /**
+     * \french
+     * Compare un mot du lexique � une cha�ne.
+     *
+     * @param word Le mot du lexique.
+     * @param s La cha�ne.
+     *
+     * @return Un nombre n�gatif, nul ou positif si le mot est plus petit,
+     *         �gal ou plus grand que la cha�ne.
+     * \endfrench
+     *
+     * \english
+     * Compares a lexicon word to a string.
+     *
+     * @param word The lexicon word.
+     * @param s The string.
+     *
+     * @return A negative, null or positive number if the word is smaller,
+     *         equal or greater than the string.
+     * \endenglish
+     */
+    int compare( const Word& word, const wstring& s ) const;
+
+    /**
+     * \french
+     * Convertit un mot du lexique en cha�ne.
+     *
+     * @param word Le mot du lexique.
+     *
+     * @return La cha�ne.
+     * \endfrench
+     *
+     * \english
+     * Converts a lexicon word to a string.
+     *
+     * @param word The lexicon word.
+     *
+     * @return The string.
+     * \endenglish
+     */
+    wstring toWstring( const Word& word ) const;
+
+    /**
+     * \french
+     * V�rifie que les index du fichier restent dans ses sections : les
+     * premiers mots cibles croissent sans d�passer <code>targetCount</code>
+     * et chaque mot tient dans le bassin de points de code.
+     *
+     * @return <code>true</code> si les index sont coh�rents.
+     * \endfrench
+     *
+     * \english
+     * Checks that the file's indices stay within its sections: the first
+     * target words never decrease nor exceed <code>targetCount</code> and
+     * each word fits in the code point pool.
+     *
+     * @return <code>true</code> if the indices are consistent.
+     * \endenglish
+     */
+    bool isConsistent() const;
+
+    /**
+     * \french
+     * V�rifie qu'un mot tient dans le bassin de points de code.
+     *
+     * @param word Le mot du lexique.
+     *
+     * @return <code>true</code> si le mot tient dans le bassin.
+     * \endfrench
+     *
+     * \english
+     * Checks that a word fits in the code point pool.
+     *
+     * @param word The lexicon word.
+     *
+     * @return <code>true</code> if the word fits in the pool.
+     * \endenglish
+     */
+    bool isInPool( const Word& word ) const;
+
+    /** 
+     * \french
+     * Le d�but de la projection du fichier. 
+     * \endfrench
+     *
+     * \english
+     * The beginning of the file mapping. 
+     * \endenglish
+     */
+    void* m_data;
+
+    /** 
+     * \french
+     * La taille de la projection. 
+     * \endfrench
+     *
+     * \english
+     * The mapping's size. 
+     * \endenglish
+     */
+    size_t m_size;
+
+    /** 
+     * \french
+     * L'en-t�te du lexique. 
+     * \endfrench
+     *
+     * \english
+     * The lexicon's header. 
+     * \endenglish
+     */
+    const Header* m_header;
+
+    /** 
+     * \french
+     * Les mots source. 
+     * \endfrench
+     *
+     * \english
+     * The source words. 
+     * \endenglish
+     */
+    const Word* m_sources;
+
+    /** 
+     * \french
+     * L'indice du premier mot cible de chaque mot source. 
+     * \endfrench
+     *
+     * \english
+     * The index of each source word's first target word. 
+     * \endenglish
+     */
+    const uint64_t* m_firstTargets;
+
+    /** 
+     * \french
+     * Les mots cibles. 
+     * \endfrench
+     *
+     * \english
+     * The target words. 
+     * \endenglish
+     */
+    const Word* m_targets;
+
+    /** 
+     * \french
+     * Le bassin des points de code. 
+     * \endfrench
+     *
+     * \english
+     * The code point pool. 
+     * \endenglish
+     */
+    const uint32_t* m_pool;
+};
+
+}// namespace japa
+
+#endif
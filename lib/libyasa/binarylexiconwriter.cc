@@ -0,0 +1,150 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+using namespace std;
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#include "binarylexicon.h"
+#include "binarylexiconwriter.h"
+#include "japaexception.h"
+#include "text.h"
+
+namespace japa
+{
+
+// ------------------------------------------------------------------------ //
+BinaryLexiconWriter::BinaryLexiconWriter()
+{}
+
+// ------------------------------------------------------------------------ //
+BinaryLexiconWriter::~BinaryLexiconWriter()
+{}
+
+// ------------------------------------------------------------------------ //
+void BinaryLexiconWriter::addSynonyms( wstring& word1, wstring& word2 )
+{
+    m_pairs.push_back( make_pair( Text::prepareWord( word1 ), 
+                                  Text::prepareWord( word2 ) ) );
+}
+
+// ------------------------------------------------------------------------ //
+size_t BinaryLexiconWriter::getPairCount() const
+{
+    return m_pairs.size();
+}
+
+// ------------------------------------------------------------------------ //
+void BinaryLexiconWriter::write( const std::string& filename )
+{
+    BinaryLexicon::Header header;
+    BinaryLexicon::Word word;
+    std::vector< BinaryLexicon::Word > sources;
+    std::vector< uint64_t > firstTargets;
+    std::vector< BinaryLexicon::Word > targets;
+    std::vector< uint32_t > pool;
+    std::map< wstring, BinaryLexicon::Word > interned;
+    std::map< wstring, BinaryLexicon::Word >::iterator found;
+    std::ofstream out;
+
+    // Trie les paires et �limine les doublons
+    sort( m_pairs.begin(), m_pairs.end() );
+    m_pairs.erase( unique( m_pairs.begin(), m_pairs.end() ), m_pairs.end() );
+
+    for( size_t i = 0; i < m_pairs.size(); i++ )
+    {
+        const wstring* words[ 2 ] = { &m_pairs[ i ].first, 
+                                      &m_pairs[ i ].second };
+
+        // Place chaque mot distinct une seule fois dans le bassin
+        for( size_t j = 0; j < 2; j++ )
+        {
+            found = interned.find( *words[ j ] );
+
+            if( found == interned.end() )
+            {
+                word.offset = pool.size();
+                word.length = words[ j ] -> size();
+                pool.insert( pool.end(), words[ j ] -> begin(), 
+                             words[ j ] -> end() );
+                found = interned.insert( make_pair( *words[ j ], word ) ).first;
+            }
+
+            if( j == 0 && ( i == 0 || m_pairs[ i - 1 ].first != *words[ 0 ] ) )
+            {
+                // Nouveau mot source
+                sources.push_back( found -> second );
+                firstTargets.push_back( targets.size() );
+            }
+            else if( j == 1 )
+            {
+                targets.push_back( found -> second );
+            }
+        }
+    }
+
+    firstTargets.push_back( targets.size() );
+
+    memcpy( header.magic, BinaryLexicon::MAGIC, sizeof( header.magic ) );
+    header.byteOrder = BinaryLexicon::ENDIAN_MARK;
+    header.reserved = 0;
+    header.sourceCount = sources.size();
+    header.targetCount = targets.size();
+    header.poolSize = pool.size();
+
+    out.open( filename.c_str(), std::ios::out | std::ios::binary );
+
+    if( out.fail() )
+    {
+        throw Exception( "Can't open compiled lexicon : " + filename );
+    }
+
+    out.write( ( const char* )&header, sizeof( header ) );
+
+    if( !sources.empty() )
+    {
+        out.write( ( const char* )&sources[ 0 ], 
+                   sources.size() * sizeof( BinaryLexicon::Word ) );
+    }
+
+    out.write( ( const char* )&firstTargets[ 0 ], 
+               firstTargets.size() * sizeof( uint64_t ) );
+
+    if( !targets.empty() )
+    {
+        out.write( ( const char* )&targets[ 0 ], 
+                   targets.size() * sizeof( BinaryLexicon::Word ) );
+    }
+
+    if( !pool.empty() )
+    {
+        out.write( ( const char* )&pool[ 0 ], pool.size() * sizeof( uint32_t ) );
+    }
+
+    out.close();
+
+    if( out.fail() )
+    {
+        throw Exception( "Can't write compiled lexicon : " + filename );
+    }
+}
+
+}// namespace japa
@@ -0,0 +1,127 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#ifndef JAPA_BINARY_LEXICON_WRITER_H
+#define JAPA_BINARY_LEXICON_WRITER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "synonymcontainer.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Accumule des paires de synonymes et les �crit sous forme de lexique
+ * compil�.
+ *
+ * Les mots sont normalis�s par <code>Text::prepareWord</code> au moment de
+ * l'ajout, les doublons sont �limin�s � l'�criture.
+ * \endfrench
+ *
+ * \english
+ * Collects synonym pairs and writes them as a compiled lexicon.
+ *
+ * Words are normalized by <code>Text::prepareWord</code> when they are
+ * added, duplicates are removed when the lexicon is written.
+ * \endenglish
+ *
+ * @see BinaryLexicon
+ *
+ * @version 1.1
+ */
+class BinaryLexiconWriter : public SynonymContainer< std::wstring >
+{
+public :
+    /**
+     * \french
+     * Constructeur.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     * \endenglish
+     */
+    BinaryLexiconWriter();
+
+    /**
+     * \french
+     * Destructeur.
+     * \endfrench
+     *
+     * \english
+     * Destructor.
+     * \endenglish
+     */
+    virtual ~BinaryLexiconWriter();
+
+    void addSynonyms( std::wstring& word1, std::wstring& word2 );
+
+    /**
+     * \french
+     * Retourne le nombre de paires ajout�es, doublons compris.
+     *
+     * @return Le nombre de paires.
+     * \endfrench
+     *
+     * \english
+     * Gets the number of added pairs, duplicates included.
+     *
+     * @return The number of pairs.
+     * \endenglish
+     */
+    size_t getPairCount() const;
+
+    /**
+     * \french
+     * �crit le lexique compil�.
+     *
+     * @param filename Le chemin du fichier � �crire.
+     *
+     * @throw Exception Si le fichier ne peut �tre �crit.
+     * \endfrench
+     *
+     * \english
+     * Writes the compiled lexicon.
+     *
+     * @param filename The path of the file to write.
+     *
+     * @throw Exception If the file can't be written.
+     * \endenglish
+     */
+    void write( const std::string& filename );
+
+private :
+    /** 
+     * \french
+     * Les paires de mots normalis�s. 
+     * \endfrench
+     *
+     * \english
+     * The normalized word pairs. 
+     * \endenglish
+     */
+    std::vector< std::pair< std::wstring, std::wstring > > m_pairs;
+};
+
+}// namespace japa
+
+#endif
@@ -0,0 +1,305 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#ifndef JAPA_BITEXT_PRINTER_H
+#define JAPA_BITEXT_PRINTER_H
+
+#include "mappedtext.h"
+#include "solutionprinter.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Imprime le bitexte align� : le texte des phrases source et cible de chaque
+ * alignement, c�te � c�te.
+ *
+ * Le texte est copi� tel quel depuis les fichiers d'entr�e projet�s en
+ * m�moire.  Les phrases d'un m�me c�t� d'un alignement sont s�par�es par une
+ * espace.  Deux formats sont offerts :
+ *
+ * <ul>
+ * <li>TSV : <code>source\\tcible</code>, une ligne par alignement.  Les
+ * tabulations, fins de ligne et barres obliques inverses des phrases sont
+ * �chapp�es en <code>\\t</code>, <code>\\n</code>, <code>\\r</code> et
+ * <code>\\\\</code>, pour garder deux colonnes.</li>
+ * <li>JSONL : <code>{"source":"...","target":"...","certainty":x}</code>, un
+ * objet par ligne.</li>
+ * </ul>
+ *
+ * @param T Le type du score de la solution.
+ * \endfrench
+ *
+ * \english
+ * Prints the aligned bitext: the text of each alignment's source and target
+ * sentences, side by side.
+ *
+ * The text is copied as is from the input files mapped in memory.  The
+ * sentences on the same side of an alignment are separated by a space.  Two
+ * formats are offered :
+ *
+ * <ul>
+ * <li>TSV : <code>source\\ttarget</code>, one line per alignment.  The tabs,
+ * line breaks and backslashes of the sentences are escaped as
+ * <code>\\t</code>, <code>\\n</code>, <code>\\r</code> and
+ * <code>\\\\</code>, to keep two columns.</li>
+ * <li>JSONL : <code>{"source":"...","target":"...","certainty":x}</code>, one
+ * object per line.</li>
+ * </ul>
+ *
+ * @param T The score's data type.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+template< class T >
+class BitextPrinter : public SolutionPrinter< T >
+{
+public :
+    /** 
+     * \french
+     * Le type de donn�e de la solution. 
+     * \endfrench
+     *
+     * \english
+     * The solution's data type. 
+     * \endenglish
+     */
+    typedef typename SolutionPrinter< T >::Solution Solution;
+
+    /**
+     * \french
+     * Constructeur.
+     *
+     * @param source Le texte source projet�.
+     * @param target Le texte cible projet�.
+     * @param json Vrai pour le format JSONL, faux pour le format TSV.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     *
+     * @param source The mapped source text.
+     * @param target The mapped target text.
+     * @param json True for the JSONL format, false for the TSV format.
+     * \endenglish
+     */
+    BitextPrinter( const MappedText& source, const MappedText& target,
+                   const bool json );
+
+    void operator()( Utf8Writer& out, const Solution& solution );
+
+private :
+    /**
+     * \french
+     * Imprime les phrases d'un c�t� d'un alignement.
+     *
+     * @param out Le flux de sortie.
+     * @param text Le texte contenant les phrases.
+     * @param first L'indice de la premi�re phrase.
+     * @param count Le nombre de phrases.
+     * \endfrench
+     *
+     * \english
+     * Prints the sentences of one side of an alignment.
+     *
+     * @param out The output stream.
+     * @param text The text containing the sentences.
+     * @param first The first sentence's indice.
+     * @param count The number of sentences.
+     * \endenglish
+     */
+    void printSentences( Utf8Writer& out, const MappedText& text,
+                         const size_t first, const size_t count );
+
+    /**
+     * \french
+     * Imprime des octets en �chappant ce que JSON exige ou, en TSV, les
+     * tabulations, les fins de ligne et les barres obliques inverses.
+     *
+     * @param out Le flux de sortie.
+     * @param data Les octets, encod�s en UTF-8.
+     * @param length Le nombre d'octets.
+     * \endfrench
+     *
+     * \english
+     * Prints bytes, escaping what JSON requires or, in TSV, the tabs, the
+     * line breaks and the backslashes.
+     *
+     * @param out The output stream.
+     * @param data The bytes, encoded in UTF-8.
+     * @param length The number of bytes.
+     * \endenglish
+     */
+    void printEscaped( Utf8Writer& out, const char* data, 
+                       const size_t length );
+
+    /** 
+     * \french
+     * Le texte source projet�.
+     * \endfrench
+     *
+     * \english
+     * The mapped source text. 
+     * \endenglish
+     */
+    const MappedText& m_source;
+
+    /** 
+     * \french
+     * Le texte cible projet�.
+     * \endfrench
+     *
+     * \english
+     * The mapped target text. 
+     * \endenglish
+     */
+    const MappedText& m_target;
+
+    /** 
+     * \french
+     * Vrai pour le format JSONL.
+     * \endfrench
+     *
+     * \english
+     * True for the JSONL format.
+     * \endenglish
+     */
+    const bool m_json;
+};
+
+// ------------------------------------------------------------------------ //
+template< class T >
+BitextPrinter< T >::BitextPrinter( const MappedText& source,
+                                   const MappedText& target, const bool json )
+        : m_source( source ), m_target( target ), m_json( json )
+{}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+void BitextPrinter< T >::operator()( Utf8Writer& out, 
+                                     const Solution& solution )
+{
+    size_t isrc = 0;    // Indice de la phrase dans le texte source
+    size_t itgt = 0;    // Indice de la phrase dans le texte cible
+    double previousScore = 0; // Score de l'alignement pr�c�dent
+    typename Solution::const_iterator iter;
+
+    for( iter = solution.begin(); iter != solution.end(); iter++ )
+    {
+        if( m_json )
+        {
+            out << "{\"source\":\"";
+            printSentences( out, m_source, isrc, iter -> getSourceLength() );
+            out << "\",\"target\":\"";
+            printSentences( out, m_target, itgt, iter -> getTargetLength() );
+            out << "\",\"certainty\":" << iter -> getScore() - previousScore
+                << "}\n";
+        }
+        else
+        {
+            printSentences( out, m_source, isrc, iter -> getSourceLength() );
+            out << '\t';
+            printSentences( out, m_target, itgt, iter -> getTargetLength() );
+            out << '\n';
+        }
+
+        isrc += iter -> getSourceLength();
+        itgt += iter -> getTargetLength();
+        previousScore = iter -> getScore();
+    }
+}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+void BitextPrinter< T >::printSentences( Utf8Writer& out, 
+                                         const MappedText& text, 
+                                         const size_t first,
+                                         const size_t count )
+{
+    const char* sentence;
+    size_t length;
+
+    for( size_t i = first; i < first + count; i++ )
+    {
+        if( i != first )
+        {
+            out << ' ';
+        }
+
+        sentence = text.getSentence( i, length );
+        printEscaped( out, sentence, length );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+void BitextPrinter< T >::printEscaped( Utf8Writer& out, const char* data,
+                                       const size_t length )
+{
+    static const char HEX[] = "0123456789abcdef";
+    size_t run = 0;     // D�but des octets qui n'ont pas besoin d'�chappement
+
+    for( size_t i = 0; i < length; i++ )
+    {
+        unsigned char c = ( unsigned char )data[ i ];
+
+        if( c != '\\' && ( m_json ? c >= 0x20 && c != '"' :
+                                   c != '\t' && c != '\n' && c != '\r' ) )
+        {
+            continue;
+        }
+
+        out.write( data + run, i - run );
+        run = i + 1;
+
+        switch( c )
+        {
+        case '"' :
+            out << "\\\"";
+            break;
+
+        case '\\' :
+            out << "\\\\";
+            break;
+
+        case '\t' :
+            out << "\\t";
+            break;
+
+        case '\n' :
+            out << "\\n";
+            break;
+
+        case '\r' :
+            out << "\\r";
+            break;
+
+        default :
+            out << "\\u00" << HEX[ c >> 4 ] << HEX[ c & 0xF ];
+            break;
+        }
+    }
+
+    out.write( data + run, length - run );
+}
+
+}// namespace japa
+
+#endif
@@ -0,0 +1,136 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#include <algorithm>
+#include <memory>
+
+#include "bandmatrix.h"
+#include "cascadessf.h"
+#include "linearssf.h"
+#include "setsearchspace.h"
+#include "sparsedt.h"
+
+namespace japa
+{
+
+// ------------------------------------------------------------------------ //
+CascadeSSF::CascadeSSF( SearchSpaceFiller& filler, 
+                        ScoreFunction< double >& score,
+                        SolutionMarker& marker ) 
+        : m_filler( filler ), m_score( score ), m_marker( marker ),
+          m_maxMemory( 0 ), m_wideMemory( 0 ), m_maxCells( 0 ),
+          m_counter( NULL ), m_wideCells( 0 )
+{}
+
+// ------------------------------------------------------------------------ //
+SearchSpace& CascadeSSF::operator()( SearchSpace& searchspace )
+{
+    SetSearchSpace wide( searchspace.getLowerBoundX(), 
+                         searchspace.getLowerBoundY(),
+                         searchspace.getUpperBoundX(), 
+                         searchspace.getUpperBoundY() );
+    LinearSSF corridor( m_marker );
+    std::auto_ptr< DynamicTable< double > > band;
+    std::auto_ptr< DynamicTable< double > > hash;
+    std::auto_ptr< DynamicTable< double > > table;
+    size_t bandMemory;
+    size_t hashMemory;
+
+    // Premi�re passe : alignement peu co�teux sur l'espace large
+    m_filler( wide );
+    m_wideCells = m_maxCells > 0 ? ( *m_counter )( wide ) : 0;
+
+    band.reset( new SparseDT< double, BandMatrix >( wide, m_score ) );
+    hash.reset( new SparseDT< double >( wide, m_score ) );
+    bandMemory = band -> estimateMemory();
+    hashMemory = hash -> estimateMemory();
+
+    // M�me choix que pour la table finale ; au-del� du budget de cases,
+    // l'appelant se rabattra sans que la premi�re passe soit r�solue
+    if( m_wideCells > m_maxCells && m_maxCells > 0 )
+    {
+        m_wideMemory = std::min( bandMemory, hashMemory );
+    }
+    else if( m_maxMemory == 0 ? bandMemory <= hashMemory : 
+                                bandMemory <= m_maxMemory )
+    {
+        m_wideMemory = bandMemory;
+        table = band;
+    }
+    else if( m_maxMemory == 0 || hashMemory <= m_maxMemory )
+    {
+        m_wideMemory = hashMemory;
+        table = hash;
+    }
+    else
+    {
+        m_wideMemory = std::min( bandMemory, hashMemory );
+    }
+
+    corridor.addPassagePoint( searchspace.getLowerBoundX(), 
+                              searchspace.getLowerBoundY() );
+    corridor.addPassagePoint( searchspace.getUpperBoundX(), 
+                              searchspace.getUpperBoundY() );
+
+    // Sans table qui tienne dans les limites, l'appelant se rabattra
+    if( table.get() != NULL )
+    {
+        table -> solve();
+
+        // Les cases du chemin trouv� deviennent les points de passage du 
+        // corridor
+        DynamicTable< double >::Iterator iter = table -> getIterator();
+
+        while( iter.hasNext() )
+        {
+            iter.next();
+            corridor.addPassagePoint( iter.i(), iter.j() );
+        }
+    }
+
+    corridor( searchspace );
+
+    return searchspace;
+}
+
+// ------------------------------------------------------------------------ //
+void CascadeSSF::setMaxMemory( const size_t bytes )
+{
+    m_maxMemory = bytes;
+}
+
+// ------------------------------------------------------------------------ //
+size_t CascadeSSF::getWideMemory() const
+{
+    return m_wideMemory;
+}
+
+// ------------------------------------------------------------------------ //
+void CascadeSSF::setMaxCells( const size_t cells, const CellCounter& counter )
+{
+    m_maxCells = cells;
+    m_counter = &counter;
+}
+
+// ------------------------------------------------------------------------ //
+size_t CascadeSSF::getWideCells() const
+{
+    return m_wideCells;
+}
+
+}// namespace japa
@@ -0,0 +1,298 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#ifndef JAPA_CASCADE_SSF_H
+#define JAPA_CASCADE_SSF_H
+
+#include <cstddef>
+
+#include "scorefunction.h"
+#include "searchspacefiller.h"
+#include "solutionmarker.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Remplit un espace de recherche en deux passes.
+ *
+ * Une premi�re passe aligne les textes sur un espace de recherche large, 
+ * rempli par un autre emplisseur, avec une fonction de score peu co�teuse
+ * (typiquement Church & Gale).  L'espace de recherche final n'est ensuite 
+ * qu'un corridor autour du chemin trouv�, trac� par un marqueur de solution.
+ * La fonction de score co�teuse (Felipe) ne visite ainsi que ce corridor.
+ *
+ * La table de la premi�re passe est choisie comme la table finale : par
+ * bandes si elle occupe le moins de m�moire ou tient dans la limite, de
+ * hachage sinon.  Si aucune ne tient, ou si l'espace large d�passe le budget
+ * de cases, la premi�re passe n'est pas r�solue et le corridor ne relie que
+ * les coins de l'espace ; <code>getWideMemory</code> et
+ * <code>getWideCells</code> indiquent alors � l'appelant de se rabattre sur
+ * une configuration moins co�teuse.
+ * \endfrench
+ *
+ * \english
+ * Fills a search space in two passes.
+ *
+ * A first pass aligns the texts on a wide search space, filled by another
+ * filler, with a cheap score function (typically Church & Gale).  The final
+ * search space is then only a corridor around the path found, drawn by a
+ * solution marker.  The expensive score function (Felipe) thus only visits
+ * this corridor.
+ *
+ * The first pass' table is chosen like the final one: band if it takes the
+ * least memory or fits the limit, hash otherwise.  When neither fits, or
+ * when the wide space exceeds the cells budget, the first pass is not solved
+ * and the corridor only joins the space's corners; <code>getWideMemory</code>
+ * and <code>getWideCells</code> then tell the caller to fall back.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class CascadeSSF : public SearchSpaceFiller
+{
+public :
+    /**
+     * \french
+     * Compte les cases d'un espace de recherche comme le budget de
+     * l'appelant, par exemple celles de la paire de documents qui en a le
+     * plus.
+     * \endfrench
+     *
+     * \english
+     * Counts the cells of a search space like the caller's budget does, for
+     * instance those of the document pair having the most.
+     * \endenglish
+     */
+    class CellCounter
+    {
+    public :
+        /**
+         * \french
+         * Destructeur.
+         * \endfrench
+         *
+         * \english
+         * Destructor.
+         * \endenglish
+         */
+        virtual ~CellCounter() {}
+
+        /**
+         * \french
+         * Compte les cases d'un espace de recherche rempli.
+         *
+         * @param space L'espace de recherche.
+         *
+         * @return Le nombre de cases.
+         * \endfrench
+         *
+         * \english
+         * Counts the cells of a filled search space.
+         *
+         * @param space The search space.
+         *
+         * @return The number of cells.
+         * \endenglish
+         */
+        virtual size_t operator()( const SearchSpace& space ) const = 0;
+    };
+
+    /**
+     * \french
+     * Constructeur.
+     * 
+     * @param filler L'emplisseur de l'espace de recherche de la premi�re
+     *               passe.
+     * @param score La fonction de score de la premi�re passe.
+     * @param marker Le marqueur qui trace le corridor autour du chemin.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     *
+     * @param filler The first pass' search space filler.
+     * @param score The first pass' score function.
+     * @param marker The marker drawing the corridor around the path.
+     * \endenglish
+     */
+    CascadeSSF( SearchSpaceFiller& filler, ScoreFunction< double >& score,
+                SolutionMarker& marker );
+
+    SearchSpace& operator()( SearchSpace& s );
+
+    /**
+     * \french
+     * Fixe la m�moire permise � la table de la premi�re passe.
+     *
+     * @param bytes Le nombre d'octets, 0 pour aucune limite.
+     * \endfrench
+     *
+     * \english
+     * Sets the memory allowed to the first pass' table.
+     *
+     * @param bytes The number of bytes, 0 for no limit.
+     * \endenglish
+     */
+    void setMaxMemory( const size_t bytes );
+
+    /**
+     * \french
+     * Retourne la m�moire estim�e de la table de la derni�re premi�re passe.
+     *
+     * @return Le nombre d'octets de la table choisie, ou de la plus petite si
+     *         aucune ne tenait dans la limite.
+     * \endfrench
+     *
+     * \english
+     * Returns the estimated memory of the last first pass' table.
+     *
+     * @return The number of bytes of the chosen table, or of the smallest if
+     *         none fitted the limit.
+     * \endenglish
+     */
+    size_t getWideMemory() const;
+
+    /**
+     * \french
+     * Fixe le budget de cases de l'espace large de la premi�re passe.
+     *
+     * @param cells Le nombre de cases, 0 pour aucune limite.
+     * @param counter Le compteur des cases, qui doit survivre �
+     *                l'emplisseur.
+     * \endfrench
+     *
+     * \english
+     * Sets the cells budget of the first pass' wide space.
+     *
+     * @param cells The number of cells, 0 for no limit.
+     * @param counter The cells' counter, which must outlive the filler.
+     * \endenglish
+     */
+    void setMaxCells( const size_t cells, const CellCounter& counter );
+
+    /**
+     * \french
+     * Retourne le nombre de cases de l'espace large de la derni�re premi�re
+     * passe, compt� seulement si un budget de cases est fix�.
+     *
+     * @return Le nombre de cases, 0 sans budget.
+     * \endfrench
+     *
+     * \english
+     * Returns the number of cells of the last first pass' wide space, only
+     * counted when a cells budget is set.
+     *
+     * @return The number of cells, 0 without a budget.
+     * \endenglish
+     */
+    size_t getWideCells() const;
+
+private :
+    /** 
+     * \french
+     * L'emplisseur de la premi�re passe. 
+     * \endfrench
+     *
+     * \english
+     * The first pass' filler. 
+     * \endenglish
+     */
+    SearchSpaceFiller& m_filler;
+
+    /** 
+     * \french
+     * La fonction de score de la premi�re passe. 
+     * \endfrench
+     *
+     * \english
+     * The first pass' score function. 
+     * \endenglish
+     */
+    ScoreFunction< double >& m_score;
+
+    /** 
+     * \french
+     * Le marqueur du corridor. 
+     * \endfrench
+     *
+     * \english
+     * The corridor's marker. 
+     * \endenglish
+     */
+    SolutionMarker& m_marker;
+
+    /** 
+     * \french
+     * La m�moire permise � la table de la premi�re passe, 0 sans limite. 
+     * \endfrench
+     *
+     * \english
+     * The memory allowed to the first pass' table, 0 without limit. 
+     * \endenglish
+     */
+    size_t m_maxMemory;
+
+    /** 
+     * \french
+     * La m�moire estim�e de la table de la derni�re premi�re passe. 
+     * \endfrench
+     *
+     * \english
+     * The estimated memory of the last first pass' table. 
+     * \endenglish
+     */
+    size_t m_wideMemory;
+
+    /** 
+     * \french
+     * Le budget de cases de l'espace large, 0 sans limite. 
+     * \endfrench
+     *
+     * \english
+     * The wide space's cells budget, 0 without limit. 
+     * \endenglish
+     */
+    size_t m_maxCells;
+
+    /** 
+     * \french
+     * Le compteur des cases de l'espace large, s'il y a un budget. 
+     * \endfrench
+     *
+     * \english
+     * The wide space's cells counter, if there is a budget. 
+     * \endenglish
+     */
+    const CellCounter* m_counter;
+
+    /** 
+     * \french
+     * Le nombre de cases de l'espace large de la derni�re premi�re passe. 
+     * \endfrench
+     *
+     * \english
+     * The number of cells of the last first pass' wide space. 
+     * \endenglish
+     */
+    size_t m_wideCells;
+};
+
+}// namespace japa
+#endif
@@ -87,7 +87,25 @@ public :
             const std::wstring& sourceName = "",
             const std::wstring& targetName = "" );
     
-    void operator()( std::wostream& out, const Solution& solution );
+    /**
+     * \french
+     * Ajuste les indices des premi�res phrases de la solution dans les
+     * textes.
+     *
+     * @param source L'indice de la premi�re phrase source.
+     * @param target L'indice de la premi�re phrase cible.
+     * \endfrench
+     *
+     * \english
+     * Sets the subscripts of the solution's first sentences in the texts.
+     *
+     * @param source The first source sentence's subscript.
+     * @param target The first target sentence's subscript.
+     * \endenglish
+     */
+    void setOrigin( const size_t source, const size_t target );
+
+    void operator()( Utf8Writer& out, const Solution& solution );
 
 private :
     /** 
@@ -133,6 +151,28 @@ private :
      * \endenglish
      */
     const std::wstring m_targetName;
+
+    /** 
+     * \french
+     * L'indice de la premi�re phrase source de la solution. 
+     * \endfrench
+     *
+     * \english
+     * The solution's first source sentence subscript. 
+     * \endenglish
+     */
+    size_t m_sourceOrigin;
+
+    /** 
+     * \french
+     * L'indice de la premi�re phrase cible de la solution. 
+     * \endfrench
+     *
+     * \english
+     * The solution's first target sentence subscript. 
+     * \endenglish
+     */
+    size_t m_targetOrigin;
 };
 
 // ------------------------------------------------------------------------ //
@@ -141,29 +181,40 @@ template< class T >
 CesalignPrinter< T >::CesalignPrinter( const Text& source, const Text& target,
        const std::wstring& sourceName, const std::wstring& targetName )
         : m_source( source ), m_target( target ), 
-          m_sourceName( sourceName ), m_targetName( targetName )
+          m_sourceName( sourceName ), m_targetName( targetName ),
+          m_sourceOrigin( 0 ), m_targetOrigin( 0 )
 {}
 
 // ------------------------------------------------------------------------ //
 template< class T >
-void CesalignPrinter< T >::operator()( std::wostream& out,
+void CesalignPrinter< T >::setOrigin( const size_t source, const size_t target )
+{
+    m_sourceOrigin = source;
+    m_targetOrigin = target;
+}
+
+// ------------------------------------------------------------------------ //
+template< class T >
+void CesalignPrinter< T >::operator()( Utf8Writer& out,
                                        const Solution& solution )
 {
     ArcadePrinter< T > ap( m_source, m_target );
 
+    ap.setOrigin( m_sourceOrigin, m_targetOrigin );
+
     out << L"<!DOCTYPE CESALIGN PUBLIC \"-//CES//DTD cesAlign//EN\" []>"
-        << std::endl
+        << '\n'
         << L"<cesAlign VERSION=\"1.14\"  type=\"sent\" "
         << L"fromDoc=\"" << m_sourceName
-        << L"\" toDoc=\"" << m_targetName << "\">" << std::endl
-        << L"<linkList>" << std::endl
-        << L"<linkGrp>" << std::endl;
+        << L"\" toDoc=\"" << m_targetName << "\">" << '\n'
+        << L"<linkList>" << '\n'
+        << L"<linkGrp>" << '\n';
     
     ap( out, solution );
     
-    out << L"</linkGrp>" << std::endl
-        << L"</linkList>" << std::endl
-        << L"</cesAlign>" << std::endl;
+    out << L"</linkGrp>" << '\n'
+        << L"</linkList>" << '\n'
+        << L"</cesAlign>" << '\n';
 }
 }// namespace japa
 
@@ -129,6 +129,7 @@ bool CesanaParser::operator()( std::wistream& in, Text& text )
                 break;
             case BEGIN_SENTENCE :
                 text.pushSentence( tok.value );
+                advance();
                 break;
             case BEGIN_PARAGRAPH :
                 text.pushParagraph();
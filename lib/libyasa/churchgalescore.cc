@@ -16,10 +16,12 @@ limitations under the License.
 
 */  
 
+#include <algorithm>
 #include <cmath>
 
 #include "churchgalescore.h"
 #include "statistic.h"
+#include "trace.h"
 
 namespace japa
 {
@@ -60,6 +62,9 @@ void ChurchGaleScore::addAlignment( const size_t lengthSource,
 {
     bool exists = false;
     PossibleAlignments::iterator iter;
+
+    // Les cots calculs d'avance ne couvrent plus les alignements
+    clearCosts();
     
     if( probability > m_maxProbability )
     {
@@ -115,6 +120,7 @@ double ChurchGaleScore::operator()( const DynamicTable< double >& dt,
         size_t lengthTgt;
         double penalty;
         PossibleAlignments::const_iterator iter;
+        const double* costs = m_costs.find( i, j );
         
         // Considre chacun des alignements possibles.
         for( iter = m_alignments.begin(); iter != m_alignments.end(); iter++ )
@@ -123,9 +129,18 @@ double ChurchGaleScore::operator()( const DynamicTable< double >& dt,
             lengthTgt = ( iter -> first ).second;
             penalty = ( iter -> second ).second;
             
-            if( dt.getScore( i - lengthSrc, j - lengthTgt, score ) )
+            if( isAllowed( i, j, lengthSrc, lengthTgt ) &&
+                dt.getScore( i - lengthSrc, j - lengthTgt, score ) )
             {
-                score += computeScore( i, j, lengthSrc, lengthTgt, penalty );
+                if( costs != NULL )
+                {
+                    score += costs[ iter - m_alignments.begin() ];
+                }
+                else
+                {
+                    score += computeScore( i, j, lengthSrc, lengthTgt, 
+                                           penalty );
+                }
                 
                 if( score < minScore )
                 {
@@ -141,6 +156,88 @@ double ChurchGaleScore::operator()( const DynamicTable< double >& dt,
     return minScore;
 }
 
+// ------------------------------------------------------------------------ //
+void ChurchGaleScore::precomputeCosts( const SearchSpace& space )
+{
+    const int lowY = std::max( space.getLowerBoundY(), 0 );
+    const int highY = space.getUpperBoundY();
+
+    m_costs.init( space, m_alignments.size() );
+
+    // Seules les cases de l'espace sont calcules, pas les trous entre les
+    // bornes d'une colonne.  Chaque range n'crit que ses propres cases, les
+    // ranges peuvent donc tre traites en parallle (si compil avec
+    // OpenMP).
+    #pragma omp parallel
+    {
+        // Chaque fil trace sa part ; sans attendre les autres, sa fin montre
+        // le temps qu'il passera inactif
+        JAPA_TRACE_SCOPE( "precomputeCosts worker", std::string() );
+
+        #pragma omp for schedule( dynamic, 16 ) nowait
+        for( int j = lowY; j <= highY; j++ )
+        {
+            SearchSpace::Iterator iter = space.getIterator( j );
+
+            while( iter.hasNext() )
+            {
+                iter.next();
+
+                const int i = iter.x();
+                double* costs = m_costs.find( i, j );
+
+                // La colonne i = -1 n'a pas de cots
+                if( costs == NULL )
+                {
+                    continue;
+                }
+
+                for( size_t k = 0; k < m_alignments.size(); k++ )
+                {
+                    costs[ k ] = computeScore( 
+                            i, j, m_alignments[ k ].first.first,
+                            m_alignments[ k ].first.second,
+                            m_alignments[ k ].second.second );
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void ChurchGaleScore::clearCosts()
+{
+    m_costs.clear();
+}
+
+// ------------------------------------------------------------------------ //
+bool ChurchGaleScore::hasCosts() const
+{
+    return !m_costs.isEmpty();
+}
+
+// ------------------------------------------------------------------------ //
+size_t ChurchGaleScore::estimateCostMemory( const SearchSpace& space ) const
+{
+    return CostTable::estimateMemory( space, m_alignments.size() );
+}
+
+// ------------------------------------------------------------------------ //
+void ChurchGaleScore::setAnchors( const Anchors& anchors )
+{
+    m_anchors = anchors;
+}
+
+// ------------------------------------------------------------------------ //
+bool ChurchGaleScore::isAllowed( const int i, const int j,
+                                 const size_t lengthSource,
+                                 const size_t lengthTarget ) const
+{
+    return m_anchors.isEmpty() || 
+           m_anchors.allows( i - ( int )lengthSource, j - ( int )lengthTarget,
+                             i, j );
+}
+
 // ------------------------------------------------------------------------ //
 double ChurchGaleScore::computeScore( const size_t sentSource, 
                                       const size_t sentTarget, 
@@ -209,6 +306,25 @@ double ChurchGaleScore::match( const size_t length1,
     return value;
 }
 
+// ------------------------------------------------------------------------ //
+size_t ChurchGaleScore::getAlignmentCount() const
+{
+    return m_alignments.size();
+}
+
+// ------------------------------------------------------------------------ //
+void ChurchGaleScore::getAlignment( const size_t indice, 
+                                    size_t& lengthSource,
+                                    size_t& lengthTarget, 
+                                    double& penalty ) const
+{
+    const Alignment& align = m_alignments[ indice ];
+
+    lengthSource = align.first.first;
+    lengthTarget = align.first.second;
+    penalty = align.second.second;
+}
+
 // ------------------------------------------------------------------------ //
 double ChurchGaleScore::computePenalty( double probability )
 {
@@ -19,7 +19,10 @@ limitations under the License.
 #ifndef JAPA_CHURCH_GALE_SCORE_H
 #define JAPA_CHURCH_GALE_SCORE_H
 
+#include "anchors.h"
+#include "costtable.h"
 #include "scorefunction.h"
+#include "searchspace.h"
 #include "text.h"
 
 #include <utility>
@@ -126,6 +129,101 @@ public :
     double operator()( const DynamicTable< double >& dt, 
                        const int i, const int j,
                        int& pi, int& pj );
+
+    /**
+     * \french
+     * Calcule d'avance le co�t de chaque alignement possible pour chaque case
+     * de l'espace de recherche.
+     *
+     * Le co�t d'une transition ne d�pend pas de la table dynamique : les
+     * cases sont donc calcul�es en parall�le (si compil� avec OpenMP) et la
+     * r�currence n'a plus qu'� lire le tableau.
+     *
+     * @note Doit �tre appel�e une fois les alignements et les param�tres
+     *       fix�s.  Un nouvel alignement efface le tableau.
+     *
+     * @param space L'espace de recherche qui sera r�solu.
+     * \endfrench
+     *
+     * \english
+     * Computes in advance the cost of each possible alignment for each cell
+     * of the search space.
+     *
+     * A transition's cost does not depend on the dynamic table: the cells are
+     * thus computed in parallel (if compiled with OpenMP) and the recurrence
+     * only has to read the array.
+     *
+     * @note Must be called once the alignments and parameters are set.  A new
+     *       alignment clears the array.
+     *
+     * @param space The search space that will be solved.
+     * \endenglish
+     */
+    void precomputeCosts( const SearchSpace& space );
+
+    /**
+     * \french
+     * Efface les co�ts calcul�s d'avance.
+     * \endfrench
+     *
+     * \english
+     * Clears the costs computed in advance.
+     * \endenglish
+     */
+    void clearCosts();
+
+    /**
+     * \french
+     * V�rifie si les co�ts ont �t� calcul�s d'avance.
+     *
+     * @return <code>true</code> si les co�ts sont disponibles.
+     * \endfrench
+     *
+     * \english
+     * Checks if the costs were computed in advance.
+     *
+     * @return <code>true</code> if the costs are available.
+     * \endenglish
+     */
+    bool hasCosts() const;
+
+    /**
+     * \french
+     * Estime la m�moire qu'occuperaient les co�ts calcul�s d'avance pour un
+     * espace de recherche.
+     *
+     * @param space L'espace de recherche.
+     *
+     * @return Le nombre d'octets.
+     * \endfrench
+     *
+     * \english
+     * Estimates the memory the costs computed in advance would take for a
+     * search space.
+     *
+     * @param space The search space.
+     *
+     * @return The number of bytes.
+     * \endenglish
+     */
+    size_t estimateCostMemory( const SearchSpace& space ) const;
+
+    /**
+     * \french
+     * Fixe les points d'ancrage que la solution doit traverser.  Les
+     * alignements qui sautent un point ne sont pas consid�r�s.
+     *
+     * @param anchors Les points d'ancrage, copi�s.
+     * \endfrench
+     *
+     * \english
+     * Sets the anchor points the solution must go through.  The alignments
+     * that jump over a point are not considered.
+     *
+     * @param anchors The anchor points, copied.
+     * \endenglish
+     */
+    void setAnchors( const Anchors& anchors );
     
     /**
      * \french
@@ -429,6 +527,69 @@ protected :
      * \endenglish
      */
     double match( const size_t length1, const size_t length2 ) const;
+
+    /**
+     * \french
+     * Retourne le nombre d'alignements possibles.
+     *
+     * @return Le nombre d'alignements possibles.
+     * \endfrench
+     *
+     * \english
+     * Returns the number of possible alignments.
+     *
+     * @return The number of possible alignments.
+     * \endenglish
+     */
+    size_t getAlignmentCount() const;
+
+    /**
+     * \french
+     * Retourne un alignement possible.
+     *
+     * @param indice L'indice de l'alignement, dans l'ordre d'ajout.
+     * @param lengthSource Re�oit le nombre de phrases sources.
+     * @param lengthTarget Re�oit le nombre de phrases cibles.
+     * @param penalty Re�oit la p�nalit� associ�e � l'alignement.
+     * \endfrench
+     *
+     * \english
+     * Returns a possible alignment.
+     *
+     * @param indice The alignment's indice, in the order of addition.
+     * @param lengthSource Receives the number of source's sentences.
+     * @param lengthTarget Receives the number of target's sentences.
+     * @param penalty Receives the alignment's penalty.
+     * \endenglish
+     */
+    void getAlignment( const size_t indice, size_t& lengthSource,
+                       size_t& lengthTarget, double& penalty ) const;
+
+    /**
+     * \french
+     * V�rifie qu'un alignement ne saute aucun point d'ancrage.
+     *
+     * @param i La colonne de la case courante.
+     * @param j La rang�e de la case courante.
+     * @param lengthSource Le nombre de phrases sources.
+     * @param lengthTarget Le nombre de phrases cibles.
+     *
+     * @return <code>true</code> si l'alignement est permis.
+     * \endfrench
+     *
+     * \english
+     * Checks that an alignment does not jump over an anchor point.
+     *
+     * @param i The current cell's column.
+     * @param j The current cell's row.
+     * @param lengthSource Number of source's sentences.
+     * @param lengthTarget Number of target's sentences.
+     *
+     * @return <code>true</code> if the alignment is allowed.
+     * \endenglish
+     */
+    bool isAllowed( const int i, const int j, const size_t lengthSource,
+                    const size_t lengthTarget ) const;
         
 private :
     /** 
@@ -595,6 +756,28 @@ private :
      * \endenglish
      */
     double m_penaltyWeight;
+
+    /** 
+     * \french
+     * Les co�ts des transitions calcul�s d'avance.
+     * \endfrench
+     *
+     * \english
+     * The transition costs computed in advance.
+     * \endenglish
+     */
+    CostTable m_costs;
+
+    /** 
+     * \french
+     * Les points d'ancrage de la solution.
+     * \endfrench
+     *
+     * \english
+     * The solution's anchor points.
+     * \endenglish
+     */
+    Anchors m_anchors;
 };
 
 }// namespace japa
@@ -34,7 +34,8 @@ CognateSSF::CognateSSF( Text& source, Text& target,
                         const size_t radius, const size_t maxFrequency )
         : m_source( source ), m_target( target ), m_solMarker( solMarker ),
           m_returnCount( returnCount ), m_returnCost( returnCost ),
-          m_radius( radius ), m_maxFrequency( maxFrequency )
+          m_radius( radius ), m_maxFrequency( maxFrequency ),
+          m_progress( NULL )
 {}
 
 
@@ -58,6 +59,12 @@ SearchSpace& CognateSSF::operator()( SearchSpace& s )
 
     wordSSF( wordSS );
 
+    if( m_progress != NULL )
+    {
+        m_progress -> setTask( "Aligning cognates" );
+    }
+
+    wordDT.setProgress( m_progress );
     wordDT.solve();
 
     // Remplit l'espace de recherche pour l'alignement des phrases.
@@ -66,6 +73,40 @@ SearchSpace& CognateSSF::operator()( SearchSpace& s )
     return s;
 }
 
+// ------------------------------------------------------------------------ //
+size_t CognateSSF::estimatePoints( const size_t begin, const size_t end ) const
+{
+    CognateSSValidator validator( m_maxFrequency );
+    WordInfo::Synonyms::const_iterator synIter;
+    size_t points = 0;
+
+    // Chaque mot source valide rejoint toutes les occurrences cibles de ses
+    // synonymes, comme dans WordSSF
+    for( size_t i = begin; i < end && i < m_source.getWordCount(); i++ )
+    {
+        const WordInfo& word = m_source.getWord( i );
+
+        if( !validator( word ) )
+        {
+            continue;
+        }
+
+        for( synIter = word.getSynonyms().begin(); 
+             synIter != word.getSynonyms().end(); synIter++ )
+        {
+            points += ( *synIter ) -> getFrequency();
+        }
+    }
+
+    return points;
+}
+
+// ------------------------------------------------------------------------ //
+void CognateSSF::setProgress( Progress* progress )
+{
+    m_progress = progress;
+}
+
 // ------------------------------------------------------------------------ //
 void CognateSSF::fill( SearchSpace& searchspace, 
                        DynamicTable< double >& wordDT ) const
@@ -96,6 +96,53 @@ public :
                 const size_t maxFrequency = CognateSSValidator::DEFAULT_MAX_FREQUENCY );
     
     SearchSpace& operator()( SearchSpace& s );
+
+    /**
+     * \french
+     * Estime, avant de les chercher, le nombre de points de l'espace de
+     * recherche des mots issus d'une suite de mots sources.  L'estimation
+     * ne tient pas compte de la d�viance permise et borne donc le nombre
+     * r�el de points.
+     *
+     * @param begin L'indice du premier mot source.
+     * @param end L'indice qui suit le dernier mot source.
+     *
+     * @return Le nombre estim� de points.
+     * \endfrench
+     *
+     * \english
+     * Estimates, before looking for them, the number of points of the words'
+     * search space coming from a range of source words.  The estimate
+     * ignores the allowed deviance, and so bounds the actual number of
+     * points.
+     *
+     * @param begin The first source word's indice.
+     * @param end The indice following the last source word.
+     *
+     * @return The estimated number of points.
+     * \endenglish
+     */
+    size_t estimatePoints( const size_t begin, const size_t end ) const;
+
+    /**
+     * \french
+     * Fixe le rapport d'avancement de l'alignement des cognates.
+     *
+     * @note Seule l'adresse est conserv�e.
+     *
+     * @param progress Le rapport d'avancement, <code>NULL</code> pour n'en
+     *                 donner aucun.
+     * \endfrench
+     *
+     * \english
+     * Sets the progress report of the cognates' alignment.
+     *
+     * @note Only the address is kept.
+     *
+     * @param progress The progress report, <code>NULL</code> to give none.
+     * \endenglish
+     */
+    void setProgress( Progress* progress );
     
 private :
     /**
@@ -195,6 +242,17 @@ private :
      * \endenglish
      */
     const size_t m_maxFrequency;
+
+    /** 
+     * \french
+     * Le rapport d'avancement, <code>NULL</code> s'il n'y en a pas.
+     * \endfrench
+     *
+     * \english
+     * The progress report, <code>NULL</code> if there is none.
+     * \endenglish
+     */
+    Progress* m_progress;
 };
 
 }// namespace japa
@@ -33,22 +33,8 @@ CognateSSValidator::~CognateSSValidator()
 // ------------------------------------------------------------------------ //
 bool CognateSSValidator::operator()( const WordInfo& data )
 {
-    bool valid = false;
-    size_t freq = 0;
-    const WordInfo::Synonyms& syn = data.getSynonyms();
-    WordInfo::Synonyms::const_iterator iter; 
-
-    if( data.getFrequency() <= getMaxFrequency() )
-    {
-        for( iter = syn.begin(); iter != syn.end(); iter++ )
-        {
-            freq += ( *iter ) -> getFrequency();
-        }
-
-        valid = ( freq <= getMaxFrequency() );
-    }
-
-    return valid;
+    return data.getFrequency() <= getMaxFrequency() &&
+           data.getSynonymFrequency() <= getMaxFrequency();
 }
 
 // ------------------------------------------------------------------------ //
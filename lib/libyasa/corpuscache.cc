@@ -0,0 +1,455 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "corpuscache.h"
+#include "japaexception.h"
+#include "toolbox.h"
+
+namespace japa
+{
+
+// ------------------------------------------------------------------------ //
+const char CorpusCache::MAGIC[ 8 ] = { 'Y', 'A', 'S', 'A', 'C', 'R', 'P', '1' };
+
+/** Le point de d�part de l'empreinte FNV-1a */
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+
+/** Le multiplicateur de l'empreinte FNV-1a */
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// ------------------------------------------------------------------------ //
+CorpusCache::CorpusCache() : m_key( FNV_OFFSET )
+{}
+
+// ------------------------------------------------------------------------ //
+CorpusCache::~CorpusCache()
+{}
+
+// ------------------------------------------------------------------------ //
+void CorpusCache::addFile( const std::string& filename )
+{
+    char buffer[ 65536 ];
+    uint64_t size = 0;
+    std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+
+    if( in.fail() )
+    {
+        throw Exception( "Can't read file : " + filename );
+    }
+
+    while( in.read( buffer, sizeof( buffer ) ) || in.gcount() > 0 )
+    {
+        addBytes( buffer, in.gcount() );
+        size += in.gcount();
+    }
+
+    // La taille s�pare le contenu des fichiers successifs
+    addBytes( ( const char* )&size, sizeof( size ) );
+}
+
+// ------------------------------------------------------------------------ //
+void CorpusCache::addOption( const std::string& value )
+{
+    addBytes( value.c_str(), value.size() + 1 );
+}
+
+// ------------------------------------------------------------------------ //
+std::string CorpusCache::getFilename( const std::string& directory ) const
+{
+    char name[ 32 ];
+
+    sprintf( name, "%016llx.ycache", ( unsigned long long )m_key );
+
+    if( directory.empty() || directory[ directory.size() - 1 ] == '/' )
+    {
+        return directory + name;
+    }
+
+    return directory + "/" + name;
+}
+
+// ------------------------------------------------------------------------ //
+bool CorpusCache::load( const std::string& filename, Text& source, 
+                        Text& target, std::vector< size_t >& sourceCounts,
+                        std::vector< size_t >& targetCounts ) const
+{
+    int fd;
+    struct stat st;
+    void* mapped;
+    const Header* header;
+    Reader reader;
+    const uint64_t* section;
+    uint64_t size;
+    const uint64_t* first;
+    std::vector< WordInfo* > sourceWords;
+    std::vector< WordInfo* > targetWords;
+    bool valid;
+
+    fd = ::open( filename.c_str(), O_RDONLY );
+
+    if( fd < 0 )
+    {
+        return false;
+    }
+
+    if( fstat( fd, &st ) != 0 || ( size_t )st.st_size < sizeof( Header ) )
+    {
+        ::close( fd );
+        return false;
+    }
+
+    mapped = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if( mapped == MAP_FAILED )
+    {
+        return false;
+    }
+
+    header = ( const Header* )mapped;
+    reader.cursor = ( const uint64_t* )( header + 1 );
+    reader.end = reader.cursor + header -> dataSize;
+
+    valid = memcmp( header -> magic, MAGIC, sizeof( MAGIC ) ) == 0 &&
+            header -> byteOrder == ENDIAN_MARK &&
+            header -> key == m_key &&
+            ( size_t )st.st_size == sizeof( Header ) + 
+                                    header -> dataSize * sizeof( uint64_t );
+
+    valid = valid && readText( reader, source, sourceWords ) &&
+                     readText( reader, target, targetWords );
+
+    // Les synonymes de chaque mot source
+    valid = valid && nextSection( reader, first, size ) && 
+            size == sourceWords.size() + 1 && 
+            nextSection( reader, section, size ) && 
+            first[ sourceWords.size() ] == size;
+
+    for( size_t w = 0; valid && w < sourceWords.size(); w++ )
+    {
+        for( uint64_t s = first[ w ]; valid && s < first[ w + 1 ]; s++ )
+        {
+            valid = section[ s ] < targetWords.size();
+
+            if( valid )
+            {
+                sourceWords[ w ] -> addSynonym( *targetWords[ section[ s ] ] );
+            }
+        }
+    }
+
+    // Le nombre de phrases de chaque paire de documents
+    valid = valid && nextSection( reader, section, size ) && size % 2 == 0;
+
+    for( size_t d = 0; valid && d < size; d += 2 )
+    {
+        sourceCounts.push_back( section[ d ] );
+        targetCounts.push_back( section[ d + 1 ] );
+    }
+
+    munmap( mapped, st.st_size );
+
+    return valid;
+}
+
+// ------------------------------------------------------------------------ //
+void CorpusCache::save( const std::string& filename, const Text& source,
+                        const Text& target,
+                        const std::vector< size_t >& sourceCounts,
+                        const std::vector< size_t >& targetCounts ) const
+{
+    Header header;
+    std::vector< uint64_t > data;
+    std::vector< uint64_t > first;
+    std::vector< uint64_t > synonyms;
+    std::vector< uint64_t > counts;
+    std::map< const WordInfo*, uint64_t > sourceIndices;
+    std::map< const WordInfo*, uint64_t > targetIndices;
+    TextDictionary::const_iterator iter;
+    WordInfo::Synonyms::const_iterator syn;
+    std::string temporary = filename + "." + toString( getpid() );
+    std::ofstream out;
+
+#ifdef _OPENMP
+    // Deux paires identiques d'une liste peuvent �tre sauv�es en m�me temps
+    temporary += "." + toString( omp_get_thread_num() );
+#endif
+
+    temporary += ".tmp";
+
+    writeText( data, source, sourceIndices );
+    writeText( data, target, targetIndices );
+
+    // Les synonymes suivent l'ordre du vocabulaire source
+    for( iter = source.m_dictionary.begin(); 
+         iter != source.m_dictionary.end(); iter++ )
+    {
+        first.push_back( synonyms.size() );
+
+        for( syn = iter -> second.getSynonyms().begin(); 
+             syn != iter -> second.getSynonyms().end(); syn++ )
+        {
+            synonyms.push_back( targetIndices[ *syn ] );
+        }
+    }
+
+    first.push_back( synonyms.size() );
+    pushSection( data, first );
+    pushSection( data, synonyms );
+
+    for( size_t d = 0; d < sourceCounts.size(); d++ )
+    {
+        counts.push_back( sourceCounts[ d ] );
+        counts.push_back( targetCounts[ d ] );
+    }
+
+    pushSection( data, counts );
+
+    memcpy( header.magic, MAGIC, sizeof( header.magic ) );
+    header.byteOrder = ENDIAN_MARK;
+    header.reserved = 0;
+    header.key = m_key;
+    header.dataSize = data.size();
+
+    out.open( temporary.c_str(), std::ios::out | std::ios::binary );
+
+    if( out.fail() )
+    {
+        throw Exception( "Can't write corpus cache : " + filename );
+    }
+
+    out.write( ( const char* )&header, sizeof( header ) );
+    out.write( ( const char* )&data[ 0 ], data.size() * sizeof( uint64_t ) );
+    out.close();
+
+    if( out.fail() || rename( temporary.c_str(), filename.c_str() ) != 0 )
+    {
+        remove( temporary.c_str() );
+        throw Exception( "Can't write corpus cache : " + filename );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void CorpusCache::addBytes( const char* data, const size_t size )
+{
+    for( size_t i = 0; i < size; i++ )
+    {
+        m_key = ( m_key ^ ( unsigned char )data[ i ] ) * FNV_PRIME;
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void CorpusCache::pushSection( std::vector< uint64_t >& data, 
+                               const std::vector< uint64_t >& section )
+{
+    data.push_back( section.size() );
+    data.insert( data.end(), section.begin(), section.end() );
+}
+
+// ------------------------------------------------------------------------ //
+bool CorpusCache::nextSection( Reader& reader, const uint64_t*& section, 
+                               uint64_t& size )
+{
+    if( reader.cursor >= reader.end )
+    {
+        return false;
+    }
+
+    size = *reader.cursor;
+    section = reader.cursor + 1;
+
+    if( size > ( uint64_t )( reader.end - section ) )
+    {
+        return false;
+    }
+
+    reader.cursor = section + size;
+
+    return true;
+}
+
+// ------------------------------------------------------------------------ //
+void CorpusCache::writeText( std::vector< uint64_t >& data, const Text& text,
+                             std::map< const WordInfo*, uint64_t >& indices )
+{
+    std::vector< uint64_t > pool;
+    std::vector< uint64_t > words;
+    std::vector< uint64_t > section;
+    TextDictionary::const_iterator iter;
+    uint64_t indice = 0;
+
+    // Le vocabulaire, dans l'ordre du dictionnaire
+    for( iter = text.m_dictionary.begin(); 
+         iter != text.m_dictionary.end(); iter++ )
+    {
+        indices[ &iter -> second ] = indice++;
+        words.push_back( pool.size() );
+        words.push_back( iter -> first.size() );
+        words.push_back( iter -> second.getFrequency() );
+        pool.insert( pool.end(), iter -> first.begin(), iter -> first.end() );
+    }
+
+    pushSection( data, pool );
+    pushSection( data, words );
+
+    // Les mots du texte
+    for( size_t w = 0; w < text.m_words.size(); w++ )
+    {
+        section.push_back( indices[ text.m_words[ w ] ] );
+    }
+
+    pushSection( data, section );
+
+    section.assign( text.m_sentences.begin(), text.m_sentences.end() );
+    pushSection( data, section );
+    section.assign( text.m_sentencesLength.begin(), 
+                    text.m_sentencesLength.end() );
+    pushSection( data, section );
+
+    // Les identificateurs des phrases
+    pool.clear();
+    section.clear();
+
+    for( size_t s = 0; s < text.m_sentencesID.size(); s++ )
+    {
+        section.push_back( pool.size() );
+        section.push_back( text.m_sentencesID[ s ].size() );
+        pool.insert( pool.end(), text.m_sentencesID[ s ].begin(), 
+                     text.m_sentencesID[ s ].end() );
+    }
+
+    pushSection( data, pool );
+    pushSection( data, section );
+
+    section.assign( text.m_paragraphs.begin(), text.m_paragraphs.end() );
+    pushSection( data, section );
+    section.assign( text.m_divisions.begin(), text.m_divisions.end() );
+    pushSection( data, section );
+}
+
+// ------------------------------------------------------------------------ //
+bool CorpusCache::readText( Reader& reader, Text& text, 
+                            std::vector< WordInfo* >& words )
+{
+    const uint64_t* pool;
+    const uint64_t* section;
+    uint64_t poolSize;
+    uint64_t size;
+    wstring word;
+
+    // Le vocabulaire
+    if( !nextSection( reader, pool, poolSize ) || 
+        !nextSection( reader, section, size ) || size % 3 != 0 )
+    {
+        return false;
+    }
+
+    for( uint64_t w = 0; w < size; w += 3 )
+    {
+        if( section[ w ] + section[ w + 1 ] > poolSize )
+        {
+            return false;
+        }
+
+        word.assign( pool + section[ w ], pool + section[ w ] + 
+                                          section[ w + 1 ] );
+        words.push_back( &text.m_dictionary.insert( word, 
+                WordInfo( word, section[ w + 2 ] ) ) );
+    }
+
+    // Les mots du texte
+    if( !nextSection( reader, section, size ) )
+    {
+        return false;
+    }
+
+    for( uint64_t w = 0; w < size; w++ )
+    {
+        if( section[ w ] >= words.size() )
+        {
+            return false;
+        }
+
+        text.m_words.push_back( words[ section[ w ] ] );
+    }
+
+    // Les phrases
+    if( !nextSection( reader, section, size ) )
+    {
+        return false;
+    }
+
+    text.m_sentences.assign( section, section + size );
+
+    if( !nextSection( reader, section, size ) || 
+        size != text.m_sentences.size() )
+    {
+        return false;
+    }
+
+    text.m_sentencesLength.assign( section, section + size );
+
+    if( !nextSection( reader, pool, poolSize ) || 
+        !nextSection( reader, section, size ) || 
+        size != 2 * text.m_sentences.size() )
+    {
+        return false;
+    }
+
+    for( uint64_t s = 0; s < size; s += 2 )
+    {
+        if( section[ s ] + section[ s + 1 ] > poolSize )
+        {
+            return false;
+        }
+
+        text.m_sentencesID.push_back( wstring( pool + section[ s ], 
+                pool + section[ s ] + section[ s + 1 ] ) );
+    }
+
+    // Les paragraphes et les divisions
+    if( !nextSection( reader, section, size ) )
+    {
+        return false;
+    }
+
+    text.m_paragraphs.assign( section, section + size );
+
+    if( !nextSection( reader, section, size ) )
+    {
+        return false;
+    }
+
+    text.m_divisions.assign( section, section + size );
+
+    return true;
+}
+
+}// namespace japa
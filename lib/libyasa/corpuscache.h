@@ -0,0 +1,396 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_CORPUS_CACHE_H
+#define JAPA_CORPUS_CACHE_H
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "text.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Un cache persistant des textes d�j� analys�s et de leurs cognates.
+ *
+ * La cl� du cache est une empreinte du contenu des fichiers d'entr�e et des
+ * options qui influencent l'analyse et la recherche des cognates.  Le fichier
+ * du cache est projet� en m�moire (<code>mmap</code>) et contient, apr�s
+ * l'en-t�te, une suite de sections d'entiers de 64 bits, chacune pr�c�d�e de
+ * sa taille :
+ * <TABLE>
+ * <TR><TD>Pour chaque texte</TD><TD>Points de code du vocabulaire ; mots
+ *         ( d�but, longueur, fr�quence ) ; mots du texte ; d�buts et
+ *         longueurs des phrases ; points de code et bornes des
+ *         identificateurs ; paragraphes ; divisions</TD></TR>
+ * <TR><TD>Synonymes</TD><TD>Premier synonyme de chaque mot source ; mots
+ *         cibles synonymes</TD></TR>
+ * <TR><TD>Documents</TD><TD>Nombres de phrases sources et cibles de chaque
+ *         paire</TD></TR>
+ * </TABLE>
+ * \endfrench
+ *
+ * \english
+ * A persistent cache of the already parsed texts and of their cognates.
+ *
+ * The cache's key is a hash of the input files' content and of the options
+ * affecting the parsing and the cognate search.  The cache file is mapped in
+ * memory (<code>mmap</code>) and holds, after the header, a sequence of
+ * sections of 64 bits integers, each preceded by its size :
+ * <TABLE>
+ * <TR><TD>For each text</TD><TD>Vocabulary code points ; words ( begin,
+ *         length, frequency ) ; text words ; sentences' begin and length ;
+ *         IDs' code points and bounds ; paragraphs ; divisions</TD></TR>
+ * <TR><TD>Synonyms</TD><TD>First synonym of each source word ; synonym
+ *         target words</TD></TR>
+ * <TR><TD>Documents</TD><TD>Number of source and target sentences of each
+ *         pair</TD></TR>
+ * </TABLE>
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class CorpusCache
+{
+public :
+    /**
+     * \french
+     * La signature d'un fichier de cache.
+     * \endfrench
+     *
+     * \english
+     * A cache file's signature.
+     * \endenglish
+     */
+    static const char MAGIC[ 8 ];
+
+    /**
+     * \french
+     * La valeur qui permet de v�rifier l'ordre des octets du fichier.
+     * \endfrench
+     *
+     * \english
+     * The value used to check the file's byte order.
+     * \endenglish
+     */
+    static const uint32_t ENDIAN_MARK = 0x01020304;
+
+    /**
+     * \french
+     * L'en-t�te d'un fichier de cache.
+     * \endfrench
+     *
+     * \english
+     * A cache file's header.
+     * \endenglish
+     */
+    struct Header
+    {
+        char magic[ 8 ];        /**< Signature */
+        uint32_t byteOrder;     /**< ENDIAN_MARK as written */
+        uint32_t reserved;      /**< Padding, always 0 */
+        uint64_t key;           /**< The cache's key */
+        uint64_t dataSize;      /**< Number of integers after the header */
+    };
+
+    /**
+     * \french
+     * Constructeur.  L'empreinte est vide.
+     * \endfrench
+     *
+     * \english
+     * Constructor.  The hash is empty.
+     * \endenglish
+     */
+    CorpusCache();
+
+    /**
+     * \french
+     * Destructeur.
+     * \endfrench
+     *
+     * \english
+     * Destructor.
+     * \endenglish
+     */
+    virtual ~CorpusCache();
+
+    /**
+     * \french
+     * Ajoute le contenu d'un fichier � l'empreinte.
+     *
+     * @param filename Le nom du fichier.
+     *
+     * @throw Exception Si le fichier ne peut �tre lu.
+     * \endfrench
+     *
+     * \english
+     * Adds a file's content to the hash.
+     *
+     * @param filename The file's name.
+     *
+     * @throw Exception If the file can't be read.
+     * \endenglish
+     */
+    void addFile( const std::string& filename );
+
+    /**
+     * \french
+     * Ajoute la valeur d'une option � l'empreinte.
+     *
+     * @param value La valeur.
+     * \endfrench
+     *
+     * \english
+     * Adds an option's value to the hash.
+     *
+     * @param value The value.
+     * \endenglish
+     */
+    void addOption( const std::string& value );
+
+    /**
+     * \french
+     * Retourne le nom du fichier de cache correspondant � l'empreinte.
+     *
+     * @param directory Le r�pertoire du cache.
+     *
+     * @return Le nom du fichier.
+     * \endfrench
+     *
+     * \english
+     * Returns the name of the cache file matching the hash.
+     *
+     * @param directory The cache's directory.
+     *
+     * @return The file's name.
+     * \endenglish
+     */
+    std::string getFilename( const std::string& directory ) const;
+
+    /**
+     * \french
+     * Charge les textes d'un fichier de cache.  Un fichier absent,
+     * incomplet ou d'une autre empreinte est ignor�.
+     *
+     * @param filename Le nom du fichier.
+     * @param source Le texte source, vide, � remplir.
+     * @param target Le texte cible, vide, � remplir.
+     * @param sourceCounts Re�oit le nombre de phrases sources de chaque
+     *        paire de documents.
+     * @param targetCounts Re�oit le nombre de phrases cibles de chaque paire
+     *        de documents.
+     *
+     * @return <code>true</code> si les textes ont �t� charg�s.
+     * \endfrench
+     *
+     * \english
+     * Loads the texts from a cache file.  A missing or truncated file, or
+     * one of another hash, is ignored.
+     *
+     * @param filename The file's name.
+     * @param source The empty source text to fill.
+     * @param target The empty target text to fill.
+     * @param sourceCounts Receives the number of source sentences of each
+     *        document pair.
+     * @param targetCounts Receives the number of target sentences of each
+     *        document pair.
+     *
+     * @return <code>true</code> if the texts were loaded.
+     * \endenglish
+     */
+    bool load( const std::string& filename, Text& source, Text& target,
+               std::vector< size_t >& sourceCounts,
+               std::vector< size_t >& targetCounts ) const;
+
+    /**
+     * \french
+     * Enregistre les textes dans un fichier de cache.  Le fichier est �crit
+     * sous un nom temporaire puis renomm�, de sorte que deux ex�cutions
+     * simultan�es ne lisent jamais un cache incomplet.
+     *
+     * @param filename Le nom du fichier.
+     * @param source Le texte source.
+     * @param target Le texte cible.
+     * @param sourceCounts Le nombre de phrases sources de chaque paire de
+     *        documents.
+     * @param targetCounts Le nombre de phrases cibles de chaque paire de
+     *        documents.
+     *
+     * @throw Exception Si le fichier ne peut �tre �crit.
+     * \endfrench
+     *
+     * \english
+     * Saves the texts to a cache file.  The file is written under a
+     * temporary name and then renamed, so two simultaneous runs never read
+     * an incomplete cache.
+     *
+     * @param filename The file's name.
+     * @param source The source text.
+     * @param target The target text.
+     * @param sourceCounts The number of source sentences of each document
+     *        pair.
+     * @param targetCounts The number of target sentences of each document
+     *        pair.
+     *
+     * @throw Exception If the file can't be written.
+     * \endenglish
+     */
+    void save( const std::string& filename, const Text& source, 
+               const Text& target, const std::vector< size_t >& sourceCounts,
+               const std::vector< size_t >& targetCounts ) const;
+
+private :
+    /**
+     * \french
+     * Les sections lues d'un fichier de cache.
+     * \endfrench
+     *
+     * \english
+     * The sections read from a cache file.
+     * \endenglish
+     */
+    struct Reader
+    {
+        const uint64_t* cursor;     /**< La prochaine section */
+        const uint64_t* end;        /**< La fin des donn�es */
+    };
+
+    /**
+     * \french
+     * Ajoute des octets � l'empreinte.
+     *
+     * @param data Les octets.
+     * @param size Le nombre d'octets.
+     * \endfrench
+     *
+     * \english
+     * Adds bytes to the hash.
+     *
+     * @param data The bytes.
+     * @param size The number of bytes.
+     * \endenglish
+     */
+    void addBytes( const char* data, const size_t size );
+
+    /**
+     * \french
+     * Ajoute une section aux donn�es d'un fichier.
+     *
+     * @param data Les donn�es du fichier.
+     * @param section La section.
+     * \endfrench
+     *
+     * \english
+     * Appends a section to a file's data.
+     *
+     * @param data The file's data.
+     * @param section The section.
+     * \endenglish
+     */
+    static void pushSection( std::vector< uint64_t >& data, 
+                             const std::vector< uint64_t >& section );
+
+    /**
+     * \french
+     * Lit la prochaine section.
+     *
+     * @param reader Les sections � lire.
+     * @param section Re�oit le d�but de la section.
+     * @param size Re�oit la taille de la section.
+     *
+     * @return <code>false</code> si les donn�es sont tronqu�es.
+     * \endfrench
+     *
+     * \english
+     * Reads the next section.
+     *
+     * @param reader The sections to read.
+     * @param section Receives the section's beginning.
+     * @param size Receives the section's size.
+     *
+     * @return <code>false</code> if the data is truncated.
+     * \endenglish
+     */
+    static bool nextSection( Reader& reader, const uint64_t*& section, 
+                             uint64_t& size );
+
+    /**
+     * \french
+     * Ajoute les sections d'un texte aux donn�es d'un fichier.
+     *
+     * @param data Les donn�es du fichier.
+     * @param text Le texte.
+     * @param indices Re�oit l'indice de chaque mot du vocabulaire.
+     * \endfrench
+     *
+     * \english
+     * Appends a text's sections to a file's data.
+     *
+     * @param data The file's data.
+     * @param text The text.
+     * @param indices Receives the subscript of each vocabulary word.
+     * \endenglish
+     */
+    static void writeText( std::vector< uint64_t >& data, const Text& text,
+                           std::map< const WordInfo*, uint64_t >& indices );
+
+    /**
+     * \french
+     * Lit les sections d'un texte.
+     *
+     * @param reader Les sections � lire.
+     * @param text Le texte, vide, � remplir.
+     * @param words Re�oit le mot du vocabulaire de chaque indice.
+     *
+     * @return <code>false</code> si les sections sont invalides.
+     * \endfrench
+     *
+     * \english
+     * Reads a text's sections.
+     *
+     * @param reader The sections to read.
+     * @param text The empty text to fill.
+     * @param words Receives the vocabulary word of each subscript.
+     *
+     * @return <code>false</code> if the sections are invalid.
+     * \endenglish
+     */
+    static bool readText( Reader& reader, Text& text, 
+                          std::vector< WordInfo* >& words );
+
+    /**
+     * \french
+     * L'empreinte courante ( FNV-1a sur 64 bits ).
+     * \endfrench
+     *
+     * \english
+     * The current hash ( 64 bits FNV-1a ).
+     * \endenglish
+     */
+    uint64_t m_key;
+};
+
+}// namespace japa
+
+#endif
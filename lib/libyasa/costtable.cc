@@ -0,0 +1,193 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <cstddef>
+
+#include "costtable.h"
+
+namespace japa
+{
+
+// ------------------------------------------------------------------------ //
+CostTable::CostTable() : m_firstColumn( 0 ), m_costCount( 0 )
+{}
+
+// ------------------------------------------------------------------------ //
+void CostTable::init( const SearchSpace& space, const size_t costCount )
+{
+    size_t size;
+
+    clear();
+    m_costCount = costCount;
+    size = layout( space, m_columns, m_firstColumn );
+
+    m_costs.assign( size * m_costCount, 0 );
+}
+
+// ------------------------------------------------------------------------ //
+size_t CostTable::estimateMemory( const SearchSpace& space,
+                                  const size_t costCount )
+{
+    std::vector< Column > columns;
+    int firstColumn;
+    size_t size = layout( space, columns, firstColumn );
+
+    return size * costCount * sizeof( double ) +
+           columns.size() * sizeof( Column );
+}
+
+// ------------------------------------------------------------------------ //
+size_t CostTable::layout( const SearchSpace& space,
+                          std::vector< Column >& columns, int& firstColumn )
+{
+    Column empty;
+    size_t offset = 0;
+    bool first = true;
+    int lastColumn = 0;
+
+    columns.clear();
+    firstColumn = 0;
+
+    // Une colonne vide a une derni�re rang�e inf�rieure � sa premi�re
+    empty.low = 0;
+    empty.high = -1;
+    empty.offset = 0;
+
+    SearchSpace::Iterator iter = space.getIterator();
+
+    // Rep�re les bornes des colonnes
+    while( iter.hasNext() )
+    {
+        iter.next();
+
+        if( iter.x() < 0 || iter.y() < 0 )
+        {
+            continue;
+        }
+
+        if( first )
+        {
+            firstColumn = lastColumn = iter.x();
+            first = false;
+        }
+
+        // Les colonnes peuvent �tre parcourues dans n'importe quel ordre
+        if( iter.x() < firstColumn )
+        {
+            columns.insert( columns.begin(), firstColumn - iter.x(), empty );
+            firstColumn = iter.x();
+        }
+        else if( iter.x() > lastColumn )
+        {
+            lastColumn = iter.x();
+        }
+
+        if( columns.size() < ( size_t )( lastColumn - firstColumn + 1 ) )
+        {
+            columns.resize( lastColumn - firstColumn + 1, empty );
+        }
+
+        Column& column = columns[ iter.x() - firstColumn ];
+
+        if( column.high < column.low )
+        {
+            column.low = column.high = iter.y();
+        }
+        else if( iter.y() < column.low )
+        {
+            column.low = iter.y();
+        }
+        else if( iter.y() > column.high )
+        {
+            column.high = iter.y();
+        }
+    }
+
+    // Place les colonnes les unes � la suite des autres
+    for( size_t c = 0; c < columns.size(); c++ )
+    {
+        columns[ c ].offset = offset;
+
+        if( columns[ c ].high >= columns[ c ].low )
+        {
+            offset += columns[ c ].high - columns[ c ].low + 1;
+        }
+    }
+
+    return offset;
+}
+
+// ------------------------------------------------------------------------ //
+void CostTable::clear()
+{
+    m_firstColumn = 0;
+    m_costCount = 0;
+    m_columns.clear();
+    m_costs.clear();
+}
+
+// ------------------------------------------------------------------------ //
+bool CostTable::isEmpty() const
+{
+    return m_costs.empty();
+}
+
+// ------------------------------------------------------------------------ //
+size_t CostTable::getCostCount() const
+{
+    return m_costCount;
+}
+
+// ------------------------------------------------------------------------ //
+double* CostTable::find( const int i, const int j )
+{
+    size_t position;
+
+    return locate( i, j, position ) ? &m_costs[ position ] : NULL;
+}
+
+// ------------------------------------------------------------------------ //
+const double* CostTable::find( const int i, const int j ) const
+{
+    size_t position;
+
+    return locate( i, j, position ) ? &m_costs[ position ] : NULL;
+}
+
+// ------------------------------------------------------------------------ //
+bool CostTable::locate( const int i, const int j, size_t& position ) const
+{
+    if( m_costs.empty() || i < m_firstColumn ||
+        i - m_firstColumn >= ( int )m_columns.size() )
+    {
+        return false;
+    }
+
+    const Column& column = m_columns[ i - m_firstColumn ];
+
+    if( j < column.low || j > column.high )
+    {
+        return false;
+    }
+
+    position = ( column.offset + ( j - column.low ) ) * m_costCount;
+
+    return true;
+}
+
+}// namespace japa
@@ -0,0 +1,305 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_COST_TABLE_H
+#define JAPA_COST_TABLE_H
+
+#include <vector>
+
+#include "searchspace.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Un tableau dense des co�ts de transition d'un espace de recherche.
+ *
+ * Pour chaque colonne de l'espace de recherche, les rang�es comprises entre
+ * la plus petite et la plus grande case de la colonne sont stock�es de fa�on
+ * contigu�, chaque case contenant un co�t par alignement possible.  Seules les
+ * cases d'indices positifs sont repr�sent�es.
+ * \endfrench
+ *
+ * \english
+ * A dense array of the transition costs of a search space.
+ *
+ * For each column of the search space, the rows between the lowest and the
+ * highest cell of the column are stored contiguously, each cell holding one
+ * cost per possible alignment.  Only the cells with positive indices are
+ * represented.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class CostTable
+{
+public :
+    /**
+     * \french
+     * Constructeur.  Le tableau est vide.
+     * \endfrench
+     *
+     * \english
+     * Constructor.  The table is empty.
+     * \endenglish
+     */
+    CostTable();
+
+    /**
+     * \french
+     * Dimensionne le tableau selon les cases d'un espace de recherche.  Les
+     * co�ts sont mis � z�ro.
+     *
+     * @param space L'espace de recherche.
+     * @param costCount Le nombre de co�ts par case.
+     * \endfrench
+     *
+     * \english
+     * Sizes the table after the cells of a search space.  The costs are set
+     * to zero.
+     *
+     * @param space The search space.
+     * @param costCount The number of costs per cell.
+     * \endenglish
+     */
+    void init( const SearchSpace& space, const size_t costCount );
+
+    /**
+     * \french
+     * Vide le tableau.
+     * \endfrench
+     *
+     * \english
+     * Empties the table.
+     * \endenglish
+     */
+    void clear();
+
+    /**
+     * \french
+     * V�rifie si le tableau est vide.
+     *
+     * @return <code>true</code> si le tableau ne contient aucun co�t.
+     * \endfrench
+     *
+     * \english
+     * Checks if the table is empty.
+     *
+     * @return <code>true</code> if the table holds no cost.
+     * \endenglish
+     */
+    bool isEmpty() const;
+
+    /**
+     * \french
+     * Retourne le nombre de co�ts par case.
+     *
+     * @return Le nombre de co�ts par case.
+     * \endfrench
+     *
+     * \english
+     * Returns the number of costs per cell.
+     *
+     * @return The number of costs per cell.
+     * \endenglish
+     */
+    size_t getCostCount() const;
+
+    /**
+     * \french
+     * Retourne les co�ts d'une case.
+     *
+     * @param i La colonne de la case.
+     * @param j La rang�e de la case.
+     *
+     * @return Les co�ts de la case, <code>NULL</code> si elle n'est pas
+     *         stock�e.
+     * \endfrench
+     *
+     * \english
+     * Returns a cell's costs.
+     *
+     * @param i The cell's column.
+     * @param j The cell's row.
+     *
+     * @return The cell's costs, <code>NULL</code> if it is not stored.
+     * \endenglish
+     */
+    double* find( const int i, const int j );
+
+    /**
+     * \french
+     * Retourne les co�ts d'une case.
+     *
+     * @param i La colonne de la case.
+     * @param j La rang�e de la case.
+     *
+     * @return Les co�ts de la case, <code>NULL</code> si elle n'est pas
+     *         stock�e.
+     * \endfrench
+     *
+     * \english
+     * Returns a cell's costs.
+     *
+     * @param i The cell's column.
+     * @param j The cell's row.
+     *
+     * @return The cell's costs, <code>NULL</code> if it is not stored.
+     * \endenglish
+     */
+    const double* find( const int i, const int j ) const;
+
+    /**
+     * \french
+     * Estime la m�moire qu'occuperait le tableau pour un espace de
+     * recherche, sans le dimensionner.
+     *
+     * @param space L'espace de recherche.
+     * @param costCount Le nombre de co�ts par case.
+     *
+     * @return Le nombre d'octets.
+     * \endfrench
+     *
+     * \english
+     * Estimates the memory the table would take for a search space, without
+     * sizing it.
+     *
+     * @param space The search space.
+     * @param costCount The number of costs per cell.
+     *
+     * @return The number of bytes.
+     * \endenglish
+     */
+    static size_t estimateMemory( const SearchSpace& space,
+                                  const size_t costCount );
+
+private :
+    /**
+     * \french
+     * Les rang�es stock�es d'une colonne.
+     * \endfrench
+     *
+     * \english
+     * The stored rows of a column.
+     * \endenglish
+     */
+    struct Column
+    {
+        int low;        /**< Premi�re rang�e */
+        int high;       /**< Derni�re rang�e */
+        size_t offset;  /**< Indice de la premi�re case dans le tableau */
+    };
+
+    /**
+     * \french
+     * Rep�re les bornes des colonnes d'un espace de recherche et les place
+     * les unes � la suite des autres.
+     *
+     * @param space L'espace de recherche.
+     * @param columns Re�oit les colonnes.
+     * @param firstColumn Re�oit la colonne de la premi�re colonne.
+     *
+     * @return Le nombre de cases stock�es.
+     * \endfrench
+     *
+     * \english
+     * Finds the bounds of a search space's columns and places them one after
+     * the other.
+     *
+     * @param space The search space.
+     * @param columns Receives the columns.
+     * @param firstColumn Receives the search space column of the first one.
+     *
+     * @return The number of stored cells.
+     * \endenglish
+     */
+    static size_t layout( const SearchSpace& space,
+                          std::vector< Column >& columns, int& firstColumn );
+
+    /**
+     * \french
+     * Retourne la position des co�ts d'une case dans le tableau.
+     *
+     * @param i La colonne de la case.
+     * @param j La rang�e de la case.
+     * @param position Re�oit la position du premier co�t de la case.
+     *
+     * @return <code>false</code> si la case n'est pas stock�e.
+     * \endfrench
+     *
+     * \english
+     * Returns the position of a cell's costs in the table.
+     *
+     * @param i The cell's column.
+     * @param j The cell's row.
+     * @param position Receives the position of the cell's first cost.
+     *
+     * @return <code>false</code> if the cell is not stored.
+     * \endenglish
+     */
+    bool locate( const int i, const int j, size_t& position ) const;
+
+    /**
+     * \french
+     * La colonne de l'espace de recherche de la premi�re colonne.
+     * \endfrench
+     *
+     * \english
+     * The search space column of the first column.
+     * \endenglish
+     */
+    int m_firstColumn;
+
+    /**
+     * \french
+     * Le nombre de co�ts par case.
+     * \endfrench
+     *
+     * \english
+     * The number of costs per cell.
+     * \endenglish
+     */
+    size_t m_costCount;
+
+    /**
+     * \french
+     * Les rang�es stock�es de chaque colonne.
+     * \endfrench
+     *
+     * \english
+     * The stored rows of each column.
+     * \endenglish
+     */
+    std::vector< Column > m_columns;
+
+    /**
+     * \french
+     * Les co�ts, case par case.
+     * \endfrench
+     *
+     * \english
+     * The costs, cell by cell.
+     * \endenglish
+     */
+    std::vector< double > m_costs;
+};
+
+}// namespace japa
+
+#endif
@@ -19,8 +19,11 @@ limitations under the License.
 #ifndef JAPA_DYNAMIC_TABLE_H
 #define JAPA_DYNAMIC_TABLE_H
 
+#include <cstddef>
 #include <memory>
 
+#include "progress.h"
+
 
 
 namespace japa
@@ -55,6 +58,17 @@ template< class T >
 class DynamicTable
 {
 public :
+    /**
+     * \french
+     * Destructeur.
+     * \endfrench
+     *
+     * \english
+     * Destructor.
+     * \endenglish
+     */
+    virtual ~DynamicTable() {}
+
     /**
      * \french
      * R�soud un probl�me par programmation dynamique.
@@ -92,6 +106,102 @@ public :
      * \endenglish
      */
     virtual bool getScore( const int i, const int j, T& score ) const = 0;
+
+    /**
+     * \french
+     * Fixe la marge d'�lagage par anti-diagonale.
+     *
+     * @param margin La marge, une marge nulle d�sactivant l'�lagage.
+     * \endfrench
+     *
+     * \english
+     * Sets the anti-diagonal pruning margin.
+     *
+     * @param margin The margin, a null margin disabling the pruning.
+     * \endenglish
+     */
+    virtual void setPruningMargin( const T margin ) = 0;
+
+    /**
+     * \french
+     * Retourne la marge d'�lagage par anti-diagonale.
+     *
+     * @return La marge d'�lagage.
+     * \endfrench
+     *
+     * \english
+     * Returns the anti-diagonal pruning margin.
+     *
+     * @return The pruning margin.
+     * \endenglish
+     */
+    virtual T getPruningMargin() const = 0;
+
+    /**
+     * \french
+     * Retourne le nombre de cases �cart�es lors de la derni�re r�solution.
+     *
+     * @return Le nombre de cases �lagu�es.
+     * \endfrench
+     *
+     * \english
+     * Returns the number of cells dropped by the last solve.
+     *
+     * @return The number of pruned cells.
+     * \endenglish
+     */
+    virtual size_t getPrunedCount() const = 0;
+
+    /**
+     * \french
+     * Indique si la derni�re r�solution a dû �tre refaite sans �lagage.
+     *
+     * @return <code>true</code> si l'�lagage a �t� abandonn�.
+     * \endfrench
+     *
+     * \english
+     * Tells if the last solve had to be done again without pruning.
+     *
+     * @return <code>true</code> if the pruning was given up.
+     * \endenglish
+     */
+    virtual bool hasFallenBack() const = 0;
+
+    /**
+     * \french
+     * Estime la m�moire qu'occuperait la r�solution de la table, avant de la
+     * r�soudre.
+     *
+     * @return Le nombre d'octets.
+     * \endfrench
+     *
+     * \english
+     * Estimates the memory solving the table would take, before solving it.
+     *
+     * @return The number of bytes.
+     * \endenglish
+     */
+    virtual size_t estimateMemory() const = 0;
+
+    /**
+     * \french
+     * Fixe le rapport d'avancement, avanc� d'une unit� par case calcul�e.
+     *
+     * @note Seule l'adresse est conserv�e.
+     *
+     * @param progress Le rapport d'avancement, <code>NULL</code> pour n'en
+     *                 donner aucun.
+     * \endfrench
+     *
+     * \english
+     * Sets the progress report, advanced by one unit per computed cell.
+     *
+     * @note Only the address is kept.
+     *
+     * @param progress The progress report, <code>NULL</code> to give none.
+     * \endenglish
+     */
+    virtual void setProgress( Progress* progress ) = 0;
     
     /**
      * \french
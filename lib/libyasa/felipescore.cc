@@ -16,8 +16,9 @@ limitations under the License.
 
 */  
 
-#include <list>
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "felipescore.h"
 
@@ -43,6 +44,159 @@ void FelipeScore::init()
     setCorrection( DEFAULT_CORRECTION );
 }
 
+// ------------------------------------------------------------------------ //
+double FelipeScore::operator()( const DynamicTable< double >& dt,
+                                const int i, const int j,
+                                int& pi, int& pj )
+{
+    // Nombre d'alignements possibles que le tableau local peut contenir
+    static const size_t MAX_CANDIDATES = 16;
+    // Valeur trs grande, comme dans ChurchGaleScore
+    static const double INCREDIBLY_BIG_DOUBLE = 1.0E30;
+    // Marge relative qui absorbe les erreurs d'arrondi des bornes
+    static const double BOUND_SLACK = 1.0E-9;
+
+    /** Un alignement possible dont le dcompte des cognates est diffr. */
+    struct Candidate
+    {
+        size_t lengthSource;    /**< Nombre de phrases sources */
+        size_t lengthTarget;    /**< Nombre de phrases cibles */
+        size_t words;           /**< Nombre moyen de mots */
+        size_t maxCognates;     /**< Nombre maximum de cognates */
+        double previous;        /**< Score de la case prcdente */
+        double churchGale;      /**< Score de Church and Gale */
+        double bound;           /**< Borne infrieure du score */
+        bool done;              /**< Vrai si dj valu */
+    };
+
+    // Les premires cases et les configurations inhabituelles sont traites
+    // par l'algorithme gnral, tout comme le cas o les cots ont t
+    // calculs d'avance et rendent la borne inutile.
+    if( i < 0 || j < 0 || getAlignmentCount() > MAX_CANDIDATES || 
+        hasCosts() )
+    {
+        return ChurchGaleScore::operator()( dt, i, j, pi, pj );
+    }
+
+    if( m_sourceCognateBounds.size() != m_source.getSentenceCount() ||
+        m_targetCognateBounds.size() != m_target.getSentenceCount() )
+    {
+        initCognateBounds();
+    }
+
+    Candidate candidates[ MAX_CANDIDATES ];
+    size_t count = 0;
+    double penalty;
+    double low;
+    double high;
+    
+    // Calcule d'abord les parties peu coteuses et la borne de chaque
+    // alignement
+    for( size_t k = 0; k < getAlignmentCount(); k++ )
+    {
+        Candidate& c = candidates[ count ];
+
+        getAlignment( k, c.lengthSource, c.lengthTarget, penalty );
+
+        if( !isAllowed( i, j, c.lengthSource, c.lengthTarget ) ||
+            !dt.getScore( i - c.lengthSource, j - c.lengthTarget, 
+                          c.previous ) )
+        {
+            continue;
+        }
+
+        size_t srcWords = countWords( m_source, i, c.lengthSource );
+        size_t tgtWords = countWords( m_target, j, c.lengthTarget );
+
+        c.words = ( srcWords + tgtWords ) / 2;
+        c.maxCognates = ( srcWords < tgtWords ) ? srcWords : tgtWords;
+
+        // Seuls les mots susceptibles de former un cognate comptent
+        srcWords = sumCounts( m_sourceCognateBounds, i, c.lengthSource );
+        tgtWords = sumCounts( m_targetCognateBounds, j, c.lengthTarget );
+        c.maxCognates = std::min( c.maxCognates, 
+                                  std::min( srcWords, tgtWords ) );
+        c.churchGale = ChurchGaleScore::computeScore( i, j, c.lengthSource, 
+                                                      c.lengthTarget, 
+                                                      penalty );
+
+        // Le score est affine en nombre de cognates : ses extrmes sont aux
+        // bornes de l'intervalle.
+        low = combine( c.churchGale, simardScore( c.words, 0 ), 
+                       c.lengthSource, c.lengthTarget );
+        high = combine( c.churchGale, simardScore( c.words, c.maxCognates ),
+                        c.lengthSource, c.lengthTarget );
+
+        c.bound = c.previous + ( ( low < high ) ? low : high );
+        
+        if( c.maxCognates != 0 )
+        {
+            c.bound -= BOUND_SLACK * ( fabs( c.bound ) + 1 + c.words * 
+                                       ( fabs( m_r1 ) + fabs( m_r2 ) ) );
+        }
+
+        c.done = false;
+        count++;
+    }
+
+    double score;
+    double minScore = INCREDIBLY_BIG_DOUBLE;
+    size_t best = count;
+    size_t next;
+
+    // value les alignements par borne croissante.   score gal, le premier
+    // alignement l'emporte, comme dans ChurchGaleScore.
+    for( ;; )
+    {
+        next = count;
+
+        for( size_t n = 0; n < count; n++ )
+        {
+            if( !candidates[ n ].done && 
+                ( next == count || 
+                  candidates[ n ].bound < candidates[ next ].bound ) )
+            {
+                next = n;
+            }
+        }
+
+        // Les candidats restants ne peuvent battre le meilleur
+        if( next == count || candidates[ next ].bound > minScore ||
+            ( candidates[ next ].bound == minScore && next > best ) )
+        {
+            break;
+        }
+
+        Candidate& c = candidates[ next ];
+        size_t cognates = 0;
+
+        c.done = true;
+
+        if( c.maxCognates != 0 )
+        {
+            cognates = countCognate( i, j, c.lengthSource, c.lengthTarget );
+        }
+
+        score = c.previous + combine( c.churchGale, 
+                                      simardScore( c.words, cognates ),
+                                      c.lengthSource, c.lengthTarget );
+
+        if( score < minScore || ( score == minScore && next < best ) )
+        {
+            minScore = score;
+            best = next;
+        }
+    }
+
+    if( best != count )
+    {
+        pi = i - candidates[ best ].lengthSource;
+        pj = j - candidates[ best ].lengthTarget;
+    }
+
+    return minScore;
+}
+
 // ------------------------------------------------------------------------ //
 double FelipeScore::computeScore( const size_t sentSource, 
                                   const size_t sentTarget, 
@@ -60,6 +214,14 @@ double FelipeScore::computeScore( const size_t sentSource,
                                                      lengthSource, lengthTarget,
                                                      penalty );
  
+    return combine( churchGaleScore, simardScore, lengthSource, lengthTarget );
+}
+
+// ------------------------------------------------------------------------ //
+double FelipeScore::combine( double churchGaleScore, double simardScore,
+                             const size_t lengthSource,
+                             const size_t lengthTarget ) const
+{
     // Gre le mode FullFelipe
     if( lengthSource == 0 || lengthTarget == 0 )
     {
@@ -77,6 +239,9 @@ double FelipeScore::computeScore( const size_t sentSource,
             churchGaleScore /= getCorrection();
             simardScore /= getCorrection();
             break;
+
+        default :
+            break;
         }
     }
     
@@ -90,31 +255,105 @@ double FelipeScore::computeSimardScore( const size_t sentSource,
                                         const size_t lengthSource,
                                         const size_t lengthTarget ) const
 {
-    double score;
     size_t wordCount = 0;   // Le nombre moyen de mots
     size_t cognateCount = 0;// Le nombre de cognates
 
-    //  Rescence les mots de la rgion source
-    for( size_t i = 0; i < lengthSource && sentSource >= i; i ++ )
-    {
-        wordCount += m_source.getSentenceWordCount( sentSource - i );
-    }
-    
-    //  Rescence les mots de la rgion cibles
-    for( size_t i = 0; i < lengthTarget && sentTarget >= i; i ++ )
-    {
-        wordCount += m_target.getSentenceWordCount( sentTarget - i );
-    }
+    //  Rescence les mots des rgions source et cible
+    wordCount = countWords( m_source, sentSource, lengthSource ) +
+                countWords( m_target, sentTarget, lengthTarget );
 
     wordCount /= 2;
 
     cognateCount = countCognate( sentSource, sentTarget, 
                                  lengthSource, lengthTarget );
  
+    return simardScore( wordCount, cognateCount );
+}
+
+// ------------------------------------------------------------------------ //
+double FelipeScore::simardScore( const size_t wordCount,
+                                 const size_t cognateCount ) const
+{
     // Calcul du score de Simard suivant une loi binmiale   
-    score = ( cognateCount * m_r1 ) + ( ( wordCount - cognateCount ) * m_r2 );
-    
-    return score;
+    return ( cognateCount * m_r1 ) + ( ( wordCount - cognateCount ) * m_r2 );
+}
+
+// ------------------------------------------------------------------------ //
+size_t FelipeScore::countWords( const Text& text, const size_t sentence,
+                                const size_t length )
+{
+    size_t wordCount = 0;
+
+    for( size_t i = 0; i < length && sentence >= i; i ++ )
+    {
+        wordCount += text.getSentenceWordCount( sentence - i );
+    }
+
+    return wordCount;
+}
+
+// ------------------------------------------------------------------------ //
+void FelipeScore::initCognateBounds()
+{
+    std::vector< const WordInfo* > synonyms;  // Les mots cibles possibles
+    size_t begin;
+    size_t end;
+
+    m_sourceCognateBounds.assign( m_source.getSentenceCount(), 0 );
+    m_targetCognateBounds.assign( m_target.getSentenceCount(), 0 );
+
+    // Un mot source ne peut former un cognate que s'il a des synonymes
+    for( size_t s = 0; s < m_source.getSentenceCount(); s++ )
+    {
+        m_source.getSentenceBounds( s, begin, end );
+
+        for( size_t w = begin; w < end; w++ )
+        {
+            const WordInfo& word = m_source.getWord( w );
+
+            if( word.hasSynonym() )
+            {
+                m_sourceCognateBounds[ s ]++;
+                synonyms.insert( synonyms.end(), 
+                                 word.getSynonyms().begin(),
+                                 word.getSynonyms().end() );
+            }
+        }
+    }
+
+    std::sort( synonyms.begin(), synonyms.end() );
+    synonyms.erase( std::unique( synonyms.begin(), synonyms.end() ), 
+                    synonyms.end() );
+
+    // Un mot cible ne peut former un cognate que s'il est le synonyme d'un
+    // mot source
+    for( size_t s = 0; s < m_target.getSentenceCount(); s++ )
+    {
+        m_target.getSentenceBounds( s, begin, end );
+
+        for( size_t w = begin; w < end; w++ )
+        {
+            if( std::binary_search( synonyms.begin(), synonyms.end(),
+                                    &( m_target.getWord( w ) ) ) )
+            {
+                m_targetCognateBounds[ s ]++;
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------ //
+size_t FelipeScore::sumCounts( const std::vector< size_t >& counts,
+                               const size_t sentence, const size_t length )
+{
+    size_t sum = 0;
+
+    for( size_t i = 0; i < length && sentence >= i; i ++ )
+    {
+        sum += counts[ sentence - i ];
+    }
+
+    return sum;
 }
 
 // ------------------------------------------------------------------------ //
@@ -211,9 +450,8 @@ int FelipeScore::countCognate( const size_t sentSource,
     size_t beginTgt;
     size_t endTgt;
     size_t cognateCount = 0;    // Le nombre de cognates
-    std::list< WordInfo* > targetWords;   // Les mots dj pris
-    std::list< WordInfo* >::iterator iter;
-    bool found = false;    
+    std::vector< const WordInfo* > targetWords; // Les mots cibles
+    std::vector< bool > taken;  // Les mots cibles dj pris
     
     // Initialise la liste des mots cibles
     for( size_t i = 0; i < lengthTarget && sentTarget >= i; i ++ )
@@ -226,6 +464,8 @@ int FelipeScore::countCognate( const size_t sentSource,
         }
     }     
 
+    taken.resize( targetWords.size(), false );
+
     // Compte le nombre de cognates
     for( size_t i = 0; i < lengthSource && sentSource >= i; i ++ )
     {
@@ -233,21 +473,20 @@ int FelipeScore::countCognate( const size_t sentSource,
 
         for( size_t j = beginSrc; j < endSrc; j++ )
         {
-            found = false;
+            const WordInfo& word = m_source.getWord( j );
             
             // Si le mot source a des synonymes, on vrifie s'il y en a un dans
             // le bout de texte cible
-            if( m_source.getWord( j ).hasSynonym() )
+            if( word.hasSynonym() )
             {
-                for( iter = targetWords.begin(); iter != targetWords.end() && !found; 
-                     iter++ )
+                for( size_t k = 0; k < targetWords.size(); k++ )
                 {
-                    if( m_source.getWord( j ).isSynonym( *( *iter ) ) ) 
+                    if( !taken[ k ] && word.isSynonym( *targetWords[ k ] ) ) 
                     {
                         // Un cognate est trouv
-                        found = true;
                         cognateCount++;
-                        targetWords.erase( iter );
+                        taken[ k ] = true;
+                        break;
                     }
                 }
             }
@@ -19,6 +19,8 @@ limitations under the License.
 #ifndef JAPA_FELIPE_SCORE_H
 #define JAPA_FELIPE_SCORE_H
 
+#include <vector>
+
 #include "churchgalescore.h"
 #include "text.h"
 
@@ -127,6 +129,35 @@ public :
      */
     FelipeScore( const Text& src, const Text& tgt );
 
+    /**
+     * \french
+     * Calcule le score d'une case par s�paration et �valuation.
+     *
+     * Pour chaque alignement possible, la partie Church and Gale est calcul�e
+     * d'abord et le score de Simard est born� � partir du seul nombre de mots,
+     * car le nombre de cognates ne d�passe pas le nombre de mots du plus
+     * petit c�t�.  Les alignements sont ensuite �valu�s par borne croissante
+     * et le d�compte des cognates est omis pour ceux dont la borne ne peut
+     * battre le meilleur score trouv�.  Le r�sultat, y compris le choix entre
+     * des scores �gaux, est celui de <code>ChurchGaleScore</code>.
+     * \endfrench
+     *
+     * \english
+     * Computes a cell's score by branch and bound.
+     *
+     * For each possible alignment, the Church and Gale part is computed first
+     * and the Simard score is bounded from the word counts alone, since the
+     * number of cognates can't exceed the number of words of the smaller
+     * side.  The alignments are then evaluated by increasing bound and the
+     * cognate count is skipped for those whose bound can't beat the best
+     * score found.  The result, including the choice between equal scores, is
+     * the one of <code>ChurchGaleScore</code>.
+     * \endenglish
+     */
+    double operator()( const DynamicTable< double >& dt, 
+                       const int i, const int j,
+                       int& pi, int& pj );
+
     /**
      * \french
      * Retourne la poid du score Church and Gale lors du calcul du score
@@ -481,6 +512,120 @@ protected :
                       const size_t lengthSource, 
                       const size_t lengthTarget ) const;
 
+    /**
+     * \french
+     * Compte les mots d'une r�gion d'un texte.
+     *
+     * @param text Le texte.
+     * @param sentence L'indice de la derni�re phrase de la r�gion.
+     * @param length Le nombre de phrases de la r�gion.
+     *
+     * @return Le nombre de mots de la r�gion.
+     * \endfrench
+     *
+     * \english
+     * Counts the words of a text's segment.
+     *
+     * @param text The text.
+     * @param sentence The segment's last sentence's indice.
+     * @param length The number of sentences in the segment.
+     *
+     * @return The number of words in the segment.
+     * \endenglish
+     */
+    static size_t countWords( const Text& text, const size_t sentence,
+                              const size_t length );
+
+    /**
+     * \french
+     * Calcule le score de Simard � partir des d�comptes.
+     *
+     * @param wordCount Le nombre moyen de mots des deux r�gions.
+     * @param cognateCount Le nombre de cognates.
+     *
+     * @return Le score de Simard.
+     * \endfrench
+     *
+     * \english
+     * Computes the Simard's score from the counts.
+     *
+     * @param wordCount The average number of words of the two segments.
+     * @param cognateCount The number of cognates.
+     *
+     * @return The Simard's score.
+     * \endenglish
+     */
+    double simardScore( const size_t wordCount, 
+                        const size_t cognateCount ) const;
+
+    /**
+     * \french
+     * Combine les scores de Church and Gale et de Simard selon les poids et
+     * le mode FullFelipe.
+     *
+     * @param churchGaleScore Le score de Church and Gale.
+     * @param simardScore Le score de Simard.
+     * @param lengthSource Le nombre de phrases sources.
+     * @param lengthTarget Le nombre de phrases cibles.
+     *
+     * @return Le score de l'alignement.
+     * \endfrench
+     *
+     * \english
+     * Combines the Church and Gale and Simard scores according to the weights
+     * and the FullFelipe mode.
+     *
+     * @param churchGaleScore The Church and Gale score.
+     * @param simardScore The Simard score.
+     * @param lengthSource The number of source's sentences.
+     * @param lengthTarget The number of target's sentences.
+     *
+     * @return The alignment's score.
+     * \endenglish
+     */
+    double combine( double churchGaleScore, double simardScore,
+                    const size_t lengthSource, 
+                    const size_t lengthTarget ) const;
+
+    /**
+     * \french
+     * Calcule, pour chaque phrase, le nombre de mots pouvant participer �
+     * un cognate : les mots sources ayant des synonymes et les mots cibles
+     * synonymes d'un mot source.
+     * \endfrench
+     *
+     * \english
+     * Computes, for each sentence, the number of words that may take part in
+     * a cognate: the source words having synonyms and the target words that
+     * are synonyms of a source word.
+     * \endenglish
+     */
+    void initCognateBounds();
+
+    /**
+     * \french
+     * Additionne les d�comptes par phrase d'une r�gion.
+     *
+     * @param counts Les d�comptes par phrase.
+     * @param sentence L'indice de la derni�re phrase de la r�gion.
+     * @param length Le nombre de phrases de la r�gion.
+     *
+     * @return La somme des d�comptes de la r�gion.
+     * \endfrench
+     *
+     * \english
+     * Sums the per sentence counts of a segment.
+     *
+     * @param counts The per sentence counts.
+     * @param sentence The segment's last sentence's indice.
+     * @param length The number of sentences in the segment.
+     *
+     * @return The sum of the segment's counts.
+     * \endenglish
+     */
+    static size_t sumCounts( const std::vector< size_t >& counts,
+                             const size_t sentence, const size_t length );
+
 private :
     /**
      * \french
@@ -619,6 +764,28 @@ private :
      * \endenglish
      */
     double m_correction;
+
+    /** 
+     * \french
+     * Nombre de mots sources pouvant former un cognate, par phrase.
+     * \endfrench
+     *
+     * \english
+     * Number of source words that may form a cognate, per sentence.
+     * \endenglish
+     */
+    std::vector< size_t > m_sourceCognateBounds;
+
+    /** 
+     * \french
+     * Nombre de mots cibles pouvant former un cognate, par phrase.
+     * \endfrench
+     *
+     * \english
+     * Number of target words that may form a cognate, per sentence.
+     * \endenglish
+     */
+    std::vector< size_t > m_targetCognateBounds;
 };
 
 }// namespace japa
@@ -75,7 +75,7 @@ public :
      */
     FriendlyPrinter( const Text& source, const Text& target );
 
-    void operator()( std::wostream& out, const Solution& solution );
+    void operator()( Utf8Writer& out, const Solution& solution );
 
 private :
     /**
@@ -95,7 +95,7 @@ private :
      * @param indice The sentence's indice.
      * \endenglish
      */
-    void printSentence( std::wostream& out, const Text& text, const size_t indice );
+    void printSentence( Utf8Writer& out, const Text& text, const size_t indice );
 
     
     /** 
@@ -129,7 +129,7 @@ FriendlyPrinter< T >::FriendlyPrinter( const Text& source, const Text& target )
 
 // ------------------------------------------------------------------------ //
 template< class T >
-void FriendlyPrinter< T >::operator()( std::wostream& out,
+void FriendlyPrinter< T >::operator()( Utf8Writer& out,
                                        const Solution& solution )
 {
     size_t isrc = 0;    // Indice de la phrase dans le texte source
@@ -140,29 +140,29 @@ void FriendlyPrinter< T >::operator()( std::wostream& out,
     for( iter = solution.begin(); iter != solution.end(); iter++ )
     {
         out << "***************************************************" 
-            << std::endl; 
+            << '\n'; 
         
         // Imprime les phrases sources
         for( size_t i = 0; i < iter -> getSourceLength(); i++, isrc++ )
         {
             out << isrc + 1 << "(" << m_source.getSentenceID( isrc ) << "):\t";
             printSentence( out, m_source, isrc );
-            out << std::endl;
+            out << '\n';
         }
         
         out << "---------------------------------------------------" 
-            << std::endl;
+            << '\n';
         
         // Imprime les phrases cibles
         for( size_t j = 0; j < iter -> getTargetLength(); j++, itgt++ )
         {
             out << itgt + 1 << "(" << m_target.getSentenceID( itgt ) << "):\t";
             printSentence( out, m_target, itgt );
-            out << std::endl;
+            out << '\n';
         }
 
         out << "***************************************************" 
-            << std::endl;
+            << '\n';
     }
 
 }
@@ -170,7 +170,7 @@ void FriendlyPrinter< T >::operator()( std::wostream& out,
 
 // ------------------------------------------------------------------------ //
 template< class T >
-void FriendlyPrinter< T >::printSentence( std::wostream& out, const Text& text,
+void FriendlyPrinter< T >::printSentence( Utf8Writer& out, const Text& text,
                                           const size_t indice )
 {
     size_t begin;
@@ -180,7 +180,7 @@ void FriendlyPrinter< T >::printSentence( std::wostream& out, const Text& text,
 
     for( size_t i = begin; i < end; i++ )
     {
-        wcout << " " << text.getWord( i ).getWord();
+        out << " " << text.getWord( i ).getWord();
     }
 }
 
@@ -0,0 +1,587 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "japaevaluator.h"
+#include "japaexception.h"
+#include "japaoptions.h"
+#include "japaprogram.h"
+#include "toolbox.h"
+
+namespace japa
+{
+
+/**
+ * Les options de yasa interdites dans la grille : l'�valuateur choisit la
+ * sortie et aligne une seule paire de textes.
+ */
+static const char EVALUATOR_FORBIDDEN[] = {
+                                            JapaOptions::DOCUMENT_LIST,
+                                            JapaOptions::HELP,
+                                            JapaOptions::OUTPUT_FORMAT,
+                                            JapaOptions::PROGRESS,
+                                            JapaOptions::PROGRESS_FILE,
+                                            JapaOptions::RESULT_CACHE,
+                                            JapaOptions::SHARD,
+                                            JapaOptions::SHARD_MERGE,
+                                            JapaOptions::TRACE_FILE,
+                                            JapaOptions::VERBOSE,
+                                            JapaOptions::VERY_VERBOSE,
+                                            '\0'
+                                          };
+
+// ------------------------------------------------------------------------ //
+/**
+ * Retourne l'heure courante.
+ *
+ * @return Le nombre de secondes depuis l'�poque.
+ */
+static double now()
+{
+    struct timeval tv;
+
+    gettimeofday( &tv, NULL );
+
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+// ------------------------------------------------------------------------ //
+/**
+ * Remplace les suites d'espaces d'une liste d'identificateurs par un seul
+ * espace, sans espace au d�but ni � la fin.
+ *
+ * @param ids La liste.
+ *
+ * @return La liste normalis�e.
+ */
+static std::string normalizeIds( const std::string& ids )
+{
+    std::istringstream in( ids );
+    std::string id;
+    std::string result;
+
+    while( in >> id )
+    {
+        if( !result.empty() )
+        {
+            result += ' ';
+        }
+
+        result += id;
+    }
+
+    return result;
+}
+
+// ------------------------------------------------------------------------ //
+/**
+ * �crit un nombre r�el avec un nombre fixe de d�cimales.
+ *
+ * @param value Le nombre.
+ * @param decimals Le nombre de d�cimales.
+ *
+ * @return Le nombre �crit.
+ */
+static std::string toFixed( const double value, const int decimals )
+{
+    char buffer[ 64 ];
+
+    std::sprintf( buffer, "%.*f", decimals, value );
+
+    return buffer;
+}
+
+// ------------------------------------------------------------------------ //
+JapaEvaluator::JapaEvaluator() : m_jobs( 1 ), m_minF1( -1 )
+{
+    long processors = sysconf( _SC_NPROCESSORS_ONLN );
+
+    if( processors > 0 )
+    {
+        m_jobs = processors;
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaEvaluator::parse( int argc, char** argv )
+{
+    int c;
+    int jobs;
+
+    // Les options de l'�valuation s'arr�tent au premier argument
+    opterr = 0;
+
+    while( ( c = getopt( argc, argv, "+j:q:" ) ) != -1 )
+    {
+        if( c == 'j' )
+        {
+            jobs = std::atoi( optarg );
+
+            if( jobs < 1 )
+            {
+                throw Exception( toString( "Invalid number of jobs : " ) +
+                                 optarg );
+            }
+
+            m_jobs = jobs;
+        }
+        else if( c == 'q' )
+        {
+            m_minF1 = std::atof( optarg );
+        }
+        else
+        {
+            throw Exception( toString( "Invalid evaluation option : " ) +
+                             ( char )optopt );
+        }
+    }
+
+    if( argc - optind < 3 )
+    {
+        throw Exception( "Expected a reference alignment, a source and a "
+                         "target" );
+    }
+
+    m_gold = argv[ optind++ ];
+    m_source = argv[ optind++ ];
+    m_target = argv[ optind++ ];
+
+    // La grille : chaque option de yasa et ses valeurs
+    for( int i = optind; i < argc; i++ )
+    {
+        std::string option( argv[ i ] );
+        const char* letter;
+        std::vector< std::string > values;
+
+        letter = option.size() == 2 && option[ 0 ] == '-' &&
+                 option[ 1 ] != ':' ?
+                 std::strchr( JapaOptions::OPTSTRING, option[ 1 ] ) : NULL;
+
+        if( letter == NULL || *letter == '\0' )
+        {
+            throw Exception( "Unknown yasa option in grid : " + option );
+        }
+
+        if( std::strchr( EVALUATOR_FORBIDDEN, *letter ) != NULL )
+        {
+            throw Exception( "Option not available to the evaluation : " +
+                             option );
+        }
+
+        // Une option sans argument est commune � toutes les configurations
+        if( letter[ 1 ] != ':' )
+        {
+            m_common.push_back( option );
+            continue;
+        }
+
+        if( ++i == argc )
+        {
+            throw Exception( "Missing values for option : " + option );
+        }
+
+        std::string list( argv[ i ] );
+        size_t begin = 0;
+        size_t end;
+
+        do
+        {
+            end = list.find( ',', begin );
+            values.push_back( list.substr( begin, end - begin ) );
+            begin = end + 1;
+        }
+        while( end != std::string::npos );
+
+        if( values.size() == 1 )
+        {
+            m_common.push_back( option );
+            m_common.push_back( values[ 0 ] );
+        }
+        else
+        {
+            m_grid.push_back( make_pair( option, values ) );
+        }
+    }
+
+    readLinks( m_gold, m_goldLinks );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaEvaluator::run( std::ostream& out )
+{
+    std::map< int, size_t > running;
+    size_t next = 0;
+    size_t done = 0;
+
+    buildGrid();
+
+    while( done < m_configurations.size() )
+    {
+        // Un processus fils par configuration, m_jobs � la fois
+        while( next < m_configurations.size() && running.size() < m_jobs )
+        {
+            running[ start( m_configurations[ next ] ) ] = next;
+            next++;
+        }
+
+        struct rusage usage;
+        int status;
+        int pid = wait4( -1, &status, 0, &usage );
+
+        if( pid < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+
+            throw Exception( toString( "Can't wait for configuration : " ) +
+                             std::strerror( errno ) );
+        }
+
+        std::map< int, size_t >::iterator iter = running.find( pid );
+
+        if( iter == running.end() )
+        {
+            continue;
+        }
+
+        Configuration& configuration = m_configurations[ iter -> second ];
+
+        running.erase( iter );
+        done++;
+
+        configuration.wall = now() - configuration.start;
+        configuration.cpu = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                            ( usage.ru_utime.tv_usec +
+                              usage.ru_stime.tv_usec ) / 1e6;
+        // Linux donne le maximum en kilooctets
+        configuration.peak = ( size_t )usage.ru_maxrss * 1024;
+        configuration.failed = !WIFEXITED( status ) ||
+                               WEXITSTATUS( status ) != 0;
+
+        if( !configuration.failed )
+        {
+            score( configuration );
+        }
+
+        unlink( configuration.output.c_str() );
+
+        std::cerr << "[" << done << "/" << m_configurations.size() << "] "
+                  << configuration.label
+                  << ( configuration.failed ? " : failed" : "" ) << std::endl;
+    }
+
+    markPareto();
+    print( out );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaEvaluator::readLinks( const std::string& filename,
+                               std::set< std::string >& links )
+{
+    std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+    std::ostringstream content;
+    std::string text;
+    const std::string key( "xtargets=\"" );
+    size_t pos = 0;
+
+    if( !in )
+    {
+        throw Exception( "Can't open alignment : " + filename );
+    }
+
+    content << in.rdbuf();
+    text = content.str();
+
+    while( ( pos = text.find( key, pos ) ) != std::string::npos )
+    {
+        size_t begin = pos + key.size();
+        size_t end = text.find( '"', begin );
+        size_t separator = text.find( ';', begin );
+
+        if( end == std::string::npos || separator > end )
+        {
+            throw Exception( "Malformed link in alignment : " + filename );
+        }
+
+        links.insert( normalizeIds( text.substr( begin,
+                                                 separator - begin ) ) +
+                      ";" +
+                      normalizeIds( text.substr( separator + 1,
+                                                 end - separator - 1 ) ) );
+        pos = end;
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaEvaluator::buildGrid()
+{
+    std::vector< size_t > index( m_grid.size(), 0 );
+    size_t dimension;
+
+    m_configurations.clear();
+
+    // Les indices avancent comme un compteur, la derni�re option le plus vite
+    do
+    {
+        Configuration configuration;
+
+        configuration.options = m_common;
+        configuration.failed = true;
+        configuration.precision = 0;
+        configuration.recall = 0;
+        configuration.f1 = 0;
+        configuration.start = 0;
+        configuration.wall = 0;
+        configuration.cpu = 0;
+        configuration.peak = 0;
+        configuration.pareto = false;
+
+        for( size_t i = 0; i < m_grid.size(); i++ )
+        {
+            const std::string& value = m_grid[ i ].second[ index[ i ] ];
+
+            configuration.options.push_back( m_grid[ i ].first );
+            configuration.options.push_back( value );
+            configuration.label += ( i > 0 ? " " : "" ) + m_grid[ i ].first +
+                                   " " + value;
+        }
+
+        if( configuration.label.empty() )
+        {
+            configuration.label = "default";
+        }
+
+        m_configurations.push_back( configuration );
+
+        for( dimension = m_grid.size(); dimension > 0; dimension-- )
+        {
+            if( ++index[ dimension - 1 ] <
+                m_grid[ dimension - 1 ].second.size() )
+            {
+                break;
+            }
+
+            index[ dimension - 1 ] = 0;
+        }
+    }
+    while( dimension > 0 );
+}
+
+// ------------------------------------------------------------------------ //
+int JapaEvaluator::start( Configuration& configuration )
+{
+    int pid;
+
+    configuration.output = makeTemporary( "" );
+    configuration.start = now();
+
+    // Les tampons vid�s ne seront pas �crits deux fois par le fils
+    std::cout.flush();
+    std::cerr.flush();
+    pid = fork();
+
+    if( pid < 0 )
+    {
+        unlink( configuration.output.c_str() );
+        throw Exception( toString( "Can't start configuration : " ) +
+                         std::strerror( errno ) );
+    }
+
+    if( pid == 0 )
+    {
+        align( configuration );
+    }
+
+    return pid;
+}
+
+// ------------------------------------------------------------------------ //
+void JapaEvaluator::align( const Configuration& configuration )
+{
+    int status = 0;
+
+    try
+    {
+        JapaProgram program;
+        std::vector< std::string > args( 1, "yasa" );
+        std::vector< char* > argv;
+
+        args.insert( args.end(), configuration.options.begin(),
+                     configuration.options.end() );
+        args.push_back( toString( "-" ) + JapaOptions::OUTPUT_FORMAT );
+        args.push_back( toString( JapaOptions::OUTPUT_FORMAT_ARCADE ) );
+        args.push_back( m_source );
+        args.push_back( m_target );
+        args.push_back( configuration.output );
+
+        for( size_t i = 0; i < args.size(); i++ )
+        {
+            argv.push_back( const_cast< char* >( args[ i ].c_str() ) );
+        }
+
+        argv.push_back( NULL );
+
+#ifdef _OPENMP
+        // Les configurations se partagent d�j� les processeurs
+        if( m_jobs > 1 )
+        {
+            omp_set_num_threads( 1 );
+        }
+#endif
+
+#ifdef __GLIBC__
+        optind = 0;
+#else
+        optind = 1;
+#endif
+        program.parse( args.size(), &argv[ 0 ] );
+        program.run();
+    }
+    catch( std::exception& ex )
+    {
+        std::cerr << configuration.label << " : " << ex.what() << std::endl;
+        status = 1;
+    }
+
+    std::cout.flush();
+    std::cerr.flush();
+    _exit( status );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaEvaluator::score( Configuration& configuration )
+{
+    std::set< std::string > links;
+    size_t correct = 0;
+
+    try
+    {
+        readLinks( configuration.output, links );
+    }
+    catch( std::exception& ex )
+    {
+        std::cerr << configuration.label << " : " << ex.what() << std::endl;
+        configuration.failed = true;
+        return;
+    }
+
+    for( std::set< std::string >::const_iterator iter = links.begin();
+         iter != links.end(); iter++ )
+    {
+        correct += m_goldLinks.count( *iter );
+    }
+
+    configuration.precision = links.empty() ?
+                              0 : ( double )correct / links.size();
+    configuration.recall = m_goldLinks.empty() ?
+                           0 : ( double )correct / m_goldLinks.size();
+    configuration.f1 = correct == 0 ?
+            0 : 2 * configuration.precision * configuration.recall /
+                ( configuration.precision + configuration.recall );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaEvaluator::markPareto()
+{
+    for( size_t i = 0; i < m_configurations.size(); i++ )
+    {
+        Configuration& a = m_configurations[ i ];
+
+        a.pareto = !a.failed;
+
+        // Domin�e si une autre est au moins aussi bonne partout et meilleure
+        // quelque part
+        for( size_t j = 0; a.pareto && j < m_configurations.size(); j++ )
+        {
+            const Configuration& b = m_configurations[ j ];
+
+            if( j != i && !b.failed && b.f1 >= a.f1 && b.cpu <= a.cpu &&
+                ( b.f1 > a.f1 || b.cpu < a.cpu ) )
+            {
+                a.pareto = false;
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaEvaluator::print( std::ostream& out ) const
+{
+    const Configuration* fastest = NULL;
+
+    out << "precision\trecall\tf1\twall\tcpu\tpeak_mb\tpareto\toptions"
+        << std::endl;
+
+    for( size_t i = 0; i < m_configurations.size(); i++ )
+    {
+        const Configuration& c = m_configurations[ i ];
+
+        if( c.failed )
+        {
+            out << "-\t-\t-\t" << toFixed( c.wall, 2 ) << "\t"
+                << toFixed( c.cpu, 2 ) << "\t-\tfailed\t" << c.label
+                << std::endl;
+            continue;
+        }
+
+        out << toFixed( c.precision, 4 ) << "\t" << toFixed( c.recall, 4 )
+            << "\t" << toFixed( c.f1, 4 ) << "\t" << toFixed( c.wall, 2 )
+            << "\t" << toFixed( c.cpu, 2 ) << "\t"
+            << toFixed( c.peak / ( 1024.0 * 1024.0 ), 1 ) << "\t"
+            << ( c.pareto ? "yes" : "no" ) << "\t" << c.label << std::endl;
+
+        if( c.f1 >= m_minF1 && ( fastest == NULL || c.cpu < fastest -> cpu ) )
+        {
+            fastest = &c;
+        }
+    }
+
+    if( m_minF1 < 0 )
+    {
+        return;
+    }
+
+    if( fastest == NULL )
+    {
+        out << "# no configuration reaches F1 >= " << m_minF1 << std::endl;
+    }
+    else
+    {
+        out << "# fastest configuration with F1 >= " << m_minF1 << " : "
+            << fastest -> label << std::endl;
+    }
+}
+
+}// namespace japa
@@ -0,0 +1,379 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_JAPA_EVALUATOR_H
+#define JAPA_JAPA_EVALUATOR_H
+
+#include <cstddef>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace japa
+{
+
+/**
+ * \french
+ * �value yasa contre un alignement de r�f�rence sur une grille de
+ * param�tres.
+ *
+ * La r�f�rence est au format ARCADE ou CesAlign, celui qu'�crit
+ * <code>-o a</code> ou <code>-o c</code>.  Chaque configuration de la grille
+ * aligne les deux textes dans un processus fils, ce qui isole sa m�moire ;
+ * plusieurs fils tournent � la fois.  Pour chacune sont rapport�s la
+ * pr�cision, le rappel et la F-mesure des liens, le temps �coul�, le temps
+ * processeur et la plus grande taille r�sidente.  Les configurations que
+ * nulle autre ne surpasse � la fois en F-mesure et en temps processeur
+ * forment la fronti�re de Pareto.
+ *
+ * Un lien est compar� en entier : il est juste si la r�f�rence contient
+ * exactement les m�mes phrases sources et cibles.
+ * \endfrench
+ *
+ * \english
+ * Evaluates yasa against a reference alignment over a parameter grid.
+ *
+ * The reference is in the ARCADE or CesAlign format, the one written by
+ * <code>-o a</code> or <code>-o c</code>.  Each configuration of the grid
+ * aligns both texts in a child process, which isolates its memory; several
+ * children run at once.  For each are reported the links' precision,
+ * recall and F-measure, the elapsed time, the CPU time and the largest
+ * resident size.  The configurations that no other beats in both F-measure
+ * and CPU time form the Pareto frontier.
+ *
+ * A link is compared as a whole: it is right if the reference holds
+ * exactly the same source and target sentences.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class JapaEvaluator
+{
+public :
+    /**
+     * \french
+     * Constructeur.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     * \endenglish
+     */
+    JapaEvaluator();
+
+    /**
+     * \french
+     * Lit la ligne de commande : les options de l'�valuation, l'alignement
+     * de r�f�rence, les textes source et cible, puis la grille.  Chaque
+     * option de yasa de la grille est suivie de ses valeurs s�par�es par des
+     * virgules ; une option � une seule valeur est commune � toutes les
+     * configurations.
+     *
+     * @param argc La taille de <code>argv</code>.
+     * @param argv Les arguments re�us par la fonction <code>main</code>.
+     *
+     * @throw Exception Si la ligne de commande est invalide ou si la
+     *                  r�f�rence ne peut �tre lue.
+     * \endfrench
+     *
+     * \english
+     * Reads the command line: the evaluation's options, the reference
+     * alignment, the source and target texts, then the grid.  Each yasa
+     * option of the grid is followed by its comma separated values; an
+     * option with a single value is shared by all configurations.
+     *
+     * @param argc <code>argv</code>'s size.
+     * @param argv The arguments received by the <code>main</code> function.
+     *
+     * @throw Exception If the command line is invalid or if the reference
+     *                  can't be read.
+     * \endenglish
+     */
+    void parse( int argc, char** argv );
+
+    /**
+     * \french
+     * Aligne et �value chaque configuration, puis �crit le rapport.
+     *
+     * @param out Le flux du rapport.
+     *
+     * @throw Exception Si un processus fils ne peut �tre cr��.
+     * \endfrench
+     *
+     * \english
+     * Aligns and evaluates each configuration, then writes the report.
+     *
+     * @param out The report's stream.
+     *
+     * @throw Exception If a child process can't be created.
+     * \endenglish
+     */
+    void run( std::ostream& out );
+
+    /**
+     * \french
+     * Lit les liens d'un alignement au format ARCADE ou CesAlign.  Chaque
+     * lien devient les identificateurs de ses phrases sources et cibles,
+     * s�par�s par un espace et les deux c�t�s par un point-virgule.
+     *
+     * @param filename Le nom du fichier.
+     * @param links Re�oit les liens.
+     *
+     * @throw Exception Si le fichier ne peut �tre lu.
+     * \endfrench
+     *
+     * \english
+     * Reads the links of an alignment in the ARCADE or CesAlign format.
+     * Each link becomes the identifiers of its source and target sentences,
+     * separated by a space and both sides by a semicolon.
+     *
+     * @param filename The file's name.
+     * @param links Receives the links.
+     *
+     * @throw Exception If the file can't be read.
+     * \endenglish
+     */
+    static void readLinks( const std::string& filename,
+                           std::set< std::string >& links );
+
+private :
+    /**
+     * \french
+     * Une configuration de la grille et ses r�sultats.
+     * \endfrench
+     *
+     * \english
+     * A configuration of the grid and its results.
+     * \endenglish
+     */
+    struct Configuration
+    {
+        std::vector< std::string > options; /**< Les options de yasa */
+        std::string label;          /**< Les options propres � la config. */
+        std::string output;         /**< Le fichier de l'alignement */
+        bool failed;                /**< L'alignement a �chou� */
+        double precision;           /**< La pr�cision des liens */
+        double recall;              /**< Le rappel des liens */
+        double f1;                  /**< La F-mesure des liens */
+        double start;               /**< L'heure du d�but, en secondes */
+        double wall;                /**< Le temps �coul�, en secondes */
+        double cpu;                 /**< Le temps processeur, en secondes */
+        size_t peak;                /**< La taille r�sidente maximale */
+        bool pareto;                /**< Sur la fronti�re de Pareto */
+    };
+
+    /**
+     * \french
+     * Construit les configurations, produit cart�sien des valeurs de la
+     * grille.
+     * \endfrench
+     *
+     * \english
+     * Builds the configurations, Cartesian product of the grid's values.
+     * \endenglish
+     */
+    void buildGrid();
+
+    /**
+     * \french
+     * Lance l'alignement d'une configuration dans un processus fils.
+     *
+     * @param configuration La configuration.
+     *
+     * @return Le num�ro du processus fils.
+     *
+     * @throw Exception Si le processus ne peut �tre cr��.
+     * \endfrench
+     *
+     * \english
+     * Starts a configuration's alignment in a child process.
+     *
+     * @param configuration The configuration.
+     *
+     * @return The child process' identifier.
+     *
+     * @throw Exception If the process can't be created.
+     * \endenglish
+     */
+    int start( Configuration& configuration );
+
+    /**
+     * \french
+     * Aligne les textes avec une configuration.  Appel�e dans le processus
+     * fils, elle ne retourne jamais.
+     *
+     * @param configuration La configuration.
+     * \endfrench
+     *
+     * \english
+     * Aligns the texts with a configuration.  Called in the child process,
+     * it never returns.
+     *
+     * @param configuration The configuration.
+     * \endenglish
+     */
+    void align( const Configuration& configuration );
+
+    /**
+     * \french
+     * Compare l'alignement d'une configuration � la r�f�rence.
+     *
+     * @param configuration La configuration.
+     * \endfrench
+     *
+     * \english
+     * Compares a configuration's alignment to the reference.
+     *
+     * @param configuration The configuration.
+     * \endenglish
+     */
+    void score( Configuration& configuration );
+
+    /**
+     * \french
+     * Marque les configurations de la fronti�re de Pareto.
+     * \endfrench
+     *
+     * \english
+     * Marks the configurations of the Pareto frontier.
+     * \endenglish
+     */
+    void markPareto();
+
+    /**
+     * \french
+     * �crit le rapport : une ligne par configuration, s�par�e par des
+     * tabulations.
+     *
+     * @param out Le flux du rapport.
+     * \endfrench
+     *
+     * \english
+     * Writes the report: one line per configuration, separated by tabs.
+     *
+     * @param out The report's stream.
+     * \endenglish
+     */
+    void print( std::ostream& out ) const;
+
+    /**
+     * \french
+     * Le nombre de configurations align�es � la fois.
+     * \endfrench
+     *
+     * \english
+     * The number of configurations aligned at once.
+     * \endenglish
+     */
+    size_t m_jobs;
+
+    /**
+     * \french
+     * La F-mesure minimale, n�gative s'il n'y en a pas.
+     * \endfrench
+     *
+     * \english
+     * The minimum F-measure, negative if there is none.
+     * \endenglish
+     */
+    double m_minF1;
+
+    /**
+     * \french
+     * Le fichier de l'alignement de r�f�rence.
+     * \endfrench
+     *
+     * \english
+     * The reference alignment's file.
+     * \endenglish
+     */
+    std::string m_gold;
+
+    /**
+     * \french
+     * Le fichier source.
+     * \endfrench
+     *
+     * \english
+     * The source file.
+     * \endenglish
+     */
+    std::string m_source;
+
+    /**
+     * \french
+     * Le fichier cible.
+     * \endfrench
+     *
+     * \english
+     * The target file.
+     * \endenglish
+     */
+    std::string m_target;
+
+    /**
+     * \french
+     * Les liens de la r�f�rence.
+     * \endfrench
+     *
+     * \english
+     * The reference's links.
+     * \endenglish
+     */
+    std::set< std::string > m_goldLinks;
+
+    /**
+     * \french
+     * Les options communes � toutes les configurations.
+     * \endfrench
+     *
+     * \english
+     * The options shared by all configurations.
+     * \endenglish
+     */
+    std::vector< std::string > m_common;
+
+    /**
+     * \french
+     * Les dimensions de la grille : une option et ses valeurs.
+     * \endfrench
+     *
+     * \english
+     * The grid's dimensions: an option and its values.
+     * \endenglish
+     */
+    std::vector< std::pair< std::string, std::vector< std::string > > >
+            m_grid;
+
+    /**
+     * \french
+     * Les configurations, dans l'ordre de la grille.
+     * \endfrench
+     *
+     * \english
+     * The configurations, in the grid's order.
+     * \endenglish
+     */
+    std::vector< Configuration > m_configurations;
+};
+
+}// namespace japa
+
+#endif
@@ -26,6 +26,7 @@ limitations under the License.
 #include "japaexception.h"
 #include "japaoptions.h"
 #include "prefixcognatefinder.h"
+#include "qgramcognatefinder.h"
 #include "toolbox.h"
 #include "wordscorefunction.h"
 #include "wordssf.h"
@@ -37,7 +38,11 @@ namespace japa
 // Initialisation des constantes
 
 const char JapaOptions::OPTSTRING[] =   { 
+                                            ANCHOR_DIVISIONS,
+                                            ANCHOR_FILE, ':',
                                             BEAM_RADIUS, ':', 
+                                            CASCADE_RADIUS, ':',
+                                            CELL_BUDGET, ':',
                                             CHURCH_GALE_ALIGNMENT, ':',
                                             CHURCH_GALE_MATCH, ':',
                                             CHURCH_GALE_PENALTY, ':',
@@ -46,10 +51,14 @@ const char JapaOptions::OPTSTRING[] =   {
                                             COGNATE, ':',
                                             COGNATE_MAX_FREQUENCY, ':',
                                             COGNATE_MIN_LENGTH, ':',
+                                            COGNATE_MIN_RATIO, ':',
                                             COGNATE_PREFIX_LENGTH, ':',
+                                            COGNATE_QGRAM_LENGTH, ':',
                                             COGNATE_RADIUS, ':',
                                             COGNATE_RETURN_COUNT, ':',
                                             COGNATE_RETURN_COST, ':',
+                                            CORPUS_CACHE, ':',
+                                            DOCUMENT_LIST, ':',
                                             FELIPE_CHURCH_GALE_WEIGHT, ':',
                                             FELIPE_CORRECTION, ':',
                                             FELIPE_MODE, ':',
@@ -57,18 +66,30 @@ const char JapaOptions::OPTSTRING[] =   {
                                             HELP,
                                             INPUT_COMPRESSION, ':',
                                             INPUT_FORMAT, ':',
+                                            MAX_MEMORY, ':',
                                             OUTPUT_FORMAT, ':', 
+                                            PRECOMPUTE_COSTS,
+                                            PROGRESS, ':',
+                                            PROGRESS_FILE, ':',
+                                            PRUNING_MARGIN, ':',
+                                            RESULT_CACHE, ':',
                                             SCORE_FUNCTION, ':',
                                             SEARCH_SPACE, ':',
+                                            SHARD, ':',
+                                            SHARD_MERGE, ':',
                                             SIMARD_CPT, ':',
                                             SIMARD_CPNT, ':',
                                             SYNONYM_DICTIONARY, ':',
+                                            TRACE_FILE, ':',
                                             VERBOSE,
                                             VERY_VERBOSE,
+                                            WORD_BUDGET, ':',
                                             '\0'
                                         };
 
 const size_t JapaOptions::BEAM_RADIUS_DEFAULT           = ConstantBeamMarker::DEFAULT_RADIUS;
+const size_t JapaOptions::CASCADE_RADIUS_DEFAULT        = 0;
+const size_t JapaOptions::CELL_BUDGET_DEFAULT           = 0;
 const double JapaOptions::CHURCH_GALE_MATCH_DEFAULT     = ChurchGaleScore::DEFAULT_MATCH_WEIGHT;
 const double JapaOptions::CHURCH_GALE_PENALTY_DEFAULT   = ChurchGaleScore::DEFAULT_PENALTY_WEIGHT;
 const double JapaOptions::CHURCH_GALE_PRODUCTION_DEFAULT= ChurchGaleScore::DEFAULT_PRODUCTION;
@@ -76,7 +97,9 @@ const double JapaOptions::CHURCH_GALE_VARIANCE_DEFAULT  = ChurchGaleScore::DEFAU
 const char   JapaOptions::COGNATE_DEFAULT               = COGNATE_PREFIX;
 const size_t JapaOptions::COGNATE_MAX_FREQUENCY_DEFAULT = CognateSSValidator::DEFAULT_MAX_FREQUENCY;
 const size_t JapaOptions::COGNATE_MIN_LENGTH_DEFAULT    = CognateValidator::DEFAULT_MIN_LENGTH;
+const double JapaOptions::COGNATE_MIN_RATIO_DEFAULT     = QGramCognateFinder::DEFAULT_MIN_RATIO;
 const size_t JapaOptions::COGNATE_PREFIX_LENGTH_DEFAULT = PrefixCognateFinder::DEFAULT_PREFIX_LENGTH;
+const size_t JapaOptions::COGNATE_QGRAM_LENGTH_DEFAULT  = QGramCognateFinder::DEFAULT_QGRAM_LENGTH;
 const size_t JapaOptions::COGNATE_RADIUS_DEFAULT        = WordSSF::DEFAULT_RADIUS;
 const double JapaOptions::COGNATE_RETURN_COST_DEFAULT   = WordScoreFunction::DEFAULT_RETURN_COST;
 const size_t JapaOptions::COGNATE_RETURN_COUNT_DEFAULT  = WordScoreFunction::DEFAULT_RETURN_COUNT;
@@ -86,16 +109,23 @@ const char   JapaOptions::FELIPE_MODE_DEFAULT           = FELIPE_MODE_ALL;
 const double JapaOptions::FELIPE_SIMARD_WEIGHT_DEFAULT  = FelipeScore::DEFAULT_SIMARD_WEIGHT;
 const char   JapaOptions::INPUT_COMPRESSION_DEFAULT     = INPUT_COMPRESSION_NONE;
 const char   JapaOptions::INPUT_FORMAT_DEFAULT          = INPUT_FORMAT_RALI;
+const size_t JapaOptions::MAX_MEMORY_DEFAULT            = 0;
 const char   JapaOptions::OUTPUT_FORMAT_DEFAULT         = OUTPUT_FORMAT_RALI;
+const bool   JapaOptions::PRECOMPUTE_COSTS_DEFAULT      = false;
+const double JapaOptions::PROGRESS_DEFAULT              = 0;
+const double JapaOptions::PRUNING_MARGIN_DEFAULT        = 0;
 const char   JapaOptions::SCORE_FUNCTION_DEFAULT        = SCORE_FUNCTION_FELIPE;
 const char   JapaOptions::SEARCH_SPACE_DEFAULT          = SEARCH_SPACE_COGNATE;
 const double JapaOptions::SIMARD_CPT_DEFAULT            = FelipeScore::DEFAULT_CPT;
 const double JapaOptions::SIMARD_CPNT_DEFAULT           = FelipeScore::DEFAULT_CPNT;
 const bool   JapaOptions::VERBOSE_DEFAULT               = false;
 const bool   JapaOptions::VERY_VERBOSE_DEFAULT          = false;
+const size_t JapaOptions::WORD_BUDGET_DEFAULT           = 0;
 
 const std::string JapaOptions::USAGE_HELP = 
-        "Usage : yasa [options] source_file target_file [output_file]";
+        "Usage : yasa [options] source_file target_file [output_file]\n"
+        "        yasa [options] -G document_list\n"
+        "        yasa -G document_list -N count -J merged_file";
 
 const std::string JapaOptions::OPTIONS_HELP = std::string( "" ) +
 
@@ -118,6 +148,30 @@ const std::string JapaOptions::OPTIONS_HELP = std::string( "" ) +
 "          " + INPUT_COMPRESSION_GZIP + "  GZIP compression filter.\n" +
 "          " + INPUT_COMPRESSION_NONE + "  No compression.\n" +
 
+"-" + DOCUMENT_LIST +
+" s    Align every document pair of a list in a single run, each on its\n" +
+"        own and in parallel with OpenMP.  Each line holds a source file, a\n" +
+"        target file and an output file.\n" +
+
+"-" + CORPUS_CACHE +
+" s    Cache the parsed texts and their cognates in this directory, keyed by\n" +
+"        the input files' content and the parsing and cognate options.\n" +
+
+"-" + RESULT_CACHE +
+" s    Reuse the solutions of this cache file for the pairs of the document\n" +
+"        list whose content and options were already aligned, and align the\n" +
+"        identical pairs of the list only once.\n" +
+
+"-" + SHARD +
+" k/N  Only align the k-th of N shards of the document list, and write the\n" +
+"        shard's index beside the list.  With -" + SHARD_MERGE + 
+", give N alone instead.\n" +
+
+"-" + SHARD_MERGE +
+" s    Gather the outputs of the N shards given by -" + SHARD + 
+" N, the number of\n" +
+"        shards alone, in this file, in the document list's order.\n" +
+
 "\n" +
 "Cognate Options \n\n"
 
@@ -125,6 +179,7 @@ const std::string JapaOptions::OPTIONS_HELP = std::string( "" ) +
 " s    Set the cognate type. ( Default = " + COGNATE_DEFAULT + " )\n" +
 "          " + COGNATE_NONE   + "  No cognate\n" +
 "          " + COGNATE_PREFIX + "  Simard type cognate\n" +
+"          " + COGNATE_QGRAM  + "  Words with a high longest common subsequence ratio\n" +
 "          " + COGNATE_WORD   + "  Only identical words are cognates\n" +
 
 "-" + COGNATE_MIN_LENGTH +
@@ -139,6 +194,15 @@ const std::string JapaOptions::OPTIONS_HELP = std::string( "" ) +
 " n    Set the length of the prefix for Simard type cognates. ( Default = " + 
        toString( COGNATE_PREFIX_LENGTH_DEFAULT ) + " )\n" +
 
+"-" + COGNATE_QGRAM_LENGTH +
+" n    Set the length of the q-grams indexed for q-gram cognates. ( Default = " + 
+       toString( COGNATE_QGRAM_LENGTH_DEFAULT ) + " )\n" +
+
+"-" + COGNATE_MIN_RATIO +
+" r    Set the minimum longest common subsequence ratio of q-gram cognates,\n" +
+"        between 0 and 1. ( Default = " + 
+       toString( COGNATE_MIN_RATIO_DEFAULT ) + " )\n" +
+
 "-" + SYNONYM_DICTIONARY +
 " s    Specify a file containing a synonym dictionary.  The format of a\n" + 
 "        entry in the synonym dictionary is as follow :\n"
@@ -157,6 +221,20 @@ const std::string JapaOptions::OPTIONS_HELP = std::string( "" ) +
 " n    Set the radius of the beam sent between passage points. ( Default = " + 
        toString( BEAM_RADIUS_DEFAULT ) + " )\n" +
 
+"-" + CASCADE_RADIUS + 
+" n    With the Felipe score, first align with Church and Gale on the search\n" +
+"        space, then score with Felipe only within n sentences of that path.\n" +
+"        0 disables the cascade. ( Default = " + 
+       toString( CASCADE_RADIUS_DEFAULT ) + " )\n" +
+
+"-" + ANCHOR_FILE +
+" s    Specify a file of anchors.  Each line holds the ID of a source and of\n" +
+"        a target sentence that begin an aligned segment together.\n" +
+"        Use the option for each file\n" +
+
+"-" + ANCHOR_DIVISIONS +
+"      Use the beginning of each division as an anchor.\n" +
+
 "-" + COGNATE_RADIUS +
 " n    Set the maximum deviance of a cognate, " + toString( WordSSF::INFINITE_RADIUS ) + 
 " being infinite deviance.\n" + 
@@ -180,6 +258,33 @@ const std::string JapaOptions::OPTIONS_HELP = std::string( "" ) +
 "          " + SCORE_FUNCTION_FELIPE + " Felipe score function\n" +
 "          " + SCORE_FUNCTION_CHURCH_GALE + " Gale and Church score function\n" +
 
+"-" + PRECOMPUTE_COSTS + 
+"      Compute the transition costs of the whole search space in parallel\n" +
+"        before solving the dynamic table.\n" +
+
+"-" + PRUNING_MARGIN +
+" x    Drop the cells scoring more than x above the best cell of their\n" +
+"        anti-diagonal, solving again without pruning if the path is lost.\n" +
+"        0 disables the pruning. ( Default = " + 
+       toString( PRUNING_MARGIN_DEFAULT ) + " )\n" +
+
+"-" + CELL_BUDGET +
+" n    Fall back to a cheaper configuration when a document pair fills more\n" +
+"        than n search space cells : beam search space, narrower beam, then\n" +
+"        length-only score.  0 is unlimited. ( Default = " +
+       toString( CELL_BUDGET_DEFAULT ) + " )\n" +
+
+"-" + WORD_BUDGET +
+" n    Use a beam search space when the cognate search space of a document\n" +
+"        pair is estimated to exceed n word points.  0 is unlimited.\n" +
+"        ( Default = " + toString( WORD_BUDGET_DEFAULT ) + " )\n" +
+
+"-" + MAX_MEMORY +
+" n    Use the fastest dynamic table estimated to fit in n megabytes, and\n" +
+"        fail before solving if none fits.  The first pass of the cascade\n" +
+"        is bounded alike.  0 is unlimited.\n" +
+"        ( Default = " + toString( MAX_MEMORY_DEFAULT ) + " )\n" +
+
 "-" + CHURCH_GALE_ALIGNMENT +
 " s    Add a possible alignment.\n" + 
 "        An alignment is specified in the following way : \n" +
@@ -250,6 +355,10 @@ const std::string JapaOptions::OPTIONS_HELP = std::string( "" ) +
 // "          " + OUTPUT_FORMAT_FRIENDLY + " Human friendly output\n" +
 "          " + OUTPUT_FORMAT_RALI     + " RALI output format\n" +
 "          " + OUTPUT_FORMAT_SCORE    + " prints the final alignment score\n" +
+"          " + OUTPUT_FORMAT_TSV      + " aligned sentences as TSV ( needs -" + 
+                     INPUT_FORMAT + " " + INPUT_FORMAT_OSPL + " )\n" +
+"          " + OUTPUT_FORMAT_JSONL    + " aligned sentences as JSONL ( needs -" + 
+                     INPUT_FORMAT + " " + INPUT_FORMAT_OSPL + " )\n" +
 "\n" +
 "Other Options \n\n" +
 
@@ -257,7 +366,21 @@ const std::string JapaOptions::OPTIONS_HELP = std::string( "" ) +
 
 "-" + VERBOSE + "      Be verbose.\n" +
 
-"-" + VERY_VERBOSE + "      Be very verbose.\n";
+"-" + VERY_VERBOSE + "      Be very verbose, with the memory used by each stage.\n" +
+
+"-" + PROGRESS +
+" x    Report every x seconds on standard error the progress of the parsing,\n" +
+"        of the cognates' alignment and of the solving, with the rate and\n" +
+"        the remaining time.  0 disables the reports. ( Default = " +
+       toString( PROGRESS_DEFAULT ) + " )\n" +
+
+"-" + PROGRESS_FILE +
+" s    Replace this file with a JSON object at each progress report instead\n" +
+"        of writing to standard error.\n" +
+
+"-" + TRACE_FILE +
+" s    Write the stages of the alignment to this file as a Chrome trace, for\n" +
+"        Perfetto.  Needs a build with -DJAPA_TRACE.\n";
 
 const std::string JapaOptions::ONLINE_HELP = USAGE_HELP + "\n\n" + OPTIONS_HELP;
 
@@ -267,11 +390,18 @@ const std::string JapaOptions::ONLINE_HELP = USAGE_HELP + "\n\n" + OPTIONS_HELP;
 // ------------------------------------------------------------------------ //
 JapaOptions::JapaOptions() : Options( OPTSTRING, false )
 {
-    initDefault();
+    initDefault( std::locale() );
 }
 
 // ------------------------------------------------------------------------ //
-void JapaOptions::initDefault()
+JapaOptions::JapaOptions( const std::locale& locale ) 
+        : Options( OPTSTRING, false )
+{
+    initDefault( locale );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaOptions::initDefault( const std::locale& locale )
 {
     setOption( COGNATE, COGNATE_DEFAULT );
     setOption( INPUT_FORMAT, INPUT_FORMAT_DEFAULT );
@@ -290,32 +420,56 @@ void JapaOptions::initDefault()
         setOption( VERY_VERBOSE, '1' );
     }
 
-    setOption( COGNATE_RADIUS, toString( COGNATE_RADIUS_DEFAULT ) );
-    setOption( COGNATE_RETURN_COST, toString( COGNATE_RETURN_COST_DEFAULT ) );
-    setOption( COGNATE_RETURN_COUNT, toString( COGNATE_RETURN_COUNT_DEFAULT ) ); 
-    setOption( BEAM_RADIUS, toString( BEAM_RADIUS_DEFAULT ) );
+    if( PRECOMPUTE_COSTS_DEFAULT )
+    {
+        setOption( PRECOMPUTE_COSTS, '1' );
+    }
+
+    setOption( COGNATE_RADIUS, toString( COGNATE_RADIUS_DEFAULT, locale ) );
+    setOption( COGNATE_RETURN_COST, 
+               toString( COGNATE_RETURN_COST_DEFAULT, locale ) );
+    setOption( COGNATE_RETURN_COUNT, 
+               toString( COGNATE_RETURN_COUNT_DEFAULT, locale ) );
+    setOption( BEAM_RADIUS, toString( BEAM_RADIUS_DEFAULT, locale ) );
+    setOption( CASCADE_RADIUS, toString( CASCADE_RADIUS_DEFAULT, locale ) );
+    setOption( PRUNING_MARGIN, toString( PRUNING_MARGIN_DEFAULT, locale ) );
+    setOption( CELL_BUDGET, toString( CELL_BUDGET_DEFAULT, locale ) );
+    setOption( WORD_BUDGET, toString( WORD_BUDGET_DEFAULT, locale ) );
+    setOption( MAX_MEMORY, toString( MAX_MEMORY_DEFAULT, locale ) );
+    setOption( PROGRESS, toString( PROGRESS_DEFAULT, locale ) );
     setOption( COGNATE_PREFIX_LENGTH, 
-               toString( COGNATE_PREFIX_LENGTH_DEFAULT ) );
+               toString( COGNATE_PREFIX_LENGTH_DEFAULT, locale ) );
 
     setOption( COGNATE_MAX_FREQUENCY, 
-               toString( COGNATE_MAX_FREQUENCY_DEFAULT ) );
+               toString( COGNATE_MAX_FREQUENCY_DEFAULT, locale ) );
+
+    setOption( COGNATE_MIN_LENGTH, 
+               toString( COGNATE_MIN_LENGTH_DEFAULT, locale ) );
 
-    setOption( COGNATE_MIN_LENGTH, toString( COGNATE_MIN_LENGTH_DEFAULT ) );
+    setOption( COGNATE_QGRAM_LENGTH, 
+               toString( COGNATE_QGRAM_LENGTH_DEFAULT, locale ) );
+    setOption( COGNATE_MIN_RATIO, 
+               toString( COGNATE_MIN_RATIO_DEFAULT, locale ) );
     
-    setOption( CHURCH_GALE_MATCH, toString( CHURCH_GALE_MATCH_DEFAULT ) );
-    setOption( CHURCH_GALE_PENALTY, toString( CHURCH_GALE_PENALTY_DEFAULT ) );
+    setOption( CHURCH_GALE_MATCH, 
+               toString( CHURCH_GALE_MATCH_DEFAULT, locale ) );
+    setOption( CHURCH_GALE_PENALTY, 
+               toString( CHURCH_GALE_PENALTY_DEFAULT, locale ) );
     setOption( CHURCH_GALE_PRODUCTION, 
-            toString( CHURCH_GALE_PRODUCTION_DEFAULT ) );
-    setOption( CHURCH_GALE_VARIANCE, toString( CHURCH_GALE_VARIANCE_DEFAULT ) );
+            toString( CHURCH_GALE_PRODUCTION_DEFAULT, locale ) );
+    setOption( CHURCH_GALE_VARIANCE, 
+               toString( CHURCH_GALE_VARIANCE_DEFAULT, locale ) );
     
     setOption( FELIPE_CHURCH_GALE_WEIGHT, 
-            toString( FELIPE_CHURCH_GALE_WEIGHT_DEFAULT ) );
-    setOption( FELIPE_SIMARD_WEIGHT, toString( FELIPE_SIMARD_WEIGHT_DEFAULT ) );
+            toString( FELIPE_CHURCH_GALE_WEIGHT_DEFAULT, locale ) );
+    setOption( FELIPE_SIMARD_WEIGHT, 
+               toString( FELIPE_SIMARD_WEIGHT_DEFAULT, locale ) );
     setOption( FELIPE_MODE, FELIPE_MODE_DEFAULT );
-    setOption( FELIPE_CORRECTION, toString( FELIPE_CORRECTION_DEFAULT ) );
+    setOption( FELIPE_CORRECTION, 
+               toString( FELIPE_CORRECTION_DEFAULT, locale ) );
     
-    setOption( SIMARD_CPT, toString( SIMARD_CPT_DEFAULT ) );
-    setOption( SIMARD_CPNT, toString( SIMARD_CPNT_DEFAULT ) );
+    setOption( SIMARD_CPT, toString( SIMARD_CPT_DEFAULT, locale ) );
+    setOption( SIMARD_CPNT, toString( SIMARD_CPNT_DEFAULT, locale ) );
 }
 
 // ------------------------------------------------------------------------ //
@@ -23,6 +23,7 @@ limitations under the License.
     #include <config.h>
 #endif
 
+#include <locale>
 #include <string>
 
 #include "options.h"
@@ -45,6 +46,35 @@ namespace japa
 class JapaOptions : public Options
 {
 public :
+
+    /** 
+     * \french
+     * Aiguillage des points d'ancrage tir�s des divisions.  Le d�but de
+     * chaque division commence un segment dans les deux textes, qui doivent
+     * donc avoir le m�me nombre de divisions.
+     * \endfrench
+     *
+     * \english
+     * Division anchors' switch.  The beginning of each division starts a
+     * segment in both texts, which must thus have the same number of
+     * divisions.
+     * \endenglish
+     */
+    static const char ANCHOR_DIVISIONS = 'H';
+
+    /** 
+     * \french
+     * Aiguillage d'un fichier de points d'ancrage.  Chaque ligne contient
+     * l'identificateur d'une phrase source et celui d'une phrase cible qui
+     * commencent ensemble un segment.
+     * \endfrench
+     *
+     * \english
+     * Anchor file's switch.  Each line holds the ID of a source sentence and
+     * the ID of a target sentence that begin a segment together.
+     * \endenglish
+     */
+    static const char ANCHOR_FILE = 'A';
    
     /** 
      * \french
@@ -58,6 +88,81 @@ public :
      * @see BEAM_RADIUS_DEFAULT
      */
     static const char BEAM_RADIUS = 'b';
+
+    /** 
+     * \french
+     * Aiguillage du rayon du corridor de la cascade.  Avec la fonction de
+     * score Felipe, une premi�re passe Church and Gale sur l'espace de
+     * recherche choisi limite la passe Felipe � un corridor de ce rayon autour
+     * du chemin trouv�.  Un rayon nul d�sactive la cascade.
+     * \endfrench
+     *
+     * \english
+     * Cascade corridor radius' switch.  With the Felipe score function, a
+     * first Church and Gale pass on the chosen search space restricts the
+     * Felipe pass to a corridor of this radius around the path found.  A
+     * null radius disables the cascade.
+     * \endenglish
+     *
+     * @see CASCADE_RADIUS_DEFAULT
+     */
+    static const char CASCADE_RADIUS = 'C';
+
+    /** 
+     * \french
+     * Aiguillage du budget de cases.  Si une paire de documents remplit plus
+     * de cases de l'espace de recherche, l'alignement se rabat sur une
+     * configuration moins co�teuse : espace de recherche par faisceau, puis
+     * faisceau plus �troit, puis score fond� sur la longueur seule.  Un
+     * budget nul est illimit�.
+     * \endfrench
+     *
+     * \english
+     * Cells budget's switch.  If a document pair fills more cells of the
+     * search space, the alignment falls back to a cheaper configuration: beam
+     * search space, then narrower beam, then length-only score.  A null
+     * budget is unlimited.
+     * \endenglish
+     *
+     * @see CELL_BUDGET_DEFAULT
+     */
+    static const char CELL_BUDGET = 'Y';
+
+    /** 
+     * \french
+     * Aiguillage du budget de points de l'espace de recherche des mots.  Si
+     * l'estimation pour une paire de documents le d�passe, l'espace de
+     * recherche par cognates est remplac� par un faisceau.  Un budget nul
+     * est illimit�.
+     * \endfrench
+     *
+     * \english
+     * Words' search space points budget's switch.  If the estimate for a
+     * document pair exceeds it, the cognate search space is replaced by a
+     * beam.  A null budget is unlimited.
+     * \endenglish
+     *
+     * @see WORD_BUDGET_DEFAULT
+     */
+    static const char WORD_BUDGET = 'U';
+
+    /** 
+     * \french
+     * Aiguillage de la limite de m�moire, en m�gaoctets.  La table dynamique
+     * la plus rapide dont la m�moire estim�e respecte la limite est choisie ;
+     * si aucune ne la respecte, l'alignement �choue avant la r�solution.  Une
+     * limite nulle est illimit�e.
+     * \endfrench
+     *
+     * \english
+     * Memory limit's switch, in megabytes.  The fastest dynamic table whose
+     * estimated memory fits the limit is chosen; if none fits, the alignment
+     * fails before solving.  A null limit is unlimited.
+     * \endenglish
+     *
+     * @see MAX_MEMORY_DEFAULT
+     */
+    static const char MAX_MEMORY = 'Z';
     
     /** 
      * \french
@@ -70,6 +175,7 @@ public :
      *
      * @see COGNATE_NONE
      * @see COGNATE_PREFIX
+     * @see COGNATE_QGRAM
      * @see COGNATE_WORD
      * @see COGNATE_DEFAULT
      */
@@ -102,6 +208,19 @@ public :
      */
     static const char COGNATE_MIN_LENGTH = 'l';
     
+    /** 
+     * \french
+     * Aiguillage du LCSR minimal des cognates de type q-gramme. 
+     * \endfrench
+     *
+     * \english
+     * Q-gram cognate minimum LCSR's switch.
+     * \endenglish
+     *
+     * @see COGNATE_MIN_RATIO_DEFAULT
+     */
+    static const char COGNATE_MIN_RATIO = 'Q';
+    
     /** 
      * \french
      * Aiguillage de la longueur des pr�fixes des cognates. 
@@ -115,6 +234,19 @@ public :
      */
     static const char COGNATE_PREFIX_LENGTH = 'p';
     
+    /** 
+     * \french
+     * Aiguillage de la longueur des q-grammes des cognates. 
+     * \endfrench
+     *
+     * \english
+     * Cognate q-gram length's switch.
+     * \endenglish
+     * 
+     * @see COGNATE_QGRAM_LENGTH_DEFAULT
+     */
+    static const char COGNATE_QGRAM_LENGTH = 'q';
+    
     /** 
      * \french
      * Aiguillage de la d�viance maximale lors de la concordance de cognates.
@@ -276,6 +408,39 @@ public :
      */
     static const char FELIPE_SIMARD_WEIGHT = 'W';
     
+    /** 
+     * \french
+     * Aiguillage du r�pertoire du cache des textes analys�s.  Les textes et
+     * leurs cognates y sont enregistr�s sous une cl� tir�e du contenu des
+     * fichiers et des options d'analyse ; une ex�cution ult�rieure avec la
+     * m�me cl� les recharge sans refaire l'analyse.
+     * \endfrench
+     *
+     * \english
+     * Parsed texts cache directory's switch.  The texts and their cognates
+     * are saved there under a key taken from the files' content and from the
+     * parsing options; a later run with the same key reloads them without
+     * parsing again.
+     * \endenglish
+     */
+    static const char CORPUS_CACHE = 'K';
+
+    /** 
+     * \french
+     * Aiguillage de la liste de documents.  Chaque ligne de la liste nomme un
+     * fichier source, un fichier cible et le fichier de la solution ; toutes
+     * les paires sont align�es en une seule ex�cution, les limites des
+     * documents servant de points d'ancrage.
+     * \endfrench
+     *
+     * \english
+     * Document list's switch.  Each line of the list names a source file, a
+     * target file and the solution's file; every pair is aligned in a single
+     * run, the documents' boundaries being used as anchor points.
+     * \endenglish
+     */
+    static const char DOCUMENT_LIST = 'G';
+
     /** 
      * \french
      * Aiguillage pour afficher l'aide. 
@@ -329,9 +494,65 @@ public :
      * @see OUTPUT_FORMAT_CESALIGN
      * @see OUTPUT_FORMAT_FRIENDLY
      * @see OUTPUT_FORMAT_RALI
+     * @see OUTPUT_FORMAT_SCORE
+     * @see OUTPUT_FORMAT_TSV
+     * @see OUTPUT_FORMAT_JSONL
      */
     static const char OUTPUT_FORMAT = 'o';
 
+    /** 
+     * \french
+     * Aiguillage du calcul d'avance des co�ts de transition.  Les co�ts de
+     * chaque case de l'espace de recherche sont calcul�s en parall�le avant
+     * la r�solution de la table dynamique.
+     * \endfrench
+     *
+     * \english
+     * Transition costs precomputation's switch.  The costs of each cell of
+     * the search space are computed in parallel before the dynamic table is
+     * solved.
+     * \endenglish
+     *
+     * @see PRECOMPUTE_COSTS_DEFAULT
+     */
+    static const char PRECOMPUTE_COSTS = 'D';
+
+    /** 
+     * \french
+     * Aiguillage de la marge d'�lagage de la table dynamique.  Les cases dont
+     * le score d�passe de plus de cette marge le meilleur score de leur
+     * anti-diagonale sont �cart�es.  Une marge nulle d�sactive l'�lagage.
+     * \endfrench
+     *
+     * \english
+     * Dynamic table pruning margin's switch.  The cells whose score exceeds
+     * the best score of their anti-diagonal by more than this margin are
+     * dropped.  A null margin disables the pruning.
+     * \endenglish
+     *
+     * @see PRUNING_MARGIN_DEFAULT
+     */
+    static const char PRUNING_MARGIN = 'B';
+
+    /** 
+     * \french
+     * Aiguillage du cache des solutions.  Avant d'aligner les paires de la
+     * liste de documents, ce fichier est consult� selon une empreinte du
+     * contenu normalis� des documents et des options effectives ; les
+     * paires identiques d'une m�me liste ne sont align�es qu'une fois.
+     * \endfrench
+     *
+     * \english
+     * Solutions cache's switch.  Before aligning the pairs of the document
+     * list, this file is looked up by a hash of the documents' normalized
+     * content and of the effective options; the identical pairs of a list
+     * are only aligned once.
+     * \endenglish
+     *
+     * @see DOCUMENT_LIST
+     */
+    static const char RESULT_CACHE = 'X';
+
     /** 
      * \french
      * L'aiguillage de la fonction de score. 
@@ -361,6 +582,41 @@ public :
      */
     static const char SEARCH_SPACE = 'e';
 
+    /** 
+     * \french
+     * Aiguillage du d�coupage en lots.  La valeur <code>k/N</code> n'aligne
+     * que le lot <code>k</code> parmi <code>N</code> de la liste de
+     * documents ; chaque paire est assign�e � un lot par une empreinte de ses
+     * noms de fichiers.  L'index du lot est �crit � c�t� de la liste.
+     * \endfrench
+     *
+     * \english
+     * Sharding's switch.  The value <code>k/N</code> only aligns the shard
+     * <code>k</code> out of <code>N</code> of the document list; each pair is
+     * assigned to a shard by a hash of its file names.  The shard's index is
+     * written beside the list.
+     * \endenglish
+     *
+     * @see DOCUMENT_LIST
+     */
+    static const char SHARD = 'N';
+
+    /** 
+     * \french
+     * Aiguillage de la fusion des lots.  Les solutions des <code>N</code>
+     * lots sont r�unies dans ce fichier, dans l'ordre de la liste de
+     * documents.
+     * \endfrench
+     *
+     * \english
+     * Shards merging's switch.  The solutions of the <code>N</code> shards
+     * are gathered in this file, in the document list's order.
+     * \endenglish
+     *
+     * @see SHARD
+     */
+    static const char SHARD_MERGE = 'J';
+
     /** 
      * \french
      * Aiguillage de la probabilit� qu'un mot source ait un cognate dans une 
@@ -427,6 +683,56 @@ public :
      * @see VERY_VERBOSE_DEFAULT
      */
     static const char VERY_VERBOSE = 'V';
+
+    /** 
+     * \french
+     * Aiguillage de l'intervalle des rapports d'avancement, en secondes.
+     * L'analyse des textes, l'alignement des cognates et la r�solution de la
+     * table rapportent alors leur avancement, leur d�bit et le temps restant
+     * estim�.  Un intervalle nul d�sactive les rapports.
+     * \endfrench
+     *
+     * \english
+     * Progress reports interval's switch, in seconds.  The texts' parsing,
+     * the cognates' alignment and the table's solving then report their
+     * progress, their rate and the estimated remaining time.  A null
+     * interval disables the reports.
+     * \endenglish
+     *
+     * @see PROGRESS_DEFAULT
+     */
+    static const char PROGRESS = 'I';
+
+    /** 
+     * \french
+     * Aiguillage du fichier des rapports d'avancement.  Chaque rapport
+     * remplace le fichier par un objet JSON plut�t que d'�tre �crit sur
+     * l'erreur standard.
+     * \endfrench
+     *
+     * \english
+     * Progress reports file's switch.  Each report replaces the file with a
+     * JSON object instead of being written to the standard error.
+     * \endenglish
+     */
+    static const char PROGRESS_FILE = 'O';
+
+    /** 
+     * \french
+     * Aiguillage du fichier de trace.  Les �tapes de l'alignement, par paire
+     * et par fil, y sont �crites au format Chrome, lisible par Perfetto.
+     * Le programme doit �tre compil� avec <code>JAPA_TRACE</code>.
+     * \endfrench
+     *
+     * \english
+     * Trace file's switch.  The alignment's stages, per pair and per thread,
+     * are written to it in the Chrome format, readable by Perfetto.  The
+     * program must be compiled with <code>JAPA_TRACE</code>.
+     * \endenglish
+     *
+     * @see Trace
+     */
+    static const char TRACE_FILE = 'E';
     
     /** 
      * \french
@@ -452,6 +758,58 @@ public :
      * @see BEAM_RADIUS
      */
     static const size_t BEAM_RADIUS_DEFAULT;
+
+    /** 
+     * \french
+     * Le rayon par d�faut du corridor de la cascade ( d�sactiv�e ). 
+     * \endfrench
+     *
+     * \english
+     * Default cascade corridor radius ( disabled ).
+     * \endenglish
+     *
+     * @see CASCADE_RADIUS
+     */
+    static const size_t CASCADE_RADIUS_DEFAULT;
+
+    /** 
+     * \french
+     * Le budget de cases par d�faut ( illimit� ). 
+     * \endfrench
+     *
+     * \english
+     * Default cells budget ( unlimited ).
+     * \endenglish
+     *
+     * @see CELL_BUDGET
+     */
+    static const size_t CELL_BUDGET_DEFAULT;
+
+    /** 
+     * \french
+     * Le budget de points des mots par d�faut ( illimit� ). 
+     * \endfrench
+     *
+     * \english
+     * Default words' points budget ( unlimited ).
+     * \endenglish
+     *
+     * @see WORD_BUDGET
+     */
+    static const size_t WORD_BUDGET_DEFAULT;
+
+    /** 
+     * \french
+     * La limite de m�moire par d�faut ( illimit�e ). 
+     * \endfrench
+     *
+     * \english
+     * Default memory limit ( unlimited ).
+     * \endenglish
+     *
+     * @see MAX_MEMORY
+     */
+    static const size_t MAX_MEMORY_DEFAULT;
     
     /** 
      * \french
@@ -545,6 +903,19 @@ public :
      */
     static const size_t COGNATE_MAX_FREQUENCY_DEFAULT;
     
+    /** 
+     * \french
+     * Le LCSR minimal par d�faut des cognates de type q-gramme. 
+     * \endfrench
+     *
+     * \english
+     * Default q-gram cognates' minimum LCSR.
+     * \endenglish
+     *
+     * @see COGNATE_MIN_RATIO
+     */
+    static const double COGNATE_MIN_RATIO_DEFAULT;
+    
     /** 
      * \french
      * Le type de cognates 'aucun cognate'. 
@@ -584,6 +955,32 @@ public :
      */
     static const size_t COGNATE_PREFIX_LENGTH_DEFAULT; 
 
+    /** 
+     * \french
+     * Le type de cognates 'q-gramme'. 
+     * \endfrench
+     *
+     * \english
+     * Q-gram cognate type option.
+     * \endenglish
+     *
+     * @see COGNATE
+     */
+    static const char COGNATE_QGRAM = 'q';
+
+    /** 
+     * \french
+     * La longueur des q-grammes des cognates par d�faut. 
+     * \endfrench
+     *
+     * \english
+     * Default cognate q-gram's length.
+     * \endenglish
+     *
+     * @see COGNATE_QGRAM_LENGTH
+     */
+    static const size_t COGNATE_QGRAM_LENGTH_DEFAULT; 
+
     /** 
      * \french
      * La d�viance maximale par d�faut d'un cognate. 
@@ -926,6 +1323,33 @@ public :
      */
     static const char OUTPUT_FORMAT_SCORE = 's';
 
+    /** 
+     * \french
+     * Format de sortie du bitexte align�, en colonnes s�par�es par des
+     * tabulations. 
+     * \endfrench
+     *
+     * \english
+     * Aligned bitext output format, in tab separated columns.
+     * \endenglish
+     *
+     * @see OUTPUT_FORMAT 
+     */
+    static const char OUTPUT_FORMAT_TSV = 't';
+
+    /** 
+     * \french
+     * Format de sortie du bitexte align�, un objet JSON par ligne. 
+     * \endfrench
+     *
+     * \english
+     * Aligned bitext output format, one JSON object per line.
+     * \endenglish
+     *
+     * @see OUTPUT_FORMAT 
+     */
+    static const char OUTPUT_FORMAT_JSONL = 'j';
+
     
     /** 
      * \french
@@ -950,6 +1374,33 @@ public :
      * @see SCORE_FUNCTION 
      */
     static const char SCORE_FUNCTION_DEFAULT;
+
+    /** 
+     * \french
+     * La marge d'�lagage par d�faut ( d�sactiv� ). 
+     * \endfrench
+     *
+     * \english
+     * Default pruning margin ( disabled ).
+     * \endenglish
+     *
+     * @see PRUNING_MARGIN
+     */
+    static const double PRUNING_MARGIN_DEFAULT;
+
+    /** 
+     * \french
+     * Indique s'il faut calculer les co�ts de transition d'avance par d�faut.
+     * \endfrench
+     *
+     * \english
+     * Precompute the transition costs ( <code>true</code> ) or not 
+     * ( <code>false</code> ) by default.
+     * \endenglish
+     *
+     * @see PRECOMPUTE_COSTS
+     */
+    static const bool PRECOMPUTE_COSTS_DEFAULT;
     
     /** 
      * \french
@@ -1093,6 +1544,19 @@ public :
      * @see VERY_VERBOSE 
      */
     static const bool VERY_VERBOSE_DEFAULT;
+
+    /** 
+     * \french
+     * L'intervalle par d�faut des rapports d'avancement ( d�sactiv�s ). 
+     * \endfrench
+     *
+     * \english
+     * Default progress reports interval ( disabled ).
+     * \endenglish
+     *
+     * @see PROGRESS
+     */
+    static const double PROGRESS_DEFAULT;
     
     
     /** 
@@ -1139,6 +1603,23 @@ public :
      */
     JapaOptions();
 
+    /**
+     * \french 
+     * Constructeur.  Les valeurs num�riques par d�faut sont �crites selon
+     * une locale donn�e plut�t que la locale globale.
+     *
+     * @param locale La locale des valeurs par d�faut.
+     * \endfrench
+     *
+     * \english
+     * Constructor.  The numeric default values are written following a
+     * given locale instead of the global one.
+     *
+     * @param locale The default values' locale.
+     * \endenglish
+     */
+    explicit JapaOptions( const std::locale& locale );
+
     /**
      * \french
      * Retourne le message d'aide en ligne.
@@ -1158,13 +1639,17 @@ protected :
     /**
      * \french
      * Initialise les options par d�faut.
+     *
+     * @param locale La locale des valeurs num�riques.
      * \endfrench
      *
      * \english
      * Object's initializer.
+     *
+     * @param locale The numeric values' locale.
      * \endenglish
      */
-    virtual void initDefault();
+    virtual void initDefault( const std::locale& locale );
     
     /**
      * \french
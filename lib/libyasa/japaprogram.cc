@@ -16,9 +16,16 @@ limitations under the License.
 
 */  
 
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <ctime>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdint.h>
 //mes tests
 
 #include <iostream>
@@ -26,14 +33,19 @@ using namespace std;
 
 
 #include "alignment.h"
+#include "anchorssf.h"
 #include "arcadeparser.h"
 #include "arcadeprinter.h"
 #include "beamssf.h"
+#include "binarylexicon.h"
+#include "bitextprinter.h"
 #include "bitextsynonymcontainer.h"
+#include "cascadessf.h"
 #include "cesalignprinter.h"
 #include "cesanaparser.h"
 #include "cognatessf.h"
 #include "constantbeammarker.h"
+#include "corpuscache.h"
 #include "felipescore.h"
 #include "filter.h"
 #include "friendlyprinter.h"
@@ -41,6 +53,7 @@ using namespace std;
 #include "japasynonymparser.h"
 #include "onesentperlineparser.h"
 #include "prefixcognatefinder.h"
+#include "qgramcognatefinder.h"
 #include "raliparser.h"
 #include "raliprinter.h"
 #include "scoreprinter.h"
@@ -69,17 +82,28 @@ void setPtr( std::auto_ptr< T >& autoptr, S* ptr )
 }
 
 // ------------------------------------------------------------------------ //
-JapaProgram::JapaProgram() : m_solutionStream( NULL )
+JapaProgram::JapaProgram() 
+        : m_cognateFiller( NULL ), m_cascade( NULL ), 
+          m_cellCounter( m_documents ), m_solutionFile( NULL ),
+          m_messagesStream( &std::cerr ), m_tracing( false )
+{}
+
+// ------------------------------------------------------------------------ //
+JapaProgram::JapaProgram( const JapaOptions& options ) 
+        : JapaOptions( options ), m_cognateFiller( NULL ), m_cascade( NULL ),
+          m_cellCounter( m_documents ), m_solutionFile( NULL ), 
+          m_messagesStream( &std::cerr ), m_tracing( false )
 {}
 
 // ------------------------------------------------------------------------ //
 JapaProgram::~JapaProgram()
 {
     // Ferme les flux
-    if( m_solutionStream != NULL && m_solutionStream != &std::wcout )
+    closeSolution();
+
+    if( m_tracing )
     {
-        ( ( std::wofstream* ) m_solutionStream ) -> close();
-        delete m_solutionStream;
+        Trace::close();
     }
 }
 
@@ -92,32 +116,39 @@ void JapaProgram::run()
     {
         std::cout << getOnlineHelp() << std::endl;
     }
+    else if( isOption( SHARD_MERGE ) )
+    {
+        initDocuments();
+        mergeShards();
+    }
     else
     {
         // Initialise les composants
-    	initStreams();
-        initText();
-        initCognate();
+        initDocuments();
+        initResults();
 
-        initSynonymDictionaries();
-        initSearchSpace();
-        initTable();
-        initPrinter(); 
-        
-        // Remplit l'espace de recherche
-        verbose( "Filling search space" );
-        ( *m_SSFiller )( *m_searchSpace );
+        // Un lot peut ne recevoir aucune paire de la liste, et le cache peut
+        // toutes les fournir
+        if( m_documents.empty() )
+        {
+            finishResults();
 
-        // Aligne les phrases
-        verbose( "Finding best alignment" );
-        m_dynamicTable -> solve();
-        
-        // Affiche les r�sultats
-        DynamicTable< double >::Iterator iter = m_dynamicTable -> getIterator();
-        std::list< Alignment< double > > l = buildAlignment< double >( iter );
+            if( isOption( SHARD ) )
+            {
+                writeShardIndex();
+            }
 
-        verbose( "Printing solution" );
-        ( *m_solutionPrinter )( *m_solutionStream, l );
+            return;
+        }
+
+        initTrace();
+        alignDocuments();
+        finishResults();
+
+        if( isOption( SHARD ) )
+        {
+            writeShardIndex();
+        }
 
         verbose( toString( "japa took " ) + 
                  toString( time( NULL ) - startTime ) + 
@@ -126,236 +157,1095 @@ void JapaProgram::run()
     }
 }
 
+// ------------------------------------------------------------------------ //
+void JapaProgram::align( std::wistream& source, std::wistream& target,
+                         const SynonymList& synonyms,
+                         SolutionPrinter< double >::Solution& solution )
+{
+    std::string format;
+    std::auto_ptr< TextParser > srcTextParser( newTextParser( format ) );
+    std::auto_ptr< TextParser > tgtTextParser( newTextParser( format ) );
+    Document document;
+
+    setPtr( m_source, new Text() );
+    setPtr( m_target, new Text() );
+    initProgress();
+    initTrace();
+
+    parseText( *srcTextParser, source, *m_source, "Parsing source" );
+    parseText( *tgtTextParser, target, *m_target, "Parsing target" );
+
+    // Une seule paire de documents, sans fichiers
+    document.sourceBegin = 0;
+    document.targetBegin = 0;
+    document.sourceCount = m_source -> getSentenceCount();
+    document.targetCount = m_target -> getSentenceCount();
+    m_documents.assign( 1, document );
+
+    initCognate();
+    initSynonymDictionaries();
+    addSynonyms( synonyms );
+    initAligner();
+    solve( solution );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::align( const std::string& source, const std::string& target,
+                         const SynonymList& synonyms, std::FILE* output )
+{
+    std::wistringstream sourceStream( decodeUtf8( source.data(), 
+                                                  source.size() ) );
+    std::wistringstream targetStream( decodeUtf8( target.data(), 
+                                                  target.size() ) );
+    SolutionPrinter< double >::Solution l;
+
+    align( sourceStream, targetStream, synonyms, l );
+
+    m_documents[ 0 ].source = getArgument( SOURCE_FILE );
+    m_documents[ 0 ].target = getArgument( TARGET_FILE );
+
+    // Le bitexte align� lit ses phrases dans les textes eux-m�mes
+    setPtr( m_sourceMap, new MappedText() );
+    setPtr( m_targetMap, new MappedText() );
+    m_sourceMap -> assign( source );
+    m_targetMap -> assign( target );
+
+    // Le flux appartient � l'appelant : seul l'�crivain est lib�r�
+    closeSolution();
+    setPtr( m_solutionStream, new Utf8Writer( output, std::locale() ) );
+    initPrinter( m_documents[ 0 ] );
+    printSolution( l );
+    m_solutionStream.reset();
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initDocuments()
+{
+    Document document;
+    std::string filename = getOption( DOCUMENT_LIST );
+    std::ifstream in;
+    std::string line;
+    size_t lineNumber = 0;
+    size_t pairCount = 0;
+    size_t shard = 0;
+    size_t shardCount = 0;
+
+    m_documents.clear();
+
+    if( ( isOption( SHARD ) || isOption( SHARD_MERGE ) ) && 
+        !isOption( DOCUMENT_LIST ) )
+    {
+        error( "Shards need a document list" );
+    }
+
+    // Sans liste, les arguments forment l'unique paire de documents
+    if( !isOption( DOCUMENT_LIST ) )
+    {
+        document.source = getArgument( SOURCE_FILE );
+        document.target = getArgument( TARGET_FILE );
+        document.output = getArgument( OUTPUT_FILE );
+        document.line = 0;
+        m_documents.push_back( document );
+
+        return;
+    }
+
+    // La fusion a besoin de la liste enti�re
+    if( isOption( SHARD ) && !isOption( SHARD_MERGE ) )
+    {
+        parseShard( shard, shardCount );
+
+        if( shard == 0 )
+        {
+            error( "Invalid shard, k/N expected without -" + 
+                   toString( SHARD_MERGE ) + " : " + getOption( SHARD ) );
+        }
+    }
+
+    in.open( filename.c_str() );
+
+    if( in.fail() )
+    {
+        error( toString( "Can't open document list : " ) + filename );
+    }
+
+    while( getline( in, line ) )
+    {
+        std::istringstream linestream( line );
+
+        lineNumber++;
+
+        // Les lignes vides sont ignor�es
+        if( !( linestream >> document.source ) )
+        {
+            continue;
+        }
+
+        if( !( linestream >> document.target >> document.output ) )
+        {
+            error( toString( "Missing file in document list " ) + filename + 
+                   " at line " + toString( lineNumber ) );
+        }
+
+        document.line = lineNumber;
+        pairCount++;
+
+        if( shard == 0 || getShard( document, shardCount ) == shard )
+        {
+            m_documents.push_back( document );
+        }
+    }
+
+    if( pairCount == 0 )
+    {
+        error( toString( "Empty document list : " ) + filename );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+JapaProgram::SynonymListContainer::SynonymListContainer( 
+        SynonymList& synonyms )
+        : m_synonyms( synonyms )
+{}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::SynonymListContainer::addSynonyms( std::wstring& word1, 
+                                                     std::wstring& word2 )
+{
+    m_synonyms.push_back( std::make_pair( word1, word2 ) );
+}
+
+// ------------------------------------------------------------------------ //
+JapaProgram::PairCellCounter::PairCellCounter( 
+        const std::vector< Document >& documents )
+        : m_documents( documents )
+{}
+
+// ------------------------------------------------------------------------ //
+size_t JapaProgram::PairCellCounter::operator()( 
+        const SearchSpace& space ) const
+{
+    std::vector< size_t > cells( m_documents.size(), 0 );
+    SearchSpace::Iterator iter = space.getIterator();
+
+    while( iter.hasNext() )
+    {
+        size_t low = 0;
+        size_t high = m_documents.size();
+
+        iter.next();
+
+        // La derni�re paire qui commence avant la case
+        while( high - low > 1 )
+        {
+            size_t middle = ( low + high ) / 2;
+
+            if( ( int )m_documents[ middle ].sourceBegin <= iter.x() )
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        cells[ low ]++;
+    }
+
+    return *std::max_element( cells.begin(), cells.end() );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::alignDocuments()
+{
+    JapaOptions options( *this );
+    SynonymList synonyms;
+    std::string message;
+    bool failed = false;
+    JAPA_TRACE_SCOPE( "alignDocuments", m_tracePair );
+
+    readSynonyms( options, synonyms );
+    initProgress();
+
+    // Avec plusieurs paires, la progression compte les paires align�es
+    if( m_documents.size() > 1 )
+    {
+        options.removeOption( PROGRESS );
+        options.removeOption( PROGRESS_FILE );
+        m_progress.setTask( "Aligning document pairs" );
+        m_progress.start( "pairs", m_documents.size() );
+    }
+
+    // Chaque paire est align�e seule par son propre programme : ni ses
+    // cognates, ni son espace de recherche, ni sa solution, ni ses replis
+    // ne d�pendent des autres paires
+    #pragma omp parallel for schedule( dynamic )
+    for( long d = 0; d < ( long )m_documents.size(); d++ )
+    {
+        try
+        {
+            JapaProgram program( options );
+
+            program.alignDocument( m_documents[ d ], synonyms );
+        }
+        catch( std::exception& ex )
+        {
+            #pragma omp critical( JapaProgramError )
+            {
+                if( !failed )
+                {
+                    message = ex.what();
+                    failed = true;
+                }
+            }
+        }
+
+        if( m_documents.size() > 1 )
+        {
+            #pragma omp critical( JapaProgramProgress )
+            m_progress.advance();
+        }
+    }
+
+    if( failed )
+    {
+        error( message );
+    }
+
+    if( m_documents.size() > 1 )
+    {
+        m_progress.finish();
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::readSynonyms( JapaOptions& options, SynonymList& synonyms )
+{
+    OptionList ol = options.getOptionList( SYNONYM_DICTIONARY );
+    OptionList::const_iterator iter;
+    SynonymListContainer container( synonyms );
+    JapaSynonymParser parser;
+
+    options.removeOption( SYNONYM_DICTIONARY );
+
+    for( iter = ol.begin(); iter != ol.end(); iter++ )
+    {
+        // Les lexiques compil�s sont projet�s par chaque paire
+        if( BinaryLexicon::isBinaryLexicon( *iter ) )
+        {
+            options.setOption( SYNONYM_DICTIONARY, *iter );
+        }
+        else
+        {
+            std::wifstream in;
+
+            veryVerbose( toString( "Parsing synonym dictionary : " ) + 
+                         *iter );
+            in.open( iter -> c_str() );
+
+            if( in.fail() )
+            {
+                error( toString( "Can't open synonym dictionary : " ) + 
+                       *iter );
+            }
+
+            parser( in, container );
+        }
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::alignDocument( Document& document, 
+                                 const SynonymList& synonyms )
+{
+    SolutionPrinter< double >::Solution l;
+
+    m_documents.assign( 1, document );
+
+    if( isOption( DOCUMENT_LIST ) )
+    {
+        veryVerbose( "Document pair : " + document.source + " " + 
+                     document.target );
+    }
+
+    initStreams();
+    initProgress();
+    initTrace();
+    initCorpus();
+    initSynonymDictionaries();
+    addSynonyms( synonyms );
+    initAligner();
+    initPrinter( m_documents[ 0 ] );
+        
+    // Aligne les phrases
+    solve( l );
+        
+    // Affiche les r�sultats
+    printSolution( l );
+    closeSolution();
+
+    document = m_documents[ 0 ];
+}
+
 // ------------------------------------------------------------------------ //
 void JapaProgram::initStreams()
 {
-    std::string sol = getArgument( OUTPUT_FILE );
-    
+    openSolution( m_documents[ 0 ].output );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::openSolution( const std::string& filename )
+{
+    closeSolution();
+
     // Initialise les flux de la solution et des messages.
-    if( sol.empty() )
+    // La solution est �crite en UTF-8 par blocs ; les nombres suivent la
+    // locale qu'aurait eue le flux standard correspondant.
+    if( filename.empty() )
     {
-        m_solutionStream = &std::wcout;
+        m_solutionFile = stdout;
+        setPtr( m_solutionStream, 
+                new Utf8Writer( m_solutionFile, std::wcout.getloc() ) );
         m_messagesStream = &std::cerr;
     } 
     else
     {
-        m_solutionStream = new std::wofstream( sol.c_str() );
+        m_solutionFile = fopen( filename.c_str(), "w" );
         
-        if( m_solutionStream -> fail() )
+        if( m_solutionFile == NULL )
         {
             // Erreur avec le fichier source
             std::string desc( "Can't write solution to file : " );
-            desc += sol;
+            desc += filename;
             
             error( desc );
         } 
         
+        setPtr( m_solutionStream, new Utf8Writer( m_solutionFile, 
+                                                  std::locale() ) );
         m_messagesStream = &std::cout;
     }
 }
 
+// ------------------------------------------------------------------------ //
+void JapaProgram::closeSolution()
+{
+    m_solutionStream.reset();
+
+    if( m_solutionFile != NULL && m_solutionFile != stdout )
+    {
+        fclose( m_solutionFile );
+    }
+
+    m_solutionFile = NULL;
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initProgress()
+{
+    m_progress.setInterval( strtod( getOption( PROGRESS ).c_str(), NULL ) );
+
+    // Le fichier remplace l'erreur standard
+    if( isOption( PROGRESS_FILE ) )
+    {
+        m_progress.setStream( NULL );
+        m_progress.setFile( getOption( PROGRESS_FILE ) );
+    }
+    else
+    {
+        m_progress.setStream( &std::cerr );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initTrace()
+{
+    // Une trace d�j� ouverte, celle du serveur par exemple, est partag�e
+    if( isOption( TRACE_FILE ) && !Trace::isOpen() )
+    {
+        Trace::open( getOption( TRACE_FILE ) );
+        m_tracing = true;
+    }
+
+    if( isOption( DOCUMENT_LIST ) )
+    {
+        m_tracePair = getOption( DOCUMENT_LIST );
+
+        if( isOption( SHARD ) )
+        {
+            m_tracePair += " " + getOption( SHARD );
+        }
+    }
+    else if( !m_documents.empty() )
+    {
+        m_tracePair = m_documents[ 0 ].source;
+    }
+    else
+    {
+        m_tracePair.clear();
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initCorpus()
+{
+    // Les options qui influencent l'analyse des textes et les cognates
+    static const char KEY_OPTIONS[] = { INPUT_FORMAT, INPUT_COMPRESSION,
+                                        COGNATE, COGNATE_MIN_LENGTH,
+                                        COGNATE_PREFIX_LENGTH,
+                                        COGNATE_QGRAM_LENGTH,
+                                        COGNATE_MIN_RATIO };
+    CorpusCache cache;
+    std::string filename;
+    std::vector< size_t > sourceCounts;
+    std::vector< size_t > targetCounts;
+
+    if( !isOption( CORPUS_CACHE ) )
+    {
+        initText();
+        initCognate();
+
+        return;
+    }
+
+    for( size_t d = 0; d < m_documents.size(); d++ )
+    {
+        cache.addFile( m_documents[ d ].source );
+        cache.addFile( m_documents[ d ].target );
+    }
+
+    for( size_t k = 0; k < sizeof( KEY_OPTIONS ); k++ )
+    {
+        cache.addOption( getOption( KEY_OPTIONS[ k ] ) );
+    }
+
+    filename = cache.getFilename( getOption( CORPUS_CACHE ) );
+    setPtr( m_source, new Text() );
+    setPtr( m_target, new Text() );
+
+    if( cache.load( filename, *m_source, *m_target, 
+                    sourceCounts, targetCounts ) && 
+        sourceCounts.size() == m_documents.size() )
+    {
+        verbose( toString( "Loading parsed texts from cache : " ) + filename );
+
+        // Les paires de documents se suivent dans les textes
+        for( size_t d = 0; d < m_documents.size(); d++ )
+        {
+            m_documents[ d ].sourceBegin = d == 0 ? 0 : 
+                    m_documents[ d - 1 ].sourceBegin + sourceCounts[ d - 1 ];
+            m_documents[ d ].targetBegin = d == 0 ? 0 : 
+                    m_documents[ d - 1 ].targetBegin + targetCounts[ d - 1 ];
+            m_documents[ d ].sourceCount = sourceCounts[ d ];
+            m_documents[ d ].targetCount = targetCounts[ d ];
+        }
+
+        return;
+    }
+
+    // Le cache est absent ou p�rim� : les textes sont analys�s � nouveau
+    initText();
+    initCognate();
+
+    sourceCounts.clear();
+    targetCounts.clear();
+
+    for( size_t d = 0; d < m_documents.size(); d++ )
+    {
+        sourceCounts.push_back( m_documents[ d ].sourceCount );
+        targetCounts.push_back( m_documents[ d ].targetCount );
+    }
+
+    verbose( toString( "Saving parsed texts to cache : " ) + filename );
+    sortSynonyms();
+    cache.save( filename, *m_source, *m_target, sourceCounts, targetCounts );
+}
+
 // ------------------------------------------------------------------------ //
 void JapaProgram::initText()
 {
     char c;
-    std::auto_ptr< TextParser > srcTextParser;
-    std::auto_ptr< TextParser > tgtTextParser;
-    std::wifstream sourceStream;
-    std::wifstream targetStream;
+    std::string format;
+    JAPA_TRACE_SCOPE( "initText", m_tracePair );
+    MemoryUsage::Phase memory( "initText", getMemoryStream() );
 
-    // Tra�te le format de compression de l'entr�e
-    c = getOption( INPUT_COMPRESSION )[ 0 ];
+    setPtr( m_source, new Text() );
+    setPtr( m_target, new Text() );
 
+    // Chaque paire de documents est ajout�e � la suite des textes
+    for( size_t d = 0; d < m_documents.size(); d++ )
+    {
+        Document& document = m_documents[ d ];
+        std::auto_ptr< TextParser > srcTextParser( newTextParser( format ) );
+        std::auto_ptr< TextParser > tgtTextParser( newTextParser( format ) );
+        std::wifstream sourceStream;
+        std::wifstream targetStream;
+        size_t words;
+
+        if( d == 0 )
+        {
+            veryVerbose( "Input format : " + format );
+        }
+
+        // Tra�te le format de compression de l'entr�e
+        c = getOption( INPUT_COMPRESSION )[ 0 ];
+
+        switch( c )
+        {
+        case INPUT_COMPRESSION_NONE :
+            sourceStream.open( document.source.c_str() );
+            targetStream.open( document.target.c_str() );
+            break;
+
+        //case INPUT_COMPRESSION_GZIP :
+        //    gunzip( document.source, sourceStream );
+        //    gunzip( document.target, targetStream );
+        //    break;
+
+        default :
+            std::string desc( "Unknown input compression : " );
+            desc += c;
+            error( desc );
+            break;
+        }
+        
+        if( sourceStream.fail() )
+        {
+            // Erreur avec le fichier source
+            std::string desc( "Can't read file : " );
+            desc += document.source;
+            
+            error( desc );
+        } 
+
+        if( targetStream.fail() )
+        {
+            // Erreur avec le fichier cible
+            std::string desc( "Can't read file : " );
+            desc += document.target;
+
+            error( desc );
+        }
+
+        document.sourceBegin = m_source -> getSentenceCount();
+        document.targetBegin = m_target -> getSentenceCount();
+
+        verbose( "Parsing source" );
+        words = m_source -> getWordCount();
+        parseText( *srcTextParser, sourceStream, *m_source, 
+                   "Parsing source" );
+        document.sourceCount = m_source -> getSentenceCount() - 
+                               document.sourceBegin;
+
+        veryVerbose( std::string( "Source contains " ) + 
+                     toString( document.sourceCount ) + " sentences and " +
+                     toString( m_source -> getWordCount() - words ) + 
+                     " words." );
+        
+        verbose( "Parsing target" );
+        words = m_target -> getWordCount();
+        parseText( *tgtTextParser, targetStream, *m_target, 
+                   "Parsing target" );
+        document.targetCount = m_target -> getSentenceCount() - 
+                               document.targetBegin;
+        
+        veryVerbose( std::string( "Target contains " ) + 
+                     toString( document.targetCount ) + " sentences and " +
+                     toString( m_target -> getWordCount() - words ) + 
+                     " words." );
+
+        sourceStream.close();
+        targetStream.close();
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::parseText( TextParser& parser, std::wistream& in, 
+                             Text& text, const std::string& task )
+{
+    JAPA_TRACE_SCOPE( "parseText", m_tracePair );
+
+    // Le nombre de phrases n'est pas connu d'avance
+    m_progress.setTask( task );
+    m_progress.start( "sentences", 0 );
+    parser.setProgress( &m_progress );
+    parser( in, text );
+    m_progress.finish();
+}
+
+// ------------------------------------------------------------------------ //
+TextParser* JapaProgram::newTextParser( std::string& name )
+{
+    char c;
+
+    // Traite le format de l'entr�e
+    c = getOption( INPUT_FORMAT )[ 0 ];
+    
     switch( c )
     {
-    case INPUT_COMPRESSION_NONE :
-    	//cout << "le fichier 1 est " << getArgument( SOURCE_FILE ).c_str() << endl;
-    	//cout << "le fichier 2 est " << getArgument( TARGET_FILE ).c_str() << endl;
-        sourceStream.open( getArgument( SOURCE_FILE ).c_str() );
-        targetStream.open( getArgument( TARGET_FILE ).c_str() );
+    case INPUT_FORMAT_ARCADE :
+        // Format arcade
+        name = "ARCADE";
+        return new ArcadeParser();
+
+    case INPUT_FORMAT_CESANA :
+        // Format cesana
+        name = "CESANA";
+        return new CesanaParser();
+    
+    case INPUT_FORMAT_OSPL :
+        // Format une phrase par ligne
+        name = "ONE SENTENCE PER LINE";
+        return new OneSentPerLineParser();
+        
+    case INPUT_FORMAT_RALI :
+        // Format RALI
+        name = "RALI ( GLM )";
+        return new RaliParser();
+        
+    default :
+        std::string desc( "Unknown input format : " );
+        desc += c;
+        error( desc );
+        break;    
+    }
+
+    return NULL;
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initCognate()
+{
+    char c;
+    JAPA_TRACE_SCOPE( "initCognate", m_tracePair );
+    MemoryUsage::Phase memory( "initCognate", getMemoryStream() );
+    
+    // Traite le type de cognates
+    c = getOption( COGNATE )[ 0 ];
+    verbose( "Finding cognates" );
+
+    switch( c )
+    {
+    case COGNATE_NONE :
+        // Aucun cognate, rien � faire.
+        veryVerbose( "Cognate mode : NONE" );
         break;
 
-    //case INPUT_COMPRESSION_GZIP :
-    //    gunzip( getArgument( SOURCE_FILE ), sourceStream );
-    //    gunzip( getArgument( TARGET_FILE ), targetStream );
-    //    break;
+    case COGNATE_PREFIX :
+        // Cognate de type pr�fixe
+        veryVerbose( "Cognate mode : PREFIX" );
+        initCognatePrefix();    
+        break;
+    
+    case COGNATE_QGRAM :
+        // Cognate par LCSR sur les candidats q-grammes
+        veryVerbose( "Cognate mode : QGRAM" );
+        initCognateQGram();
+        break;
+    
+    case COGNATE_WORD :
+        // Cognate au niveau des mots
+        veryVerbose( "Cognate mode : WORD" );
+        initCognateWord();
+        break;
 
     default :
-        std::string desc( "Unknown input compression : " );
+        std::string desc( "Unknown cognate option : " );
         desc += c;
         error( desc );
-        break;
+        break;    
     }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initCognateValidator( CognateValidator& cv )
+{
+    int minLength;
+     
+    // Initialise la longueur minimale d'un cognate
+    minLength = atoi( getOption( COGNATE_MIN_LENGTH ).c_str() );
+    veryVerbose( toString( "Cognate minimum length : " ) + 
+                 toString( minLength ) );
+
+    cv.setMinLength( minLength );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initCognateWord()
+{
+    CognateValidator cv;
+    WordCognateFinder wcf;
+
+    initCognateValidator( cv );
     
-    if( sourceStream.fail() )
+    wcf( *m_source, *m_target, cv );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initSynonymDictionaries()
+{
+    OptionList ol = getOptionList( SYNONYM_DICTIONARY );
+    OptionList::const_iterator iter;
+    std::string filename;
+    BitextSynonymContainer bsc( m_source -> getDictionary(), 
+            m_target -> getDictionary() );    
+    JapaSynonymParser parser;
+    JAPA_TRACE_SCOPE( "initSynonymDictionaries", m_tracePair );
+    MemoryUsage::Phase memory( "initSynonymDictionaries", 
+                               getMemoryStream() );
+    
+    // Pour chaque alignement sp�cifi�
+    for( iter = ol.begin(); iter != ol.end(); iter++ )
     {
-        // Erreur avec le fichier source
-        std::string desc( "Can't read file : " );
-        desc += getArgument( SOURCE_FILE );
+        filename = *iter;
         
-        error( desc );
-    } 
+        if( BinaryLexicon::isBinaryLexicon( filename ) )
+        {
+            // Lexique compil� : seul le vocabulaire des textes est parcouru
+            BinaryLexicon lexicon;
+            size_t count;
+
+            veryVerbose( toString( "Mapping compiled synonym dictionary : " ) +
+                         filename );
+            lexicon.open( filename );
+            count = lexicon.addSynonyms( m_source -> getDictionary(), 
+                                         m_target -> getDictionary() );
+            veryVerbose( toString( count ) + " synonym pairs found in " + 
+                         toString( lexicon.getSourceCount() ) + 
+                         " source entries" );
+        }
+        else
+        {
+            std::wifstream in;
 
-    if( targetStream.fail() )
+            veryVerbose( toString("Parsing synonym dictionary : " ) + 
+                         filename );
+            in.open( filename.c_str() );
+
+            if( in.fail() )
+            {
+                error( toString("Can't open synonym dictionary : " ) + 
+                       filename );
+            }
+            
+            parser( in, bsc );
+        }
+    }
+
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::addSynonyms( const SynonymList& synonyms )
+{
+    BitextSynonymContainer bsc( m_source -> getDictionary(), 
+                                m_target -> getDictionary() );
+
+    for( size_t i = 0; i < synonyms.size(); i++ )
     {
-        // Erreur avec le fichier cible
-        std::string desc( "Can't read file : " );
-        desc += getArgument( TARGET_FILE );
+        std::wstring sourceWord( synonyms[ i ].first );
+        std::wstring targetWord( synonyms[ i ].second );
 
-        error( desc );
+        bsc.addSynonyms( sourceWord, targetWord );
     }
+}
 
-    
-    setPtr( m_source, new Text() );
-    setPtr( m_target, new Text() );
+// ------------------------------------------------------------------------ //
+void JapaProgram::sortSynonyms()
+{
+    TextDictionary::iterator iter;
 
-    // Traite le format de l'entr�e
-    c = getOption( INPUT_FORMAT )[ 0 ];
-    
-    switch( c )
+    for( iter = m_source -> getDictionary().begin(); 
+         iter != m_source -> getDictionary().end(); iter++ )
+    {
+        iter -> second.sortSynonyms();
+    }
+
+    for( iter = m_target -> getDictionary().begin(); 
+         iter != m_target -> getDictionary().end(); iter++ )
+    {
+        iter -> second.sortSynonyms();
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initAligner()
+{
+    JAPA_TRACE_SCOPE( "initAligner", m_tracePair );
+    MemoryUsage::Phase memory( "initAligner", getMemoryStream() );
+
+    // Toutes les sources de synonymes ont �t� parcourues
+    sortSynonyms();
+    initSearchSpace();
+    initAnchors();
+    initTable();
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::solve( SolutionPrinter< double >::Solution& solution )
+{
+    // Remplit l'espace de recherche
+    verbose( "Filling search space" );
+    fillSearchSpace();
+
+    // Se rabat sur une configuration moins co�teuse plut�t que de manquer
+    // de m�moire
+    {
+        JAPA_TRACE_SCOPE( "planTable", m_tracePair );
+        MemoryUsage::Phase memory( "planTable", getMemoryStream() );
+
+        while( !planTable() )
+        {
+            if( !fallBack( "the memory estimate" ) )
+            {
+                error( "No dynamic table fits the memory limit of " + 
+                       getOption( MAX_MEMORY ) + " MB" );
+            }
+
+            // Le nouvel espace doit aussi respecter les budgets
+            fillSearchSpace();
+        }
+    }
+
+    if( isOption( PRECOMPUTE_COSTS ) )
+    {
+        JAPA_TRACE_SCOPE( "precomputeCosts", m_tracePair );
+        MemoryUsage::Phase memory( "precomputeCosts", getMemoryStream() );
+
+        verbose( "Computing transition costs" );
+        m_scoreFunction -> precomputeCosts( *m_searchSpace );
+    }
+
+    // Aligne les phrases
+    {
+        JAPA_TRACE_SCOPE( "solve", m_tracePair );
+        MemoryUsage::Phase memory( "solve", getMemoryStream() );
+
+        verbose( "Finding best alignment" );
+        m_progress.setTask( "Finding best alignment" );
+        m_dynamicTable -> setProgress( &m_progress );
+        m_dynamicTable -> solve();
+    }
+
+    if( m_dynamicTable -> getPruningMargin() > 0 )
+    {
+        verbose( toString( "Pruned cells : " ) + 
+                 toString( m_dynamicTable -> getPrunedCount() ) );
+
+        if( m_dynamicTable -> hasFallenBack() )
+        {
+            verbose( "Pruning lost the path, solved without pruning" );
+        }
+    }
+
+    // Remonte le chemin de la solution
+    {
+        JAPA_TRACE_SCOPE( "traceback", m_tracePair );
+        MemoryUsage::Phase memory( "traceback", getMemoryStream() );
+        DynamicTable< double >::Iterator iter = 
+                m_dynamicTable -> getIterator();
+
+        solution = buildAlignment< double >( iter );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::fillSearchSpace()
+{
+    size_t cellBudget = strtoul( getOption( CELL_BUDGET ).c_str(), NULL, 10 );
+    size_t wordBudget = strtoul( getOption( WORD_BUDGET ).c_str(), NULL, 10 );
+    size_t cost;
+    JAPA_TRACE_SCOPE( "fillSearchSpace", m_tracePair );
+    MemoryUsage::Phase memory( "fillSearchSpace", getMemoryStream() );
+
+    // Les points des mots sont estim�s avant d'�tre align�s
+    if( wordBudget > 0 && m_cognateFiller != NULL )
     {
-    case INPUT_FORMAT_ARCADE :
-        // Format arcade
-        veryVerbose( "Input format : ARCADE" );
-        setPtr( srcTextParser, new ArcadeParser() );
-        setPtr( tgtTextParser, new ArcadeParser() );
-        break;
+        cost = getWordCost();
+        veryVerbose( toString( "Estimated word points : " ) + 
+                     toString( cost ) );
 
-    case INPUT_FORMAT_CESANA :
-        // Format cesana
-        veryVerbose( "Input format : CESANA" );
-        setPtr( srcTextParser, new CesanaParser() );
-        setPtr( tgtTextParser, new CesanaParser() );
-        break;
-    
-    case INPUT_FORMAT_OSPL :
-        // Format une phrase par ligne
-        veryVerbose( "Input format : ONE SENTENCE PER LINE" );
-        setPtr( srcTextParser, new OneSentPerLineParser() );
-        setPtr( tgtTextParser, new OneSentPerLineParser() );
-        break;
-        
-    case INPUT_FORMAT_RALI :
-        // Format RALI
-        veryVerbose( "Input format : RALI ( GLM )" );
-        setPtr( srcTextParser, new RaliParser() );
-        setPtr( tgtTextParser, new RaliParser() );
-        break;
-        
-    default :
-        std::string desc( "Unknown input format : " );
-        desc += c;
-        error( desc );
-        break;    
+        if( cost > wordBudget )
+        {
+            fallBack( toString( cost ) + " word points" );
+        }
     }
 
-    verbose( "Parsing source" );
-    ( *srcTextParser )( sourceStream, *m_source );
+    ( *m_SSFiller )( *m_searchSpace );
 
-    veryVerbose( std::string( "Source contains " ) + 
-                 toString( m_source -> getSentenceCount() ) +
-                 " sentences and " + toString( m_source -> getWordCount() ) +
-                 " words." );
-    
-    verbose( "Parsing target" );
-    ( *tgtTextParser )( targetStream, *m_target );
-    
-    veryVerbose( std::string( "Target contains " ) + 
-                 toString( m_target -> getSentenceCount() ) +
-                 " sentences and " + toString( m_target -> getWordCount() ) +
-                 " words." );
+    while( cellBudget > 0 )
+    {
+        cost = getCellCost();
+        veryVerbose( toString( "Search space cells : " ) + toString( cost ) );
+
+        if( cost <= cellBudget )
+        {
+            break;
+        }
+
+        if( !fallBack( toString( cost ) + " cells" ) )
+        {
+            verbose( "No cheaper configuration, solving over budget" );
+
+            // La cascade n'a pas r�solu sa premi�re passe hors budget
+            if( m_cascade != NULL && m_cascade -> getWideCells() > cellBudget )
+            {
+                m_cascade -> setMaxCells( 0, m_cellCounter );
+                ( *m_SSFiller )( *m_searchSpace );
+            }
+
+            break;
+        }
 
-    sourceStream.close();
-    targetStream.close();
+        ( *m_SSFiller )( *m_searchSpace );
+    }
 }
 
 // ------------------------------------------------------------------------ //
-void JapaProgram::initCognate()
+bool JapaProgram::planTable()
 {
-    char c;
-    
-    // Traite le type de cognates
-    c = getOption( COGNATE )[ 0 ];
-    verbose( "Finding cognates" );
+    const size_t megabyte = 1024 * 1024;
+    size_t limit = strtoul( getOption( MAX_MEMORY ).c_str(), NULL, 10 );
+    double margin = m_dynamicTable -> getPruningMargin();
+    size_t costs = 0;
+    size_t hashMemory;
+    size_t bandMemory;
+    size_t wideMemory;
+    std::auto_ptr< DynamicTable< double > > band( 
+            new SparseDT< double, BandMatrix >( *m_searchSpace, 
+                                                *m_scoreFunction ) );
+    std::auto_ptr< DynamicTable< double > > hash( 
+            new SparseDT< double >( *m_searchSpace, *m_scoreFunction ) );
 
-    switch( c )
+    band -> setPruningMargin( margin );
+    hash -> setPruningMargin( margin );
+
+    // Les co�ts calcul�s d'avance s'ajoutent � l'une ou l'autre table
+    if( isOption( PRECOMPUTE_COSTS ) )
     {
-    case COGNATE_NONE :
-        // Aucun cognate, rien � faire.
-        veryVerbose( "Cognate mode : NONE" );
-        break;
+        costs = m_scoreFunction -> estimateCostMemory( *m_searchSpace );
+    }
 
-    case COGNATE_PREFIX :
-        // Cognate de type pr�fixe
-        veryVerbose( "Cognate mode : PREFIX" );
-        initCognatePrefix();    
-        break;
-    
-    case COGNATE_WORD :
-        // Cognate au niveau des mots
-        veryVerbose( "Cognate mode : WORD" );
-        initCognateWord();
-        break;
+    bandMemory = costs + band -> estimateMemory();
+    hashMemory = costs + hash -> estimateMemory();
 
-    default :
-        std::string desc( "Unknown cognate option : " );
-        desc += c;
-        error( desc );
-        break;    
+    veryVerbose( "Estimated memory : band table " + 
+                 toString( ( bandMemory + megabyte - 1 ) / megabyte ) + 
+                 " MB, hash table " +
+                 toString( ( hashMemory + megabyte - 1 ) / megabyte ) + 
+                 " MB" );
+
+    // La table de la premi�re passe de la cascade est lib�r�e avant la
+    // table finale, mais elle doit aussi tenir dans la limite
+    if( m_cascade != NULL )
+    {
+        wideMemory = m_cascade -> getWideMemory();
+        veryVerbose( "Estimated memory : cascade table " + 
+                     toString( ( wideMemory + megabyte - 1 ) / megabyte ) + 
+                     " MB" );
+
+        if( limit > 0 && wideMemory > limit * megabyte )
+        {
+            return false;
+        }
+    }
+
+    // La table par bandes est la plus rapide ; sans limite, elle n'est
+    // �cart�e que si elle occupe plus que la table de hachage
+    if( limit == 0 ? bandMemory <= hashMemory : 
+                     bandMemory <= limit * megabyte )
+    {
+        veryVerbose( "Dynamic table : BAND" );
+        setPtr( m_dynamicTable, band.release() );
+    }
+    else if( limit == 0 || hashMemory <= limit * megabyte )
+    {
+        veryVerbose( "Dynamic table : HASH" );
+        setPtr( m_dynamicTable, hash.release() );
+    }
+    else
+    {
+        return false;
     }
+
+    return true;
 }
 
 // ------------------------------------------------------------------------ //
-void JapaProgram::initCognateValidator( CognateValidator& cv )
+bool JapaProgram::fallBack( const std::string& reason )
 {
-    int minLength;
-     
-    // Initialise la longueur minimale d'un cognate
-    minLength = atoi( getOption( COGNATE_MIN_LENGTH ).c_str() );
-    veryVerbose( toString( "Cognate minimum length : " ) + 
-                 toString( minLength ) );
+    int radius = atoi( getOption( BEAM_RADIUS ).c_str() );
+    std::string fallback;
 
-    cv.setMinLength( minLength );
+    // Du plus pr�cis au moins co�teux
+    if( getOption( SEARCH_SPACE )[ 0 ] != SEARCH_SPACE_BEAM )
+    {
+        setOption( SEARCH_SPACE, SEARCH_SPACE_BEAM );
+        fallback = "beam search space";
+    }
+    else if( radius > 1 )
+    {
+        radius /= 2;
+        setOption( BEAM_RADIUS, toString( radius, std::locale::classic() ) );
+        fallback = "beam radius " + toString( radius );
+    }
+    else if( getOption( SCORE_FUNCTION )[ 0 ] != SCORE_FUNCTION_CHURCH_GALE )
+    {
+        setOption( SCORE_FUNCTION, SCORE_FUNCTION_CHURCH_GALE );
+        fallback = "length-only score";
+    }
+    else
+    {
+        return false;
+    }
+
+    verbose( "Budget exceeded by " + reason + ", falling back to " + 
+             fallback );
+    initAligner();
+
+    return true;
 }
 
 // ------------------------------------------------------------------------ //
-void JapaProgram::initCognateWord()
+size_t JapaProgram::getCellCost() const
 {
-    CognateValidator cv;
-    WordCognateFinder wcf;
+    size_t cost = m_cellCounter( *m_searchSpace );
 
-    initCognateValidator( cv );
-    
-    wcf( *m_source, *m_target, cv );
+    // La premi�re passe de la cascade est r�solue sur l'espace large
+    if( m_cascade != NULL )
+    {
+        cost = std::max( cost, m_cascade -> getWideCells() );
+    }
+
+    return cost;
 }
 
 // ------------------------------------------------------------------------ //
-void JapaProgram::initSynonymDictionaries()
+size_t JapaProgram::getWordCost() const
 {
-    OptionList ol = getOptionList( SYNONYM_DICTIONARY );
-    OptionList::const_iterator iter;
-    std::string filename;
-    BitextSynonymContainer bsc( m_source -> getDictionary(), 
-            m_target -> getDictionary() );    
-    JapaSynonymParser parser;
-    std::wifstream in;
-    
-    // Pour chaque alignement sp�cifi�
-    for( iter = ol.begin(); iter != ol.end(); iter++ )
+    size_t cost = 0;
+    size_t begin;
+    size_t end;
+    size_t last;
+
+    for( size_t d = 0; d < m_documents.size(); d++ )
     {
-        filename = *iter;
-        
-        veryVerbose( toString("Parsing synonym dictionary : " ) + filename );
-        in.open( filename.c_str() );
+        const Document& document = m_documents[ d ];
 
-        if( in.fail() )
+        if( document.sourceCount == 0 )
         {
-            error( toString("Can't open synonym dictionary : " ) + filename );
+            continue;
         }
-            
-        parser( in, bsc );
+
+        m_source -> getSentenceBounds( document.sourceBegin, begin, last );
+        m_source -> getSentenceBounds( document.sourceBegin + 
+                                       document.sourceCount - 1, last, end );
+
+        cost = std::max( cost, m_cognateFiller -> estimatePoints( begin, 
+                                                                  end ) );
     }
 
+    return cost;
 }
 
 // ------------------------------------------------------------------------ //
@@ -377,6 +1267,43 @@ void JapaProgram::initCognatePrefix()
     pcf( *m_source, *m_target, cv );
 }
 
+// ------------------------------------------------------------------------ //
+void JapaProgram::initCognateQGram()
+{
+    CognateValidator cv;
+    int qgramLength;
+    double minRatio;
+    QGramCognateFinder qcf;
+    
+    // Trouve la longueur des q-grammes et le LCSR minimal
+    qgramLength = atoi( getOption( COGNATE_QGRAM_LENGTH ).c_str() );
+    minRatio = strtod( getOption( COGNATE_MIN_RATIO ).c_str(), NULL );
+
+    if( qgramLength <= 0 )
+    {
+        error( toString( "Invalid q-gram length : " ) + 
+               getOption( COGNATE_QGRAM_LENGTH ) );
+    }
+
+    // Un ratio est entre 0 et 1 ( la forme n�gative refuse aussi NaN )
+    if( !( minRatio >= 0.0 && minRatio <= 1.0 ) )
+    {
+        error( toString( "Invalid minimum LCSR : " ) + 
+               getOption( COGNATE_MIN_RATIO ) );
+    }
+
+    qcf.setQGramLength( qgramLength );
+    qcf.setMinRatio( minRatio );
+    
+    veryVerbose( toString( "Q-gram length : " ) + toString( qgramLength ) );
+    veryVerbose( toString( "Minimum LCSR : " ) + toString( minRatio ) );
+
+    initCognateValidator( cv );
+    
+    // Trouve les cognates
+    qcf( *m_source, *m_target, cv );
+}
+
 // ------------------------------------------------------------------------ //
 void JapaProgram::initSearchSpace()
 {
@@ -386,6 +1313,8 @@ void JapaProgram::initSearchSpace()
     const size_t tgtSize = m_target -> getSentenceCount();
     
     verbose( "Initialising search space" );
+    m_cognateFiller = NULL;
+    m_cascade = NULL;
     
     // Initialise l'espace de recherche
     setPtr( m_searchSpace, 
@@ -450,10 +1379,11 @@ void JapaProgram::initSearchSpaceCognate()
                  toString( maxFrequency ) );
 
     // Cr�e l'emplisseur de l'espace de recherche
-    setPtr( m_SSFiller, new CognateSSF( *m_source, *m_target, 
-                                        *m_solutionMarker, 
-                                        returnCount, returnCost, 
-                                        radius, maxFrequency ) );
+    m_cognateFiller = new CognateSSF( *m_source, *m_target, *m_solutionMarker,
+                                      returnCount, returnCost, 
+                                      radius, maxFrequency );
+    m_cognateFiller -> setProgress( &m_progress );
+    setPtr( m_SSFiller, m_cognateFiller );
     
 }
 
@@ -461,68 +1391,239 @@ void JapaProgram::initSearchSpaceCognate()
 void JapaProgram::initTable()
 {
     char c; 
-    double var; // La variance Church and Gale
-    double production;  // La production Church and Gale
-    double matchWeight; // Le poid du match de Church and Gale    
-    double penaltyWeight;   // Le poid de la p�nalit� de Church and Gale
+    double margin;  // La marge d'�lagage
     
     verbose( "Initialising resolution options" );
     
     // Ajuste la fonction de score utilis�e
     c = getOption( SCORE_FUNCTION )[ 0 ];
 
-    switch( c )
-    {
-    case SCORE_FUNCTION_FELIPE :
-        // Fonction de score Felipe
-        veryVerbose( "Score function : FELIPE" );
-        initScoreFelipe();
-        break;
+    switch( c )
+    {
+    case SCORE_FUNCTION_FELIPE :
+        // Fonction de score Felipe
+        veryVerbose( "Score function : FELIPE" );
+        initScoreFelipe();
+        break;
+
+    case SCORE_FUNCTION_CHURCH_GALE :
+        // Fonction de score Gale & Church
+        veryVerbose( "Score function : GALE AND CHURCH" );
+        setPtr( m_scoreFunction, new ChurchGaleScore( *m_source, *m_target ) );
+        break;
+
+    default :
+        std::string desc( "Unknown score function : " );
+        desc += c;
+        error( desc );
+        break;
+    }    
+    
+    // Ajoute les possibilit�s d'alignements
+    initAlignments( *m_scoreFunction );
+    initChurchGaleParameters( *m_scoreFunction );
+    m_scoreFunction -> setAnchors( m_anchors );
+    
+    // Ajuste la table dynamique utilis�e
+    setPtr( m_dynamicTable, 
+            new SparseDT< double >( *m_searchSpace, *m_scoreFunction ) );
+
+    // Ajuste l'�lagage par anti-diagonale
+    margin = strtod( getOption( PRUNING_MARGIN ).c_str(), NULL );
+    veryVerbose( toString( "Pruning margin : " ) + toString( margin ) );
+    m_dynamicTable -> setPruningMargin( margin );
+
+    if( c == SCORE_FUNCTION_FELIPE )
+    {
+        initCascade();
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initChurchGaleParameters( ChurchGaleScore& score )
+{
+    double var; // La variance Church and Gale
+    double production;  // La production Church and Gale
+    double matchWeight; // Le poid du match de Church and Gale    
+    double penaltyWeight;   // Le poid de la p�nalit� de Church and Gale
+
+    // Ajuste la production pour le score Church and Gale
+    production = strtod( getOption( CHURCH_GALE_PRODUCTION ).c_str(), NULL );
+    veryVerbose( toString( "Source character production : " ) +
+                 toString( production ) );
+    score.setProduction( production );
+    
+    // Ajuste la variance pour le score Church and Gale
+    var = strtod( getOption( CHURCH_GALE_VARIANCE ).c_str(), NULL );
+    veryVerbose( toString( "Sentences length variance : " ) + toString( var ) );
+    score.setVariance( var );
+
+    // Ajuste le poid du match
+    matchWeight = strtod( getOption( CHURCH_GALE_MATCH ).c_str(), NULL );
+    veryVerbose( toString( "Match weight : " ) + toString( matchWeight ) );
+    score.setMatchWeight( matchWeight );
+
+    // Ajuste le poid de la p�nalit�
+    penaltyWeight = strtod( getOption( CHURCH_GALE_PENALTY ).c_str(), NULL );
+    veryVerbose( toString( "Penalty weight : " ) + toString( penaltyWeight ) );
+    score.setPenaltyWeight( penaltyWeight );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initCascade()
+{
+    const size_t megabyte = 1024 * 1024;
+    int radius = atoi( getOption( CASCADE_RADIUS ).c_str() );
+    size_t limit = strtoul( getOption( MAX_MEMORY ).c_str(), NULL, 10 );
+
+    // Un rayon nul d�sactive la cascade
+    if( radius <= 0 )
+    {
+        return;
+    }
+
+    veryVerbose( std::string( "Cascade corridor radius : " ) + 
+                 toString( radius ) );
+
+    setPtr( m_cascadeScore, new ChurchGaleScore( *m_source, *m_target ) );
+    initAlignments( *m_cascadeScore );
+    initChurchGaleParameters( *m_cascadeScore );
+    m_cascadeScore -> setAnchors( m_anchors );
+
+    // L'emplisseur choisi remplit l'espace large de la premi�re passe ; la
+    // passe Felipe n'utilise que le corridor autour du chemin trouv�.
+    setPtr( m_cascadeMarker, new ConstantBeamMarker( radius ) );
+    m_cascadeFiller = m_SSFiller;
+    m_cascade = new CascadeSSF( *m_cascadeFiller, *m_cascadeScore,
+                                *m_cascadeMarker );
+    m_cascade -> setMaxMemory( limit * megabyte );
+    m_cascade -> setMaxCells( strtoul( getOption( CELL_BUDGET ).c_str(), 
+                                       NULL, 10 ), m_cellCounter );
+    setPtr( m_SSFiller, m_cascade );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initAnchors()
+{
+    OptionList ol = getOptionList( ANCHOR_FILE );
+    OptionList::const_iterator iter;
+
+    m_anchors = Anchors();
+
+    // Les divisions commencent ensemble un segment dans les deux textes
+    if( isOption( ANCHOR_DIVISIONS ) )
+    {
+        if( m_source -> getDivisionCount() != m_target -> getDivisionCount() )
+        {
+            error( "The source and target texts don't have the same number "
+                   "of divisions" );
+        }
+
+        for( size_t d = 1; d < m_source -> getDivisionCount(); d++ )
+        {
+            addAnchor( m_source -> getDivisionBegin( d ), 
+                       m_target -> getDivisionBegin( d ) );
+        }
+    }
+
+    for( iter = ol.begin(); iter != ol.end(); iter++ )
+    {
+        readAnchors( *iter );
+    }
+
+    if( m_anchors.isEmpty() )
+    {
+        return;
+    }
+
+    veryVerbose( toString( "Anchor points : " ) + 
+                 toString( m_anchors.size() ) );
+
+    // L'emplisseur choisi est contraint par les points d'ancrage
+    m_anchorFiller = m_SSFiller;
+    setPtr( m_SSFiller, new AnchorSSF( *m_anchorFiller, *m_solutionMarker,
+                                       m_anchors ) );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::readAnchors( const std::string& filename )
+{
+    std::map< std::wstring, size_t > sourceIDs;
+    std::map< std::wstring, size_t > targetIDs;
+    std::map< std::wstring, size_t >::const_iterator source;
+    std::map< std::wstring, size_t >::const_iterator target;
+    std::wifstream in;
+    std::wstring line;
+    std::wstring sourceID;
+    std::wstring targetID;
+    size_t lineNumber = 0;
+
+    veryVerbose( toString( "Parsing anchor file : " ) + filename );
+    in.open( filename.c_str() );
+
+    if( in.fail() )
+    {
+        error( toString( "Can't open anchor file : " ) + filename );
+    }
+
+    for( size_t i = 0; i < m_source -> getSentenceCount(); i++ )
+    {
+        sourceIDs[ m_source -> getSentenceID( i ) ] = i;
+    }
+
+    for( size_t i = 0; i < m_target -> getSentenceCount(); i++ )
+    {
+        targetIDs[ m_target -> getSentenceID( i ) ] = i;
+    }
+
+    while( getline( in, line ) )
+    {
+        std::wistringstream linestream( line );
+
+        lineNumber++;
+
+        // Les lignes vides sont ignor�es
+        if( !( linestream >> sourceID ) )
+        {
+            continue;
+        }
+
+        source = sourceIDs.find( sourceID );
+        target = ( linestream >> targetID ) ? targetIDs.find( targetID ) :
+                                              targetIDs.end();
+
+        if( source == sourceIDs.end() || target == targetIDs.end() )
+        {
+            error( toString( "Unknown sentence ID in anchor file " ) + 
+                   filename + " at line " + toString( lineNumber ) );
+        }
 
-    case SCORE_FUNCTION_CHURCH_GALE :
-        // Fonction de score Gale & Church
-        veryVerbose( "Score function : GALE AND CHURCH" );
-        setPtr( m_scoreFunction, new ChurchGaleScore( *m_source, *m_target ) );
-        break;
+        addAnchor( source -> second, target -> second );
+    }
+}
 
-    default :
-        std::string desc( "Unknown score function : " );
-        desc += c;
-        error( desc );
-        break;
-    }    
-    
-    // Ajoute les possibilit�s d'alignements
-    initAlignments();
-    
-    // Ajuste la production pour le score Church and Gale
-    production = strtod( getOption( CHURCH_GALE_PRODUCTION ).c_str(), NULL );
-    veryVerbose( toString( "Source character production : " ) +
-                 toString( production ) );
-    m_scoreFunction -> setProduction( production );
-    
-    // Ajuste la variance pour le score Church and Gale
-    var = strtod( getOption( CHURCH_GALE_VARIANCE ).c_str(), NULL );
-    veryVerbose( toString( "Sentences length variance : " ) + toString( var ) );
-    m_scoreFunction -> setVariance( var );
+// ------------------------------------------------------------------------ //
+void JapaProgram::addAnchor( const size_t source, const size_t target )
+{
+    // Le d�but des textes est toujours un point de passage
+    if( source == 0 && target == 0 )
+    {
+        return;
+    }
 
-    // Ajuste le poid du match
-    matchWeight = strtod( getOption( CHURCH_GALE_MATCH ).c_str(), NULL );
-    veryVerbose( toString( "Match weight : " ) + toString( matchWeight ) );
-    m_scoreFunction -> setMatchWeight( matchWeight );
+    // Aucun alignement ne m�ne aux cases de la premi�re ligne ou colonne
+    if( source == 0 || target == 0 )
+    {
+        error( toString( "An anchor can't begin only one of the texts : " ) +
+               toString( source + 1 ) + " " + toString( target + 1 ) );
+    }
 
-    // Ajuste le poid de la p�nalit�
-    penaltyWeight = strtod( getOption( CHURCH_GALE_PENALTY ).c_str(), NULL );
-    veryVerbose( toString( "Penalty weight : " ) + toString( penaltyWeight ) );
-    m_scoreFunction -> setPenaltyWeight( penaltyWeight );
-    
-    // Ajuste la table dynamique utilis�e
-    setPtr( m_dynamicTable, 
-            new SparseDT< double >( *m_searchSpace, *m_scoreFunction ) );
+    // L'ancre se trouve sur la case qui termine le segment pr�c�dent
+    m_anchors.add( source - 1, target - 1 );
 }
 
 // ------------------------------------------------------------------------ //
-void JapaProgram::initAlignments()
+void JapaProgram::initAlignments( ChurchGaleScore& score )
 {
     int sourceLength;
     int targetLength;
@@ -538,7 +1639,7 @@ void JapaProgram::initAlignments()
 
         str >> sourceLength >> sep >> targetLength >> sep >> prob;
         
-        m_scoreFunction -> addAlignment( sourceLength, targetLength, prob );
+        score.addAlignment( sourceLength, targetLength, prob );
         
         veryVerbose( toString( "Alignment added : " ) +
                      toString( sourceLength ) + "-" + 
@@ -627,7 +1728,7 @@ void JapaProgram::initScoreFelipe()
 }
 
 // ------------------------------------------------------------------------ //
-void JapaProgram::initPrinter()
+void JapaProgram::initPrinter( const Document& document )
 {
     char c;
     
@@ -641,17 +1742,27 @@ void JapaProgram::initPrinter()
     case OUTPUT_FORMAT_ARCADE :
         // Format de sortie arcade
         veryVerbose( "Output format : ARCADE" );
-        setPtr( m_solutionPrinter, new ArcadePrinter< double >( *m_source, *m_target ) );
+        {
+            ArcadePrinter< double >* printer = 
+                    new ArcadePrinter< double >( *m_source, *m_target );
+
+            printer -> setOrigin( document.sourceBegin, document.targetBegin );
+            setPtr( m_solutionPrinter, printer );
+        }
         break;
 
     case OUTPUT_FORMAT_CESALIGN :
         // Format de sortie CesAlign
         veryVerbose( "Output format  : CESALIGN" );
-        setPtr( m_solutionPrinter,
-                new CesalignPrinter< double >( *m_source, *m_target,
-                		strToWstr(getArgument( SOURCE_FILE )),
-                		strToWstr(getArgument( TARGET_FILE ))
-                		));
+        {
+            CesalignPrinter< double >* printer = 
+                    new CesalignPrinter< double >( *m_source, *m_target,
+                            strToWstr( document.source ),
+                            strToWstr( document.target ) );
+
+            printer -> setOrigin( document.sourceBegin, document.targetBegin );
+            setPtr( m_solutionPrinter, printer );
+        }
         break;
         
     //case OUTPUT_FORMAT_FRIENDLY :
@@ -671,8 +1782,20 @@ void JapaProgram::initPrinter()
         // Format de sortie Score
         veryVerbose( "Output format  : SCORE" );
         setPtr( m_solutionPrinter,
-                new ScorePrinter< double >( strToWstr(getArgument( SOURCE_FILE )),
-                		strToWstr(getArgument( TARGET_FILE )) ) );
+                new ScorePrinter< double >( strToWstr( document.source ),
+                                            strToWstr( document.target ) ) );
+        break;
+
+    case OUTPUT_FORMAT_TSV :
+        // Bitexte align� en colonnes
+        veryVerbose( "Output format  : TSV" );
+        initBitextPrinter( document, false );
+        break;
+
+    case OUTPUT_FORMAT_JSONL :
+        // Bitexte align� en JSON
+        veryVerbose( "Output format  : JSONL" );
+        initBitextPrinter( document, true );
         break;
 
     default :
@@ -683,6 +1806,466 @@ void JapaProgram::initPrinter()
     }
 }
 
+// ------------------------------------------------------------------------ //
+void JapaProgram::initBitextPrinter( const Document& document, 
+                                     const bool json )
+{
+    if( getOption( INPUT_FORMAT )[ 0 ] != INPUT_FORMAT_OSPL )
+    {
+        std::string desc( "The aligned bitext output needs the input format " );
+        desc += INPUT_FORMAT_OSPL;
+        error( desc );
+    }
+
+    // Les textes align�s en m�moire sont d�j� rep�r�s
+    if( m_sourceMap.get() == NULL )
+    {
+        setPtr( m_sourceMap, new MappedText() );
+        setPtr( m_targetMap, new MappedText() );
+        m_sourceMap -> open( document.source );
+        m_targetMap -> open( document.target );
+    }
+
+    // Les lignes rep�r�es doivent correspondre aux phrases analys�es
+    if( m_sourceMap -> getSentenceCount() != document.sourceCount ||
+        m_targetMap -> getSentenceCount() != document.targetCount )
+    {
+        error( "The input files' lines don't match the parsed sentences" );
+    }
+
+    setPtr( m_solutionPrinter, 
+            new BitextPrinter< double >( *m_sourceMap, *m_targetMap, json ) );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::printSolution( 
+        const SolutionPrinter< double >::Solution& solution )
+{
+    JAPA_TRACE_SCOPE( "print", m_documents[ 0 ].source );
+    MemoryUsage::Phase memory( "printSolution", getMemoryStream() );
+
+    verbose( "Printing solution" );
+    ( *m_solutionPrinter )( *m_solutionStream, solution );
+
+    if( !m_solutionStream -> flush() )
+    {
+        error( "Can't write solution" );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::parseShard( size_t& shard, size_t& count )
+{
+    std::istringstream in( getOption( SHARD ) );
+    long first = 0;
+    long second = 0;
+    char separator = '/';
+
+    in.imbue( std::locale::classic() );
+
+    if( !( in >> first ) )
+    {
+        error( "Invalid shard : " + getOption( SHARD ) );
+    }
+
+    // Le num�ro du lot est facultatif pour la fusion
+    if( in.eof() )
+    {
+        second = first;
+        first = 0;
+    }
+    else if( !( in >> separator >> second ) || separator != '/' || 
+             !( in >> std::ws ).eof() )
+    {
+        error( "Invalid shard : " + getOption( SHARD ) );
+    }
+
+    if( second <= 0 || first > second || 
+        ( first < 1 && getOption( SHARD ).find( '/' ) != std::string::npos ) )
+    {
+        error( "Invalid shard : " + getOption( SHARD ) );
+    }
+
+    shard = first;
+    count = second;
+}
+
+// ------------------------------------------------------------------------ //
+size_t JapaProgram::getShard( const Document& document, 
+                              const size_t count ) const
+{
+    std::string key = document.source + '\0' + document.target;
+    uint64_t hash = 14695981039346656037ULL;
+
+    // FNV-1a sur les noms des fichiers, le m�me sur toutes les machines
+    for( size_t i = 0; i < key.size(); i++ )
+    {
+        hash = ( hash ^ ( unsigned char )key[ i ] ) * 1099511628211ULL;
+    }
+
+    return hash % count + 1;
+}
+
+// ------------------------------------------------------------------------ //
+std::string JapaProgram::getShardIndex( const size_t shard, 
+                                        const size_t count )
+{
+    const std::locale& classic = std::locale::classic();
+
+    return getOption( DOCUMENT_LIST ) + ".shard-" + 
+           toString( shard, classic ) + "-of-" + toString( count, classic );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::writeShardIndex()
+{
+    size_t shard;
+    size_t count;
+
+    parseShard( shard, count );
+
+    std::string filename = getShardIndex( shard, count );
+    std::string temporary = filename + ".tmp";
+    std::ofstream index( temporary.c_str() );
+
+    if( index.fail() )
+    {
+        error( "Can't write shard index : " + temporary );
+    }
+
+    index.imbue( std::locale::classic() );
+
+    for( size_t d = 0; d < m_documents.size(); d++ )
+    {
+        const Document& document = m_documents[ d ];
+
+        index << document.line << '\t' << document.sourceCount << '\t' 
+              << document.targetCount << '\t' << document.output << '\n';
+    }
+
+    index.close();
+
+    // Le renommage rend l'index visible d'un seul coup pour la fusion
+    if( index.fail() || 
+        std::rename( temporary.c_str(), filename.c_str() ) != 0 )
+    {
+        error( "Can't write shard index : " + filename );
+    }
+
+    verbose( "Shard " + toString( shard ) + " of " + toString( count ) + 
+             " aligned " + toString( m_documents.size() ) + " documents" );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::mergeShards()
+{
+    std::map< size_t, size_t > lines;    // Ligne de la liste -> paire
+    std::vector< bool > covered( m_documents.size(), false );
+    std::string filename = getOption( SHARD_MERGE );
+    std::ofstream file;
+    std::ostream* out = &std::cout;
+    size_t shard;
+    size_t count;
+
+    if( !isOption( SHARD ) )
+    {
+        error( "Merging needs the number of shards" );
+    }
+
+    parseShard( shard, count );
+
+    // La fusion lit les index de tous les lots : seul N a un sens
+    if( shard != 0 )
+    {
+        error( "Merging expects the number of shards alone, N : " + 
+               getOption( SHARD ) );
+    }
+
+    for( size_t d = 0; d < m_documents.size(); d++ )
+    {
+        lines[ m_documents[ d ].line ] = d;
+    }
+
+    // Chaque index doit couvrir exactement les paires de son lot
+    for( size_t k = 1; k <= count; k++ )
+    {
+        std::string indexName = getShardIndex( k, count );
+        std::ifstream index( indexName.c_str() );
+        std::string entry;
+
+        if( index.fail() )
+        {
+            error( "Can't open shard index : " + indexName );
+        }
+
+        while( getline( index, entry ) )
+        {
+            std::istringstream entryStream( entry );
+            std::map< size_t, size_t >::const_iterator found;
+            std::string output;
+            size_t line;
+            size_t sourceCount;
+            size_t targetCount;
+
+            entryStream.imbue( std::locale::classic() );
+
+            if( !( entryStream >> line >> sourceCount >> targetCount 
+                               >> output ) )
+            {
+                error( "Invalid shard index : " + indexName );
+            }
+
+            found = lines.find( line );
+
+            if( found == lines.end() || covered[ found -> second ] ||
+                m_documents[ found -> second ].output != output ||
+                getShard( m_documents[ found -> second ], count ) != k )
+            {
+                error( "Shard index " + indexName + 
+                       " doesn't match the document list at line " + 
+                       toString( line ) );
+            }
+
+            covered[ found -> second ] = true;
+        }
+    }
+
+    for( size_t d = 0; d < m_documents.size(); d++ )
+    {
+        if( !covered[ d ] )
+        {
+            error( "Document at line " + toString( m_documents[ d ].line ) + 
+                   " is missing from shard " + 
+                   toString( getShard( m_documents[ d ], count ) ) );
+        }
+    }
+
+    if( filename != "-" )
+    {
+        file.open( filename.c_str(), std::ios::binary );
+
+        if( file.fail() )
+        {
+            error( "Can't write merged solution to file : " + filename );
+        }
+
+        out = &file;
+    }
+
+    // Les solutions sont recopi�es telles quelles, dans l'ordre de la liste
+    for( size_t d = 0; d < m_documents.size(); d++ )
+    {
+        std::ifstream part( m_documents[ d ].output.c_str(), 
+                            std::ios::binary );
+
+        if( part.fail() )
+        {
+            error( "Can't open solution : " + m_documents[ d ].output );
+        }
+
+        veryVerbose( "Merging " + m_documents[ d ].output );
+
+        // Copier un fichier vide mettrait le flux en erreur
+        if( part.peek() != std::ifstream::traits_type::eof() )
+        {
+            ( *out ) << part.rdbuf();
+        }
+    }
+
+    if( !out -> flush() )
+    {
+        error( "Can't write merged solution" );
+    }
+
+    verbose( "Merged " + toString( m_documents.size() ) + 
+             " documents from " + toString( count ) + " shards" );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::initResults()
+{
+    std::map< uint64_t, size_t > aligned;   // Empreinte -> paire � aligner
+    std::vector< Document > documents;
+    ResultCache::Result result;
+    uint64_t optionsKey;
+    uint64_t sourceSize;
+    uint64_t targetSize;
+    size_t hits = 0;
+    size_t duplicates = 0;
+    uint64_t saved = 0;
+    bool normalize;
+    char format = getOption( OUTPUT_FORMAT )[ 0 ];
+
+    m_reused.clear();
+
+    if( !isOption( RESULT_CACHE ) )
+    {
+        return;
+    }
+
+    if( !isOption( DOCUMENT_LIST ) )
+    {
+        error( "The result cache needs a document list" );
+    }
+
+    verbose( "Looking up result cache" );
+    setPtr( m_results, new ResultCache( getOption( RESULT_CACHE ) ) );
+    optionsKey = getOptionsKey();
+
+    // Les sorties qui recopient le texte des phrases, ou un texte compress�,
+    // d�pendent des octets exacts des documents
+    normalize = format != OUTPUT_FORMAT_TSV && format != OUTPUT_FORMAT_JSONL &&
+                getOption( INPUT_COMPRESSION )[ 0 ] == INPUT_COMPRESSION_NONE;
+
+    for( size_t d = 0; d < m_documents.size(); d++ )
+    {
+        Document& document = m_documents[ d ];
+
+        document.key = ResultCache::hashFile( optionsKey, document.source, 
+                                              normalize, sourceSize );
+        document.key = ResultCache::hashFile( document.key, document.target,
+                                              normalize, targetSize );
+        document.size = sourceSize + targetSize;
+
+        // Ces sorties nomment les fichiers des documents
+        if( format == OUTPUT_FORMAT_CESALIGN || format == OUTPUT_FORMAT_SCORE )
+        {
+            document.key = ResultCache::hashValue( document.key, 
+                                                   document.source );
+            document.key = ResultCache::hashValue( document.key, 
+                                                   document.target );
+        }
+
+        if( m_results -> find( document.key, result ) )
+        {
+            hits++;
+        }
+        else if( aligned.find( document.key ) != aligned.end() )
+        {
+            duplicates++;
+        }
+        else
+        {
+            aligned[ document.key ] = documents.size();
+            documents.push_back( document );
+            continue;
+        }
+
+        saved += document.size;
+        m_reused.push_back( document );
+    }
+
+    m_documents.swap( documents );
+
+    verbose( "Result cache : " + toString( hits ) + " hits, " + 
+             toString( m_documents.size() ) + " misses, " + 
+             toString( duplicates ) + " duplicates, " + toString( saved ) + 
+             " input bytes saved" );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaProgram::finishResults()
+{
+    ResultCache::Result result;
+
+    if( m_results.get() == NULL )
+    {
+        return;
+    }
+
+    // Les solutions sont relues telles qu'elles ont �t� imprim�es
+    for( size_t d = 0; d < m_documents.size(); d++ )
+    {
+        const Document& document = m_documents[ d ];
+        std::ifstream in( document.output.c_str(), 
+                          std::ios::in | std::ios::binary );
+        std::ostringstream content;
+
+        if( in.fail() )
+        {
+            error( "Can't read solution : " + document.output );
+        }
+
+        if( in.peek() != std::ifstream::traits_type::eof() )
+        {
+            content << in.rdbuf();
+        }
+
+        result.sourceCount = document.sourceCount;
+        result.targetCount = document.targetCount;
+        result.output = content.str();
+        m_results -> add( document.key, result );
+    }
+
+    for( size_t d = 0; d < m_reused.size(); d++ )
+    {
+        Document& document = m_reused[ d ];
+        std::ofstream out( document.output.c_str(), 
+                           std::ios::out | std::ios::binary );
+
+        m_results -> find( document.key, result );
+        document.sourceCount = result.sourceCount;
+        document.targetCount = result.targetCount;
+
+        out.write( result.output.data(), result.output.size() );
+        out.close();
+
+        if( out.fail() )
+        {
+            error( "Can't write solution to file : " + document.output );
+        }
+    }
+
+    m_documents.insert( m_documents.end(), m_reused.begin(), m_reused.end() );
+    std::sort( m_documents.begin(), m_documents.end(), precedes );
+    m_reused.clear();
+}
+
+// ------------------------------------------------------------------------ //
+bool JapaProgram::precedes( const Document& left, const Document& right )
+{
+    return left.line < right.line;
+}
+
+// ------------------------------------------------------------------------ //
+uint64_t JapaProgram::getOptionsKey()
+{
+    // Les options sans effet sur la solution
+    static const char IGNORED[] = { CORPUS_CACHE, DOCUMENT_LIST, HELP, 
+                                    PROGRESS, PROGRESS_FILE, RESULT_CACHE,
+                                    SHARD, SHARD_MERGE, TRACE_FILE,
+                                    VERBOSE, VERY_VERBOSE, '\0' };
+    uint64_t key = ResultCache::EMPTY_KEY;
+    uint64_t size;
+
+    for( const char* option = OPTSTRING; *option != '\0'; option++ )
+    {
+        if( *option == ':' || strchr( IGNORED, *option ) != NULL )
+        {
+            continue;
+        }
+
+        OptionList ol = getOptionList( *option );
+        OptionList::const_iterator iter;
+
+        key = ResultCache::hashValue( key, std::string( 1, *option ) );
+
+        for( iter = ol.begin(); iter != ol.end(); iter++ )
+        {
+            if( *option == SYNONYM_DICTIONARY || *option == ANCHOR_FILE )
+            {
+                key = ResultCache::hashFile( key, *iter, false, size );
+            }
+            else
+            {
+                key = ResultCache::hashValue( key, *iter );
+            }
+        }
+    }
+
+    return key;
+}
+
 // ------------------------------------------------------------------------ //
 void JapaProgram::verbose( const std::string msg )
 {
@@ -701,4 +2284,10 @@ void JapaProgram::veryVerbose( const std::string msg )
     }
 }
 
+// ------------------------------------------------------------------------ //
+std::ostream* JapaProgram::getMemoryStream()
+{
+    return isOption( VERY_VERBOSE ) ? m_messagesStream : NULL;
+}
+
 }// namespace japa
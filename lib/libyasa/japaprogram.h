@@ -19,20 +19,34 @@ limitations under the License.
 #ifndef JAPA_JAPA_PROGRAM_H
 #define JAPA_JAPA_PROGRAM_H
 
+#include <cstdio>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "anchors.h"
+#include "cascadessf.h"
 #include "churchgalescore.h"
+#include "cognatessf.h"
 #include "cognatevalidator.h"
-#include "dynamictable.h"
 #include "japaoptions.h"
+#include "mappedtext.h"
+#include "memoryusage.h"
+#include "progress.h"
+#include "resultcache.h"
 #include "scorefunction.h"
 #include "searchspace.h"
 #include "searchspacefiller.h"
 #include "solutionmarker.h"
 #include "solutionprinter.h"
+#include "sparsedt.h"
+#include "synonymcontainer.h"
 #include "text.h"
 #include "textparser.h"
+#include "trace.h"
+#include "utf8writer.h"
 
 namespace japa
 {
@@ -67,172 +81,1004 @@ public :
      * \endenglish
      */     
     JapaProgram();
+
+    /**
+     * \french
+     * Constructeur.  Les options sont copi�es d'un autre ensemble d'options,
+     * auquel la ligne de commande peut ensuite s'ajouter.
+     *
+     * @param options Les options � copier.
+     * \endfrench
+     *
+     * \english
+     * Constructor.  The options are copied from another set of options, to
+     * which the command line can then be added.
+     *
+     * @param options The options to copy.
+     * \endenglish
+     */
+    JapaProgram( const JapaOptions& options );
+    
+    /**
+     * \french
+     * Destructeur.
+     * \endfrench
+     *
+     * \english
+     * Destructor.
+     * \endenglish
+     */
+    virtual ~JapaProgram();
+    
+    /**
+     * \french
+     * Aligne deux textes parall�les.
+     * \endfrench
+     *
+     * \english
+     * Align two parallel texts.
+     * \endenglish
+     */
+    void run();
+
+    /**
+     * \french
+     * Une liste de paires de synonymes, un mot source et un mot cible.
+     * \endfrench
+     *
+     * \english
+     * A list of synonym pairs, a source word and a target word.
+     * \endenglish
+     */
+    typedef std::vector< std::pair< std::wstring, std::wstring > > SynonymList;
+
+    /**
+     * \french
+     * Aligne deux textes d�j� en m�moire, sans lire ni �crire de fichier.
+     * Les textes sont lus dans le format d'entr�e des options ; les options
+     * qui nomment des fichiers, hormis les lexiques, sont ignor�es.
+     *
+     * @param source Le texte source.
+     * @param target Le texte cible.
+     * @param synonyms Des synonymes qui s'ajoutent aux lexiques.
+     * @param solution Re�oit la solution.
+     *
+     * @throw Exception Si une option est invalide.
+     * \endfrench
+     *
+     * \english
+     * Aligns two texts already in memory, without reading or writing any
+     * file.  The texts are read in the options' input format; the options
+     * naming files, except the lexicons, are ignored.
+     *
+     * @param source The source text.
+     * @param target The target text.
+     * @param synonyms Synonyms added to the lexicons.
+     * @param solution Receives the solution.
+     *
+     * @throw Exception If an option is invalid.
+     * \endenglish
+     */
+    void align( std::wistream& source, std::wistream& target,
+                const SynonymList& synonyms,
+                SolutionPrinter< double >::Solution& solution );
+
+    /**
+     * \french
+     * Aligne deux textes UTF-8 d�j� en m�moire et imprime la solution, dans
+     * le format de sortie des options, dans un flux d�j� ouvert.  Aucun
+     * fichier n'est lu ni �crit ; les noms des fichiers source et cible des
+     * arguments, s'il y en a, ne servent qu'aux formats qui les citent.
+     *
+     * @param source Le texte source.
+     * @param target Le texte cible.
+     * @param synonyms Des synonymes qui s'ajoutent aux lexiques.
+     * @param output Le flux qui re�oit la solution, qui reste ouvert.
+     *
+     * @throw Exception Si une option est invalide ou si la solution ne peut
+     *                  �tre �crite.
+     * \endfrench
+     *
+     * \english
+     * Aligns two UTF-8 texts already in memory and prints the solution, in
+     * the options' output format, to a stream already open.  No file is
+     * read or written; the source and target file names of the arguments,
+     * if any, are only used by the formats quoting them.
+     *
+     * @param source The source text.
+     * @param target The target text.
+     * @param synonyms Synonyms added to the lexicons.
+     * @param output The stream receiving the solution, which stays open.
+     *
+     * @throw Exception If an option is invalid or if the solution can't be
+     *                  written.
+     * \endenglish
+     */
+    void align( const std::string& source, const std::string& target,
+                const SynonymList& synonyms, std::FILE* output );
+    
+private :    
+    /**
+     * \french
+     * Une paire de documents � aligner et sa place dans les textes.
+     * \endfrench
+     *
+     * \english
+     * A pair of documents to align and its place in the texts.
+     * \endenglish
+     */
+    struct Document
+    {
+        std::string source;     /**< Le fichier source */
+        std::string target;     /**< Le fichier cible */
+        std::string output;     /**< Le fichier de la solution */
+        size_t sourceBegin;     /**< L'indice de la premi�re phrase source */
+        size_t targetBegin;     /**< L'indice de la premi�re phrase cible */
+        size_t sourceCount;     /**< Le nombre de phrases sources */
+        size_t targetCount;     /**< Le nombre de phrases cibles */
+        size_t line;            /**< La ligne dans la liste de documents */
+        uint64_t key;           /**< L'empreinte de la paire et des options */
+        uint64_t size;          /**< La taille des deux documents */
+    };
+
+    /**
+     * \french
+     * Initialise la liste des paires de documents, tir�e des arguments ou
+     * de la liste de documents.
+     * \endfrench
+     *
+     * \english
+     * Initializes the list of document pairs, taken from the arguments or
+     * from the document list.
+     * \endenglish
+     */
+    void initDocuments();
+
+    /**
+     * \french
+     * Un conteneur qui range les synonymes lus dans une liste.
+     * \endfrench
+     *
+     * \english
+     * A container storing the synonyms read in a list.
+     * \endenglish
+     */
+    class SynonymListContainer : public SynonymContainer< std::wstring >
+    {
+    public :
+        /**
+         * \french
+         * Constructeur.
+         *
+         * @param synonyms La liste qui re�oit les synonymes.
+         * \endfrench
+         *
+         * \english
+         * Constructor.
+         *
+         * @param synonyms The list receiving the synonyms.
+         * \endenglish
+         */
+        SynonymListContainer( SynonymList& synonyms );
+
+        void addSynonyms( std::wstring& word1, std::wstring& word2 );
+
+    private :
+        /**
+         * \french
+         * La liste qui re�oit les synonymes.
+         * \endfrench
+         *
+         * \english
+         * The list receiving the synonyms.
+         * \endenglish
+         */
+        SynonymList& m_synonyms;
+    };
+
+    /**
+     * \french
+     * Compte les cases d'un espace de recherche de la paire de documents qui
+     * en a le plus, pour le budget de cases.
+     * \endfrench
+     *
+     * \english
+     * Counts the search space cells of the document pair having the most,
+     * for the cells budget.
+     * \endenglish
+     */
+    class PairCellCounter : public CascadeSSF::CellCounter
+    {
+    public :
+        /**
+         * \french
+         * Constructeur.
+         *
+         * @param documents Les paires de documents, dans l'ordre des textes.
+         * \endfrench
+         *
+         * \english
+         * Constructor.
+         *
+         * @param documents The document pairs, in the texts' order.
+         * \endenglish
+         */
+        PairCellCounter( const std::vector< Document >& documents );
+
+        size_t operator()( const SearchSpace& space ) const;
+
+    private :
+        /**
+         * \french
+         * Les paires de documents.
+         * \endfrench
+         *
+         * \english
+         * The document pairs.
+         * \endenglish
+         */
+        const std::vector< Document >& m_documents;
+    };
+
+    /**
+     * \french
+     * Aligne les paires de documents en parall�le (si compil� avec OpenMP).
+     * Les lexiques textuels sont lus une seule fois ; chaque paire est
+     * ensuite align�e par son propre programme, dont les options et l'�tat
+     * ne d�pendent pas des autres paires.
+     *
+     * @throw Exception Si l'alignement d'une paire �choue.
+     * \endfrench
+     *
+     * \english
+     * Aligns the document pairs in parallel (if compiled with OpenMP).  The
+     * text lexicons are read only once; each pair is then aligned by its
+     * own program, whose options and state don't depend on the other pairs.
+     *
+     * @throw Exception If the alignment of a pair fails.
+     * \endenglish
+     */
+    void alignDocuments();
+
+    /**
+     * \french
+     * Lit les lexiques textuels des options dans une liste et les retire
+     * des options ; les lexiques compil�s, qui sont projet�s en m�moire,
+     * restent dans les options.
+     *
+     * @param options Les options, dont les lexiques textuels sont retir�s.
+     * @param synonyms Re�oit les synonymes des lexiques textuels.
+     *
+     * @throw Exception Si un lexique ne peut �tre lu.
+     * \endfrench
+     *
+     * \english
+     * Reads the options' text lexicons into a list and removes them from
+     * the options; the compiled lexicons, which are mapped in memory, stay
+     * in the options.
+     *
+     * @param options The options, whose text lexicons are removed.
+     * @param synonyms Receives the synonyms of the text lexicons.
+     *
+     * @throw Exception If a lexicon can't be read.
+     * \endenglish
+     */
+    void readSynonyms( JapaOptions& options, SynonymList& synonyms );
+
+    /**
+     * \french
+     * Aligne une paire de documents seule, comme si elle �tait donn�e en
+     * arguments, et imprime sa solution dans son fichier.
+     *
+     * @param document La paire de documents, qui re�oit son nombre de
+     *                 phrases.
+     * @param synonyms Des synonymes qui s'ajoutent aux lexiques.
+     * \endfrench
+     *
+     * \english
+     * Aligns a pair of documents alone, as if it were given as arguments,
+     * and prints its solution to its file.
+     *
+     * @param document The pair of documents, which receives its sentence
+     *                 counts.
+     * @param synonyms Synonyms added to the lexicons.
+     * \endenglish
+     */
+    void alignDocument( Document& document, const SynonymList& synonyms );
+
+    /**
+     * \french
+     * Initialise les flux de donn�es.
+     * \endfrench
+     *
+     * \english
+     * Object's streams initializer.
+     * \endenglish
+     */
+    void initStreams();
+
+    /**
+     * \french
+     * Ouvre le fichier de la solution, ou la sortie standard si le nom est
+     * vide.  Le fichier pr�c�dent est ferm�.
+     *
+     * @param filename Le nom du fichier.
+     * \endfrench
+     *
+     * \english
+     * Opens the solution's file, or the standard output if the name is
+     * empty.  The previous file is closed.
+     *
+     * @param filename The file's name.
+     * \endenglish
+     */
+    void openSolution( const std::string& filename );
+
+    /**
+     * \french
+     * Ferme le fichier de la solution.
+     * \endfrench
+     *
+     * \english
+     * Closes the solution's file.
+     * \endenglish
+     */
+    void closeSolution();
+
+    /**
+     * \french
+     * Initialise les rapports d'avancement.
+     * \endfrench
+     *
+     * \english
+     * Progress reports initializer.
+     * \endenglish
+     */
+    void initProgress();
+
+    /**
+     * \french
+     * Ouvre la trace si elle est demand�e et nomme la paire align�e.
+     * \endfrench
+     *
+     * \english
+     * Opens the trace if it is requested and names the aligned pair.
+     * \endenglish
+     */
+    void initTrace();
+    
+    /**
+     * \french
+     * Initialise les textes et leurs cognates, � partir du cache des textes
+     * analys�s lorsqu'il est demand� et � jour.
+     * \endfrench
+     *
+     * \english
+     * Initializes the texts and their cognates, from the parsed texts cache
+     * when it is requested and up to date.
+     * \endenglish
+     */
+    void initCorpus();
+
+    /**
+     * \french
+     * Initialise les textes.
+     * \endfrench
+     *
+     * \english
+     * Text initializer.
+     * \endenglish
+     */
+    void initText();
+
+    /**
+     * \french
+     * Cr�e un analyseur pour le format d'entr�e choisi.
+     *
+     * @param name Re�oit le nom du format.
+     *
+     * @return L'analyseur, que l'appelant doit d�truire.
+     * \endfrench
+     *
+     * \english
+     * Creates a parser for the selected input format.
+     *
+     * @param name Receives the format's name.
+     *
+     * @return The parser, which the caller must delete.
+     * \endenglish
+     */
+    TextParser* newTextParser( std::string& name );
+
+    /**
+     * \french
+     * Analyse un texte en rapportant son avancement.
+     *
+     * @param parser L'analyseur.
+     * @param in Le flux du texte.
+     * @param text La structure dans laquelle ajouter le texte.
+     * @param task Le nom de la t�che rapport�e.
+     * \endfrench
+     *
+     * \english
+     * Parses a text, reporting its progress.
+     *
+     * @param parser The parser.
+     * @param in The text's stream.
+     * @param text The object where to add the text.
+     * @param task The name of the reported task.
+     * \endenglish
+     */
+    void parseText( TextParser& parser, std::wistream& in, Text& text,
+                    const std::string& task );
+
+    /**
+     * \french
+     * Initialisation des cognates
+     * \endfrench
+     *
+     * \english
+     * Cognate initializer.
+     * \endenglish
+     */
+    void initCognate();
+   
+    /**
+     * \french
+     * Initialise les cognates en mode pr�fixe.
+     * \endfrench
+     *
+     * \english
+     * Prefix cognate initializer.
+     * \endenglish
+     */
+    void initCognatePrefix();
+
+    /**
+     * \french
+     * Initialise les cognates en mode q-gramme.
+     * \endfrench
+     *
+     * \english
+     * Q-gram cognate initializer.
+     * \endenglish
+     */
+    void initCognateQGram();
+
+    /**
+     * \french
+     * Initialise le valideur de cognates.
+     * \endfrench
+     *
+     * \english
+     * Cognate validator initializer.
+     * \endenglish
+     */
+    void initCognateValidator( CognateValidator& cv );
+    
+    /**
+     * \french
+     * Initialise les cognates en mode mot.
+     * \endfrench
+     *
+     * \english
+     * Word cognate initializer.
+     * \endenglish
+     */
+    void initCognateWord();
+   
+    /**
+     * \french
+     * Initialise le dictionnaire des synonymes.
+     * \endfrench
+     *
+     * \english
+     * Synonym dictionaries initializer.
+     * \endenglish
+     */
+    void initSynonymDictionaries();
+
+    /**
+     * \french
+     * Ajoute aux dictionnaires des textes des synonymes d�j� lus.
+     *
+     * @param synonyms Les synonymes.
+     * \endfrench
+     *
+     * \english
+     * Adds synonyms already read to the texts' dictionaries.
+     *
+     * @param synonyms The synonyms.
+     * \endenglish
+     */
+    void addSynonyms( const SynonymList& synonyms );
+
+    /**
+     * \french
+     * Trie les synonymes de chaque mot des textes, une fois les cognates et
+     * les lexiques ajout�s.
+     * \endfrench
+     *
+     * \english
+     * Sorts the synonyms of each word of the texts, once the cognates and
+     * the lexicons are added.
+     * \endenglish
+     */
+    void sortSynonyms();
+
+    /**
+     * \french
+     * Initialise l'espace de recherche, les points d'ancrage et la table
+     * dynamique des textes.
+     * \endfrench
+     *
+     * \english
+     * Initializes the texts' search space, anchor points and dynamic table.
+     * \endenglish
+     */
+    void initAligner();
+
+    /**
+     * \french
+     * Remplit l'espace de recherche et trouve le meilleur alignement.
+     *
+     * @param solution Re�oit la solution.
+     * \endfrench
+     *
+     * \english
+     * Fills the search space and finds the best alignment.
+     *
+     * @param solution Receives the solution.
+     * \endenglish
+     */
+    void solve( SolutionPrinter< double >::Solution& solution );
+
+    /**
+     * \french
+     * Remplit l'espace de recherche en respectant les budgets.  Tant que le
+     * co�t d'une paire de documents d�passe son budget, l'alignement se
+     * rabat sur une configuration moins co�teuse.
+     * \endfrench
+     *
+     * \english
+     * Fills the search space within the budgets.  As long as the cost of a
+     * document pair exceeds its budget, the alignment falls back to a
+     * cheaper configuration.
+     * \endenglish
+     */
+    void fillSearchSpace();
+
+    /**
+     * \french
+     * Choisit la table dynamique selon la m�moire estim�e pour l'espace de
+     * recherche rempli.  La table par bandes, la plus rapide, est choisie si
+     * elle respecte la limite de m�moire ; sans limite, si elle n'occupe pas
+     * plus que la table de hachage.
+     *
+     * @return <code>false</code> si aucune table ne respecte la limite.
+     * \endfrench
+     *
+     * \english
+     * Chooses the dynamic table after the memory estimated for the filled
+     * search space.  The band table, the fastest, is chosen if it fits the
+     * memory limit; without a limit, if it takes no more than the hash table.
+     *
+     * @return <code>false</code> if no table fits the limit.
+     * \endenglish
+     */
+    bool planTable();
+
+    /**
+     * \french
+     * Passe � la configuration moins co�teuse suivante : espace de recherche
+     * par faisceau, faisceau deux fois plus �troit, puis score fond� sur la
+     * longueur seule.  L'aligneur est ensuite r�initialis�.
+     *
+     * @param reason Le budget d�pass�.
+     *
+     * @return <code>false</code> s'il n'y a plus de configuration moins
+     *         co�teuse.
+     * \endfrench
+     *
+     * \english
+     * Switches to the next cheaper configuration: beam search space, beam
+     * half as wide, then length-only score.  The aligner is then
+     * initialized again.
+     *
+     * @param reason The exceeded budget.
+     *
+     * @return <code>false</code> if there is no cheaper configuration left.
+     * \endenglish
+     */
+    bool fallBack( const std::string& reason );
+
+    /**
+     * \french
+     * Retourne le nombre de cases de l'espace de recherche rempli de la
+     * paire de documents qui en a le plus.  Avec la cascade, l'espace large
+     * de la premi�re passe compte aussi.
+     *
+     * @return Le nombre de cases.
+     * \endfrench
+     *
+     * \english
+     * Returns the number of cells of the filled search space of the
+     * document pair having the most.  With the cascade, the first pass' wide
+     * space counts too.
+     *
+     * @return The number of cells.
+     * \endenglish
+     */
+    size_t getCellCost() const;
+
+    /**
+     * \french
+     * Retourne l'estimation du nombre de points de l'espace de recherche des
+     * mots de la paire de documents qui en a le plus.
+     *
+     * @return Le nombre estim� de points.
+     * \endfrench
+     *
+     * \english
+     * Returns the estimated number of points of the words' search space of
+     * the document pair having the most.
+     *
+     * @return The estimated number of points.
+     * \endenglish
+     */
+    size_t getWordCost() const;
+
+    /**
+     * \french
+     * Initialise les alignements sp�cifi�s par l'utilisateur.
+     *
+     * @param score La fonction de score � qui ajouter les alignements.
+     * \endfrench
+     *
+     * \english
+     * User defined alignments initializer.
+     *
+     * @param score The score function receiving the alignments.
+     * \endenglish
+     */
+    void initAlignments( ChurchGaleScore& score );
+
+    /**
+     * \french
+     * Initialise les points d'ancrage, tir�s des fichiers d'ancrage et des
+     * divisions des textes, et contraint l'espace de recherche en
+     * cons�quence.
+     * \endfrench
+     *
+     * \english
+     * Initializes the anchor points, taken from the anchor files and from the
+     * texts' divisions, and constrains the search space accordingly.
+     * \endenglish
+     */
+    void initAnchors();
+
+    /**
+     * \french
+     * Lit un fichier d'ancrage.  Chaque ligne contient l'identificateur d'une
+     * phrase source et celui d'une phrase cible qui commencent ensemble un
+     * segment.
+     *
+     * @param filename Le nom du fichier.
+     * \endfrench
+     *
+     * \english
+     * Reads an anchor file.  Each line holds the ID of a source sentence and
+     * the ID of a target sentence that begin a segment together.
+     *
+     * @param filename The file's name.
+     * \endenglish
+     */
+    void readAnchors( const std::string& filename );
+
+    /**
+     * \french
+     * Ajoute un point d'ancrage avant une paire de phrases.
+     *
+     * @param source L'indice de la phrase source.
+     * @param target L'indice de la phrase cible.
+     * \endfrench
+     *
+     * \english
+     * Adds an anchor point before a pair of sentences.
+     *
+     * @param source The source sentence's subscript.
+     * @param target The target sentence's subscript.
+     * \endenglish
+     */
+    void addAnchor( const size_t source, const size_t target );
+
+    /**
+     * \french
+     * Initialise les param�tres Church and Gale d'une fonction de score.
+     *
+     * @param score La fonction de score � initialiser.
+     * \endfrench
+     *
+     * \english
+     * Initializes a score function's Church and Gale parameters.
+     *
+     * @param score The score function to initialize.
+     * \endenglish
+     */
+    void initChurchGaleParameters( ChurchGaleScore& score );
+
+    /**
+     * \french
+     * Initialise la cascade : une premi�re passe Church and Gale sur l'espace
+     * de recherche demand� restreint la passe Felipe � un corridor.
+     * \endfrench
+     *
+     * \english
+     * Initializes the cascade: a first Church and Gale pass on the requested
+     * search space restricts the Felipe pass to a corridor.
+     * \endenglish
+     */
+    void initCascade();
     
     /**
      * \french
-     * Destructeur.
+     * Initialise le score Felipe.
      * \endfrench
      *
      * \english
-     * Destructor.
+     * Felipe score's initializer. 
      * \endenglish
      */
-    virtual ~JapaProgram();
+    void initScoreFelipe();
     
     /**
      * \french
-     * Aligne deux textes parall�les.
+     * Initialise l'espace de recherche.
      * \endfrench
      *
      * \english
-     * Align two parallel texts.
+     * Search space's initializer. 
      * \endenglish
      */
-    void run();
+    void initSearchSpace();
+
+    /**
+     * \french
+     * Initialise l'espace de recherhce "cognate".
+     * \endfrench
+     *
+     * \english
+     * Cognate search space's initializer. 
+     * \endenglish
+     */
+    void initSearchSpaceCognate();
     
-private :    
     /**
      * \french
-     * Initialise les flux de donn�es.
+     * Initialise la r�solution de la solution.
      * \endfrench
      *
      * \english
-     * Object's streams initializer.
+     * Initialize dynamic programming algorithm. 
      * \endenglish
      */
-    void initStreams();
+    void initTable();
     
     /**
      * \french
-     * Initialise les textes.
+     * Initialise l'impression des r�sultats d'une paire de documents.
+     *
+     * @param document La paire de documents.
      * \endfrench
      *
      * \english
-     * Text initializer.
+     * Result printer's initializer for a pair of documents. 
+     *
+     * @param document The pair of documents.
      * \endenglish
      */
-    void initText();
+    void initPrinter( const Document& document );
 
     /**
      * \french
-     * Initialisation des cognates
+     * Initialise l'afficheur du bitexte align�.  Les fichiers d'entr�e sont
+     * projet�s en m�moire ; ils doivent �tre au format une phrase par ligne.
+     *
+     * @param document La paire de documents.
+     * @param json Vrai pour le format JSONL, faux pour le format TSV.
      * \endfrench
      *
      * \english
-     * Cognate initializer.
+     * Initializes the aligned bitext printer.  The input files are mapped in
+     * memory; they must be in the one sentence per line format.
+     *
+     * @param document The pair of documents.
+     * @param json True for the JSONL format, false for the TSV format.
      * \endenglish
      */
-    void initCognate();
-   
+    void initBitextPrinter( const Document& document, const bool json );
+
     /**
      * \french
-     * Initialise les cognates en mode pr�fixe.
+     * Imprime la solution de la paire de documents dans son fichier.
+     *
+     * @param solution La solution.
      * \endfrench
      *
      * \english
-     * Prefix cognate initializer.
+     * Prints the solution of the pair of documents to its file.
+     *
+     * @param solution The solution.
      * \endenglish
      */
-    void initCognatePrefix();
+    void printSolution( const SolutionPrinter< double >::Solution& solution );
 
     /**
      * \french
-     * Initialise le valideur de cognates.
+     * Analyse la valeur de l'option de d�coupage en lots.
+     *
+     * @param shard Re�oit le num�ro du lot, de 1 � <code>count</code>, ou 0
+     *              si la valeur ne donne que le nombre de lots.
+     * @param count Re�oit le nombre de lots.
      * \endfrench
      *
      * \english
-     * Cognate validator initializer.
+     * Parses the sharding option's value.
+     *
+     * @param shard Receives the shard's number, from 1 to <code>count</code>,
+     *              or 0 if the value only gives the number of shards.
+     * @param count Receives the number of shards.
      * \endenglish
      */
-    void initCognateValidator( CognateValidator& cv );
-    
+    void parseShard( size_t& shard, size_t& count );
+
     /**
      * \french
-     * Initialise les cognates en mode mot.
+     * Retourne le lot d'une paire de documents.  Le lot ne d�pend que des
+     * noms des fichiers source et cible, pas de la machine ni de l'ordre de
+     * la liste.
+     *
+     * @param document La paire de documents.
+     * @param count Le nombre de lots.
+     *
+     * @return Le num�ro du lot, de 1 � <code>count</code>.
      * \endfrench
      *
      * \english
-     * Word cognate initializer.
+     * Returns the shard of a document pair.  The shard only depends on the
+     * source and target file names, not on the machine nor on the list's
+     * order.
+     *
+     * @param document The document pair.
+     * @param count The number of shards.
+     *
+     * @return The shard's number, from 1 to <code>count</code>.
      * \endenglish
      */
-    void initCognateWord();
-   
+    size_t getShard( const Document& document, const size_t count ) const;
+
     /**
      * \french
-     * Initialise le dictionnaire des synonymes.
+     * Retourne le nom du fichier d'index d'un lot, � c�t� de la liste de
+     * documents.
+     *
+     * @param shard Le num�ro du lot.
+     * @param count Le nombre de lots.
+     *
+     * @return Le nom du fichier d'index.
      * \endfrench
      *
      * \english
-     * Synonym dictionaries initializer.
+     * Returns the name of a shard's index file, beside the document list.
+     *
+     * @param shard The shard's number.
+     * @param count The number of shards.
+     *
+     * @return The index file's name.
      * \endenglish
      */
-    void initSynonymDictionaries();
+    std::string getShardIndex( const size_t shard, const size_t count );
 
     /**
      * \french
-     * Initialise les alignements sp�cifi�s par l'utilisateur.
+     * �crit l'index du lot align� : une ligne par paire de documents, avec
+     * sa ligne dans la liste, ses nombres de phrases et son fichier de
+     * solution.  L'index n'appara�t qu'une fois complet.
      * \endfrench
      *
      * \english
-     * User defined alignments initializer.
+     * Writes the aligned shard's index: a line per document pair, with its
+     * line in the list, its sentence counts and its solution's file.  The
+     * index only appears once complete.
      * \endenglish
      */
-    void initAlignments();
-    
+    void writeShardIndex();
+
     /**
      * \french
-     * Initialise le score Felipe.
+     * R�unit les solutions de tous les lots dans l'ordre de la liste de
+     * documents, apr�s avoir v�rifi� que les index des lots couvrent chaque
+     * paire une et une seule fois.
      * \endfrench
      *
      * \english
-     * Felipe score's initializer. 
+     * Gathers the solutions of every shard in the document list's order,
+     * after checking that the shards' indexes cover each pair once and only
+     * once.
      * \endenglish
      */
-    void initScoreFelipe();
-    
+    void mergeShards();
+
     /**
      * \french
-     * Initialise l'espace de recherche.
+     * Consulte le cache des solutions.  Les paires d�j� dans le cache et les
+     * doublons d'une paire pr�c�dente de la liste sont retir�s des paires �
+     * aligner.  Chaque paire �tant align�e seule, sa solution ne d�pend que
+     * de ses fichiers et des options.
      * \endfrench
      *
      * \english
-     * Search space's initializer. 
+     * Looks up the solutions cache.  The pairs already in the cache and the
+     * duplicates of a previous pair of the list are removed from the pairs
+     * to align.  As each pair is aligned alone, its solution only depends
+     * on its files and the options.
      * \endenglish
      */
-    void initSearchSpace();
+    void initResults();
 
     /**
      * \french
-     * Initialise l'espace de recherhce "cognate".
+     * Ajoute au cache les solutions des paires align�es, �crit celles des
+     * paires retir�es par <code>initResults</code> et rend la liste enti�re
+     * des paires, dans l'ordre de la liste de documents.
      * \endfrench
      *
      * \english
-     * Cognate search space's initializer. 
+     * Adds the solutions of the aligned pairs to the cache, writes those of
+     * the pairs removed by <code>initResults</code> and restores the whole
+     * list of pairs, in the document list's order.
      * \endenglish
      */
-    void initSearchSpaceCognate();
-    
+    void finishResults();
+
     /**
      * \french
-     * Initialise la r�solution de la solution.
+     * Calcule l'empreinte des options qui influencent la solution.  Les
+     * lexiques et les fichiers de points d'ancrage y contribuent par leur
+     * contenu.
+     *
+     * @return L'empreinte.
      * \endfrench
      *
      * \english
-     * Initialize dynamic programming algorithm. 
+     * Computes the hash of the options affecting the solution.  The lexicons
+     * and the anchor files contribute by their content.
+     *
+     * @return The hash.
      * \endenglish
      */
-    void initTable();
-    
+    uint64_t getOptionsKey();
+
     /**
      * \french
-     * Initialise l'impression des r�sultats.
+     * Compare deux paires de documents selon leur ligne dans la liste.
+     *
+     * @param left La premi�re paire.
+     * @param right La seconde paire.
+     *
+     * @return <code>true</code> si la premi�re paire pr�c�de la seconde.
      * \endfrench
      *
      * \english
-     * Result printer's initializer. 
+     * Compares two document pairs by their line in the list.
+     *
+     * @param left The first pair.
+     * @param right The second pair.
+     *
+     * @return <code>true</code> if the first pair comes before the second.
      * \endenglish
      */
-    void initPrinter();
+    static bool precedes( const Document& left, const Document& right );
     
     /**
      * \french
@@ -263,6 +1109,23 @@ private :
      * \endenglish
      */ 
     void veryVerbose( const std::string msg );
+
+    /**
+     * \french
+     * Retourne le flux des rapports de m�moire des �tapes.
+     *
+     * @return Le flux des messages en mode tr�s verbeux, <code>NULL</code>
+     *         sinon.
+     * \endfrench
+     *
+     * \english
+     * Returns the stream of the stages' memory reports.
+     *
+     * @return The messages' stream in very verbose mode, <code>NULL</code>
+     *         otherwise.
+     * \endenglish
+     */
+    std::ostream* getMemoryStream();
    
     
     /** 
@@ -287,6 +1150,67 @@ private :
      */
     std::auto_ptr< Text > m_target;
 
+    /** 
+     * \french
+     * Les paires de documents, dans l'ordre des textes. 
+     * \endfrench
+     *
+     * \english
+     * The document pairs, in the texts' order. 
+     * \endenglish
+     */
+    std::vector< Document > m_documents;
+
+    /** 
+     * \french
+     * Le texte source projet� en m�moire, pour les sorties qui copient le
+     * texte des phrases. 
+     * \endfrench
+     *
+     * \english
+     * The source text mapped in memory, for the outputs copying the
+     * sentences' text. 
+     * \endenglish
+     */
+    std::auto_ptr< MappedText > m_sourceMap;
+
+    /** 
+     * \french
+     * Le texte cible projet� en m�moire, pour les sorties qui copient le
+     * texte des phrases. 
+     * \endfrench
+     *
+     * \english
+     * The target text mapped in memory, for the outputs copying the
+     * sentences' text. 
+     * \endenglish
+     */
+    std::auto_ptr< MappedText > m_targetMap;
+
+    /** 
+     * \french
+     * Le cache des solutions, s'il est demand�.
+     * \endfrench
+     *
+     * \english
+     * The solutions cache, if requested.
+     * \endenglish
+     */
+    std::auto_ptr< ResultCache > m_results;
+
+    /** 
+     * \french
+     * Les paires dont la solution vient du cache ou d'une autre paire de la
+     * liste, plut�t que de l'alignement.
+     * \endfrench
+     *
+     * \english
+     * The pairs whose solution comes from the cache or from another pair of
+     * the list, rather than from the alignment.
+     * \endenglish
+     */
+    std::vector< Document > m_reused;
+
     /** 
      * \french
      * L'emplisseur de l'espace de recherche. 
@@ -298,6 +1222,99 @@ private :
      */
     std::auto_ptr< SearchSpaceFiller > m_SSFiller;
 
+    /** 
+     * \french
+     * L'emplisseur par cognates, s'il est utilis�, pour estimer le nombre de
+     * points des mots.  Il appartient � la cha�ne des emplisseurs. 
+     * \endfrench
+     *
+     * \english
+     * The cognate filler, if used, to estimate the number of word points.
+     * It belongs to the fillers' chain. 
+     * \endenglish
+     */
+    CognateSSF* m_cognateFiller;
+
+    /** 
+     * \french
+     * L'emplisseur en cascade, s'il est utilis�, dont la table de la premi�re
+     * passe compte dans le budget de m�moire.  Il appartient � la cha�ne des
+     * emplisseurs. 
+     * \endfrench
+     *
+     * \english
+     * The cascade filler, if used, whose first pass' table counts in the
+     * memory budget.  It belongs to the fillers' chain. 
+     * \endenglish
+     */
+    CascadeSSF* m_cascade;
+
+    /** 
+     * \french
+     * L'emplisseur de la premi�re passe de la cascade. 
+     * \endfrench
+     *
+     * \english
+     * The cascade's first pass search space filler. 
+     * \endenglish
+     */
+    std::auto_ptr< SearchSpaceFiller > m_cascadeFiller;
+
+    /** 
+     * \french
+     * La fonction de score de la premi�re passe de la cascade. 
+     * \endfrench
+     *
+     * \english
+     * The cascade's first pass score function. 
+     * \endenglish
+     */
+    std::auto_ptr< ChurchGaleScore > m_cascadeScore;
+
+    /** 
+     * \french
+     * Le marqueur du corridor de la cascade. 
+     * \endfrench
+     *
+     * \english
+     * The cascade's corridor marker. 
+     * \endenglish
+     */
+    std::auto_ptr< SolutionMarker > m_cascadeMarker;
+
+    /** 
+     * \french
+     * Le compteur des cases pour le budget, aussi pour la cascade. 
+     * \endfrench
+     *
+     * \english
+     * The cells counter for the budget, also for the cascade. 
+     * \endenglish
+     */
+    PairCellCounter m_cellCounter;
+
+    /** 
+     * \french
+     * Les points d'ancrage de la solution. 
+     * \endfrench
+     *
+     * \english
+     * The solution's anchor points. 
+     * \endenglish
+     */
+    Anchors m_anchors;
+
+    /** 
+     * \french
+     * L'emplisseur contraint par les points d'ancrage. 
+     * \endfrench
+     *
+     * \english
+     * The search space filler constrained by the anchor points. 
+     * \endenglish
+     */
+    std::auto_ptr< SearchSpaceFiller > m_anchorFiller;
+
     /** 
      * \french
      * Le marqueur de solution. 
@@ -355,14 +1372,25 @@ private :
  
     /** 
      * \french
-     * Le flux vers lequel la solution est envoy�e. 
+     * Le fichier vers lequel la solution est envoy�e. 
      * \endfrench
      *
      * \english
-     * The stream where the solution is to be printed. 
+     * The file where the solution is to be printed. 
      * \endenglish
      */
-    std::wostream* m_solutionStream;
+    std::FILE* m_solutionFile;
+
+    /** 
+     * \french
+     * Le flux tamponn� qui �crit la solution dans le fichier. 
+     * \endfrench
+     *
+     * \english
+     * The buffered stream writing the solution to the file. 
+     * \endenglish
+     */
+    std::auto_ptr< Utf8Writer > m_solutionStream;
 
     /** 
      * \french
@@ -374,6 +1402,41 @@ private :
      * \endenglish
      */
     std::ostream* m_messagesStream;
+
+    /** 
+     * \french
+     * Les rapports d'avancement.
+     * \endfrench
+     *
+     * \english
+     * The progress reports.
+     * \endenglish
+     */
+    Progress m_progress;
+
+    /** 
+     * \french
+     * L'�tiquette de la paire align�e dans la trace : le fichier source, ou
+     * la liste des documents.
+     * \endfrench
+     *
+     * \english
+     * The aligned pair's label in the trace: the source file, or the
+     * documents' list.
+     * \endenglish
+     */
+    std::string m_tracePair;
+
+    /** 
+     * \french
+     * Indique si ce programme a ouvert la trace et doit la fermer.
+     * \endfrench
+     *
+     * \english
+     * Tells if this program opened the trace and must close it.
+     * \endenglish
+     */
+    bool m_tracing;
         
     /** 
      * \french
@@ -0,0 +1,764 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "binarylexicon.h"
+#include "binarylexiconwriter.h"
+#include "japaexception.h"
+#include "japaprogram.h"
+#include "japaserver.h"
+#include "japasynonymparser.h"
+#include "toolbox.h"
+#include "trace.h"
+
+namespace japa
+{
+
+// ------------------------------------------------------------------------ //
+/**
+ * Lit une ligne d'un flux, sans sa fin de ligne.
+ *
+ * @param in Le flux.
+ * @param line Re�oit la ligne.
+ *
+ * @return Faux � la fin du flux.
+ */
+static bool readLine( std::FILE* in, std::string& line )
+{
+    char buffer[ 4096 ];
+
+    line.clear();
+
+    while( fgets( buffer, sizeof( buffer ), in ) != NULL )
+    {
+        line += buffer;
+
+        if( line[ line.size() - 1 ] == '\n' )
+        {
+            line.erase( line.size() - 1 );
+            return true;
+        }
+    }
+
+    return !line.empty();
+}
+
+// ------------------------------------------------------------------------ //
+/**
+ * Saute les espaces d'une cha�ne JSON.
+ *
+ * @param line La cha�ne.
+ * @param pos La position courante, avanc�e apr�s les espaces.
+ */
+static void skipSpaces( const std::string& line, size_t& pos )
+{
+    while( pos < line.size() && isspace( ( unsigned char )line[ pos ] ) )
+    {
+        pos++;
+    }
+}
+
+// ------------------------------------------------------------------------ //
+/**
+ * V�rifie le caract�re courant d'une cha�ne JSON et le saute, avec les
+ * espaces qui le suivent.
+ *
+ * @param line La cha�ne.
+ * @param pos La position courante.
+ * @param c Le caract�re attendu.
+ *
+ * @throw Exception Si le caract�re est absent.
+ */
+static void expect( const std::string& line, size_t& pos, const char c )
+{
+    if( pos >= line.size() || line[ pos ] != c )
+    {
+        throw Exception( std::string( "Malformed request, expected : " ) + c );
+    }
+
+    pos++;
+    skipSpaces( line, pos );
+}
+
+// ------------------------------------------------------------------------ //
+/**
+ * Ajoute un point de code � une cha�ne UTF-8.
+ *
+ * @param s La cha�ne.
+ * @param code Le point de code.
+ */
+static void appendUtf8( std::string& s, const unsigned long code )
+{
+    if( code < 0x80 )
+    {
+        s += ( char )code;
+    }
+    else if( code < 0x800 )
+    {
+        s += ( char )( 0xC0 | ( code >> 6 ) );
+        s += ( char )( 0x80 | ( code & 0x3F ) );
+    }
+    else if( code < 0x10000 )
+    {
+        s += ( char )( 0xE0 | ( code >> 12 ) );
+        s += ( char )( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+        s += ( char )( 0x80 | ( code & 0x3F ) );
+    }
+    else
+    {
+        s += ( char )( 0xF0 | ( code >> 18 ) );
+        s += ( char )( 0x80 | ( ( code >> 12 ) & 0x3F ) );
+        s += ( char )( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+        s += ( char )( 0x80 | ( code & 0x3F ) );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+/**
+ * Lit quatre chiffres hexad�cimaux d'une s�quence <code>\\u</code>.
+ *
+ * @param line La cha�ne.
+ * @param pos La position du premier chiffre, avanc�e apr�s le dernier.
+ *
+ * @return La valeur lue.
+ *
+ * @throw Exception Si la s�quence est incompl�te.
+ */
+static unsigned long parseHex( const std::string& line, size_t& pos )
+{
+    unsigned long code = 0;
+
+    for( size_t i = 0; i < 4; i++, pos++ )
+    {
+        if( pos >= line.size() || !isxdigit( ( unsigned char )line[ pos ] ) )
+        {
+            throw Exception( "Malformed request, bad unicode escape" );
+        }
+
+        code = code * 16 + strtoul( line.substr( pos, 1 ).c_str(), NULL, 16 );
+    }
+
+    return code;
+}
+
+// ------------------------------------------------------------------------ //
+/**
+ * Lit une cha�ne JSON.
+ *
+ * @param line La requ�te.
+ * @param pos La position du guillemet ouvrant, avanc�e apr�s la cha�ne et
+ *            les espaces qui la suivent.
+ *
+ * @return La cha�ne, encod�e en UTF-8.
+ *
+ * @throw Exception Si la cha�ne est mal form�e.
+ */
+static std::string parseString( const std::string& line, size_t& pos )
+{
+    std::string value;
+    unsigned long code;
+
+    if( pos >= line.size() || line[ pos ] != '"' )
+    {
+        throw Exception( "Malformed request, expected a string" );
+    }
+
+    pos++;
+
+    while( pos < line.size() && line[ pos ] != '"' )
+    {
+        if( line[ pos ] != '\\' )
+        {
+            value += line[ pos++ ];
+            continue;
+        }
+
+        if( ++pos >= line.size() )
+        {
+            break;
+        }
+
+        switch( line[ pos++ ] )
+        {
+        case 'b' : value += '\b'; break;
+        case 'f' : value += '\f'; break;
+        case 'n' : value += '\n'; break;
+        case 'r' : value += '\r'; break;
+        case 't' : value += '\t'; break;
+
+        case 'u' :
+            code = parseHex( line, pos );
+
+            // Une paire de substitution forme un seul point de code
+            if( code >= 0xD800 && code < 0xDC00 &&
+                line.compare( pos, 2, "\\u" ) == 0 )
+            {
+                pos += 2;
+                code = 0x10000 + ( ( code - 0xD800 ) << 10 ) +
+                       ( parseHex( line, pos ) - 0xDC00 );
+            }
+
+            appendUtf8( value, code );
+            break;
+
+        default :
+            value += line[ pos - 1 ];
+            break;
+        }
+    }
+
+    expect( line, pos, '"' );
+
+    return value;
+}
+
+// ------------------------------------------------------------------------ //
+/**
+ * Lit un fichier entier en m�moire.
+ *
+ * @param filename Le nom du fichier.
+ *
+ * @return Le contenu du fichier.
+ *
+ * @throw Exception Si le fichier ne peut �tre lu.
+ */
+static std::string readFile( const std::string& filename )
+{
+    std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+    std::ostringstream content;
+
+    if( in.fail() )
+    {
+        throw Exception( "Can't read file : " + filename );
+    }
+
+    content << in.rdbuf();
+
+    return content.str();
+}
+
+// ------------------------------------------------------------------------ //
+JapaServer::JapaServer()
+{}
+
+// ------------------------------------------------------------------------ //
+JapaServer::~JapaServer()
+{
+    if( !m_lexicon.empty() )
+    {
+        unlink( m_lexicon.c_str() );
+    }
+
+    Trace::close();
+}
+
+// ------------------------------------------------------------------------ //
+void JapaServer::parse( int argc, char** argv )
+{
+    JapaOptions::OptionList ol;
+    JapaOptions::OptionList::const_iterator iter;
+    BinaryLexiconWriter writer;
+    JapaSynonymParser parser;
+
+    m_options.parse( argc, argv );
+
+    // Une seule trace couvre toutes les requ�tes et tous les fils
+    if( m_options.isOption( JapaOptions::TRACE_FILE ) )
+    {
+        Trace::open( m_options.getOption( JapaOptions::TRACE_FILE ) );
+        m_options.removeOption( JapaOptions::TRACE_FILE );
+    }
+
+    // Les dictionnaires textuels sont compil�s une fois pour toutes ; les
+    // requ�tes ne font plus que projeter le lexique en m�moire.
+    ol = m_options.getOptionList( JapaOptions::SYNONYM_DICTIONARY );
+    m_options.removeOption( JapaOptions::SYNONYM_DICTIONARY );
+
+    for( iter = ol.begin(); iter != ol.end(); iter++ )
+    {
+        if( BinaryLexicon::isBinaryLexicon( *iter ) )
+        {
+            m_options.setOption( JapaOptions::SYNONYM_DICTIONARY, *iter );
+        }
+        else
+        {
+            std::wifstream in( iter -> c_str() );
+
+            if( in.fail() )
+            {
+                throw Exception( "Can't open synonym dictionary : " + *iter );
+            }
+
+            parser( in, writer );
+        }
+    }
+
+    if( writer.getPairCount() > 0 )
+    {
+        m_lexicon = makeTemporary( "" );
+        writer.write( m_lexicon );
+        m_options.setOption( JapaOptions::SYNONYM_DICTIONARY, m_lexicon );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+std::string JapaServer::getSocket()
+{
+    return m_options.getArgument( 0 );
+}
+
+// ------------------------------------------------------------------------ //
+std::string JapaServer::handle( const std::string& line )
+{
+    Request request;
+    std::string alignment;
+
+    request.id = "null";
+
+    try
+    {
+        parseRequest( line, request );
+        alignment = align( request );
+    }
+    catch( std::exception& ex )
+    {
+        return "{\"id\":" + request.id + ",\"status\":\"error\",\"message\":" +
+               quoteJson( ex.what() ) + "}";
+    }
+
+    if( !request.output.empty() )
+    {
+        return "{\"id\":" + request.id + ",\"status\":\"ok\"}";
+    }
+
+    return "{\"id\":" + request.id + ",\"status\":\"ok\",\"alignment\":" +
+           quoteJson( alignment ) + "}";
+}
+
+// ------------------------------------------------------------------------ //
+void JapaServer::serve( std::FILE* in, std::FILE* out )
+{
+    // Les fils se partagent les lignes du flux
+    #pragma omp parallel
+    {
+        std::string line;
+        std::string response;
+        bool more = true;
+
+        while( more )
+        {
+            #pragma omp critical( JapaServerInput )
+            more = readLine( in, line );
+
+            if( more && line.find_first_not_of( " \t\r" ) != std::string::npos )
+            {
+                response = handle( line );
+
+                #pragma omp critical( JapaServerOutput )
+                {
+                    fprintf( out, "%s\n", response.c_str() );
+                    fflush( out );
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void JapaServer::listen( const std::string& path )
+{
+    struct sockaddr_un address;
+    int server;
+    std::string message;
+    bool failed = false;
+
+    if( path.size() >= sizeof( address.sun_path ) )
+    {
+        throw Exception( "Socket path too long : " + path );
+    }
+
+    memset( &address, 0, sizeof( address ) );
+    address.sun_family = AF_UNIX;
+    strcpy( address.sun_path, path.c_str() );
+
+    server = socket( AF_UNIX, SOCK_STREAM, 0 );
+    unlink( path.c_str() );
+
+    if( server < 0 ||
+        bind( server, ( struct sockaddr* )&address, sizeof( address ) ) != 0 ||
+        ::listen( server, SOMAXCONN ) != 0 )
+    {
+        if( server >= 0 )
+        {
+            close( server );
+        }
+
+        throw Exception( "Can't listen on socket : " + path );
+    }
+
+    // Chaque fil sert une connexion � la fois
+    #pragma omp parallel
+    {
+        for( ;; )
+        {
+            int client = accept( server, NULL, NULL );
+            int code = errno;
+            std::FILE* in;
+            std::FILE* out;
+
+            // Un signal ou une connexion abandonn�e par le client
+            // n'arr�tent pas le serveur
+            if( client < 0 && ( code == EINTR || code == ECONNABORTED ) )
+            {
+                continue;
+            }
+
+            // Les autres erreurs se r�p�teraient sans fin : le premier fil
+            // qui en voit une r�veille les autres et tous s'arr�tent
+            if( client < 0 )
+            {
+                #pragma omp critical( JapaServerListen )
+                {
+                    if( !failed )
+                    {
+                        message = "Can't accept connection on socket : " + 
+                                  path + " : " + strerror( code );
+                        failed = true;
+                        shutdown( server, SHUT_RDWR );
+                    }
+                }
+
+                break;
+            }
+
+            in = fdopen( client, "r" );
+            out = fdopen( dup( client ), "w" );
+
+            if( in != NULL && out != NULL )
+            {
+                serveConnection( in, out );
+            }
+
+            if( in != NULL )
+            {
+                fclose( in );
+            }
+
+            if( out != NULL )
+            {
+                fclose( out );
+            }
+        }
+    }
+
+    close( server );
+
+    throw Exception( message );
+}
+
+// ------------------------------------------------------------------------ //
+void JapaServer::serveConnection( std::FILE* in, std::FILE* out )
+{
+    std::string line;
+
+    while( readLine( in, line ) )
+    {
+        if( line.find_first_not_of( " \t\r" ) != std::string::npos )
+        {
+            fprintf( out, "%s\n", handle( line ).c_str() );
+            fflush( out );
+        }
+    }
+}
+
+// ------------------------------------------------------------------------ //
+std::string JapaServer::align( const Request& request )
+{
+    // Les listes, les lots, les caches et la progression supposent une
+    // ex�cution � part enti�re, pas une requ�te parmi d'autres
+    static const char RUN_OPTIONS[] = { JapaOptions::DOCUMENT_LIST, 
+                                        JapaOptions::SHARD, 
+                                        JapaOptions::SHARD_MERGE,
+                                        JapaOptions::RESULT_CACHE, 
+                                        JapaOptions::CORPUS_CACHE,
+                                        JapaOptions::PROGRESS_FILE };
+    JapaProgram program( m_options );
+    std::vector< std::string > args( 1, "yasa" );
+    std::vector< char* > argv;
+    std::string source( request.sourceText );
+    std::string target( request.targetText );
+    std::string alignment;
+    std::string message;
+    std::FILE* output;
+    char* buffer = NULL;
+    size_t size = 0;
+    bool failed = false;
+    JAPA_TRACE_SCOPE( "request", request.id );
+
+    args.insert( args.end(), request.options.begin(), request.options.end() );
+
+    for( size_t i = 0; i < args.size(); i++ )
+    {
+        argv.push_back( const_cast< char* >( args[ i ].c_str() ) );
+    }
+
+    argv.push_back( NULL );
+
+    // getopt garde son �tat dans des variables globales ; glibc ne l'efface
+    // compl�tement, m�me apr�s une erreur, que si optind vaut 0.
+    #pragma omp critical( JapaServerOptions )
+    {
+        try
+        {
+#ifdef __GLIBC__
+            optind = 0;
+#else
+            optind = 1;
+#endif
+            program.parse( args.size(), &argv[ 0 ] );
+        }
+        catch( std::exception& ex )
+        {
+            message = ex.what();
+            failed = true;
+        }
+    }
+
+    if( failed )
+    {
+        throw Exception( message );
+    }
+
+    // Les messages iraient sur la sortie standard, o� passent les r�ponses
+    if( program.isOption( JapaOptions::HELP ) ||
+        program.isOption( JapaOptions::VERBOSE ) ||
+        program.isOption( JapaOptions::VERY_VERBOSE ) )
+    {
+        throw Exception( "Help and verbose options are not available to "
+                         "requests" );
+    }
+
+    // La trace est celle du serveur
+    if( program.isOption( JapaOptions::TRACE_FILE ) )
+    {
+        throw Exception( "The trace option is not available to requests" );
+    }
+
+    for( size_t k = 0; k < sizeof( RUN_OPTIONS ); k++ )
+    {
+        if( program.isOption( RUN_OPTIONS[ k ] ) )
+        {
+            throw Exception( std::string( "The option -" ) + RUN_OPTIONS[ k ] +
+                             " is not available to requests" );
+        }
+    }
+
+    // La progression a toujours une valeur, nulle quand elle est d�sactiv�e
+    if( strtod( program.getOption( JapaOptions::PROGRESS ).c_str(), 
+                NULL ) != 0 )
+    {
+        throw Exception( std::string( "The option -" ) + 
+                         JapaOptions::PROGRESS + 
+                         " is not available to requests" );
+    }
+
+    program.setArgument( JapaOptions::SOURCE_FILE, request.source );
+    program.setArgument( JapaOptions::TARGET_FILE, request.target );
+
+    // Des fichiers vers un fichier : l'alignement habituel suffit
+    if( source.empty() && target.empty() && !request.output.empty() )
+    {
+        program.setArgument( JapaOptions::OUTPUT_FILE, request.output );
+        program.run();
+
+        return alignment;
+    }
+
+    // Sinon, les textes et la solution restent en m�moire
+    if( program.getOption( JapaOptions::INPUT_COMPRESSION )[ 0 ] == 
+        JapaOptions::INPUT_COMPRESSION_GZIP )
+    {
+        throw Exception( "Compressed input needs files, both for the texts "
+                         "and for the alignment" );
+    }
+
+    if( source.empty() )
+    {
+        source = readFile( request.source );
+    }
+
+    if( target.empty() )
+    {
+        target = readFile( request.target );
+    }
+
+    if( !request.output.empty() )
+    {
+        output = fopen( request.output.c_str(), "w" );
+    }
+    else
+    {
+        output = open_memstream( &buffer, &size );
+    }
+
+    if( output == NULL )
+    {
+        throw Exception( "Can't write solution to file : " + request.output );
+    }
+
+    try
+    {
+        program.align( source, target, JapaProgram::SynonymList(), output );
+    }
+    catch( ... )
+    {
+        fclose( output );
+        free( buffer );
+        throw;
+    }
+
+    failed = fclose( output ) != 0;
+
+    if( buffer != NULL )
+    {
+        alignment.assign( buffer, size );
+        free( buffer );
+    }
+
+    if( failed )
+    {
+        throw Exception( "Can't write solution to file : " + request.output );
+    }
+
+    return alignment;
+}
+
+// ------------------------------------------------------------------------ //
+void JapaServer::parseRequest( const std::string& line, Request& request )
+{
+    size_t pos = 0;
+    size_t begin;
+    std::string key;
+    std::string value;
+    bool more;
+
+    skipSpaces( line, pos );
+    expect( line, pos, '{' );
+    more = pos < line.size() && line[ pos ] != '}';
+
+    while( more )
+    {
+        key = parseString( line, pos );
+        expect( line, pos, ':' );
+        begin = pos;
+
+        if( key == "options" )
+        {
+            // Un tableau de cha�nes, comme sur la ligne de commande
+            expect( line, pos, '[' );
+
+            while( pos < line.size() && line[ pos ] != ']' )
+            {
+                request.options.push_back( parseString( line, pos ) );
+
+                if( pos < line.size() && line[ pos ] == ',' )
+                {
+                    expect( line, pos, ',' );
+                }
+            }
+
+            expect( line, pos, ']' );
+        }
+        else if( key == "id" )
+        {
+            // L'identificateur est renvoy� tel quel
+            if( pos < line.size() && line[ pos ] == '"' )
+            {
+                parseString( line, pos );
+            }
+            else
+            {
+                while( pos < line.size() &&
+                       ( isalnum( ( unsigned char )line[ pos ] ) ||
+                         strchr( "+-.", line[ pos ] ) != NULL ) )
+                {
+                    pos++;
+                }
+            }
+
+            key = line.substr( begin, pos - begin );
+            key.erase( key.find_last_not_of( " \t\r" ) + 1 );
+
+            if( key.empty() )
+            {
+                throw Exception( "Malformed request, bad id" );
+            }
+
+            request.id = key;
+            skipSpaces( line, pos );
+        }
+        else
+        {
+            value = parseString( line, pos );
+
+            if( key == "source" )
+            {
+                request.source = value;
+            }
+            else if( key == "target" )
+            {
+                request.target = value;
+            }
+            else if( key == "source_text" )
+            {
+                request.sourceText = value;
+            }
+            else if( key == "target_text" )
+            {
+                request.targetText = value;
+            }
+            else if( key == "output" )
+            {
+                request.output = value;
+            }
+            else
+            {
+                throw Exception( "Unknown request field : " + key );
+            }
+        }
+
+        more = pos < line.size() && line[ pos ] == ',';
+
+        if( more )
+        {
+            expect( line, pos, ',' );
+        }
+    }
+
+    expect( line, pos, '}' );
+}
+
+}// namespace japa
@@ -0,0 +1,316 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_JAPA_SERVER_H
+#define JAPA_JAPA_SERVER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "japaoptions.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Serveur d'alignement.
+ *
+ * Le serveur garde ses options et ses lexiques en m�moire et aligne des
+ * paires de textes � la demande.  Chaque requ�te est un objet JSON sur une
+ * ligne, lu sur l'entr�e standard ou sur un socket local :
+ *
+ * <code>{"id":1,"source":"a.txt","target":"b.txt","options":["-e","b"]}
+ * </code>
+ *
+ * Les champs <code>source</code> et <code>target</code> nomment les fichiers
+ * � aligner ; <code>source_text</code> et <code>target_text</code> donnent
+ * plut�t les textes eux-m�mes.  Les <code>options</code> s'ajoutent � celles
+ * du serveur.  La solution est �crite dans <code>output</code> s'il est
+ * donn�, sinon elle est renvoy�e dans la r�ponse :
+ *
+ * <code>{"id":1,"status":"ok","alignment":"1-1 0.5\n..."}</code>
+ *
+ * Les requ�tes sont servies en parall�le par les fils OpenMP ; les r�ponses
+ * peuvent donc arriver dans un autre ordre et reprennent l'<code>id</code> de
+ * leur requ�te.
+ * \endfrench
+ *
+ * \english
+ * Alignment server.
+ *
+ * The server keeps its options and its lexicons in memory and aligns pairs
+ * of texts on demand.  Each request is a JSON object on one line, read on
+ * the standard input or on a local socket :
+ *
+ * <code>{"id":1,"source":"a.txt","target":"b.txt","options":["-e","b"]}
+ * </code>
+ *
+ * The <code>source</code> and <code>target</code> fields name the files to
+ * align; <code>source_text</code> and <code>target_text</code> give the texts
+ * themselves instead.  The <code>options</code> are added to the server's.
+ * The solution is written to <code>output</code> when given, otherwise it is
+ * sent back in the response :
+ *
+ * <code>{"id":1,"status":"ok","alignment":"1-1 0.5\n..."}</code>
+ *
+ * The requests are served in parallel by the OpenMP threads; the responses
+ * may thus come in another order and repeat their request's
+ * <code>id</code>.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class JapaServer
+{
+public :
+    /**
+     * \french
+     * Constructeur.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     * \endenglish
+     */
+    JapaServer();
+
+    /**
+     * \french
+     * Destructeur.  Le lexique compil� au d�marrage est effac�.
+     * \endfrench
+     *
+     * \english
+     * Destructor.  The lexicon compiled at startup is deleted.
+     * \endenglish
+     */
+    virtual ~JapaServer();
+
+    /**
+     * \french
+     * Lit les options communes � toutes les requ�tes.  Les dictionnaires de
+     * synonymes textuels sont compil�s une seule fois en un lexique binaire.
+     * L'argument facultatif est le chemin du socket.
+     *
+     * @param argc La taille de <code>argv</code>.
+     * @param argv Les arguments re�us par la fonction <code>main</code>.
+     * \endfrench
+     *
+     * \english
+     * Reads the options shared by all requests.  The text synonym
+     * dictionaries are compiled only once into a binary lexicon.  The
+     * optional argument is the socket's path.
+     *
+     * @param argc <code>argv</code>'s size.
+     * @param argv The arguments received by the <code>main</code> function.
+     * \endenglish
+     */
+    void parse( int argc, char** argv );
+
+    /**
+     * \french
+     * Retourne le chemin du socket, vide pour l'entr�e standard.
+     *
+     * @return Le chemin du socket.
+     * \endfrench
+     *
+     * \english
+     * Returns the socket's path, empty for the standard input.
+     *
+     * @return The socket's path.
+     * \endenglish
+     */
+    std::string getSocket();
+
+    /**
+     * \french
+     * Traite une requ�te.
+     *
+     * @param request La requ�te, un objet JSON.
+     *
+     * @return La r�ponse, un objet JSON sans fin de ligne.
+     * \endfrench
+     *
+     * \english
+     * Handles a request.
+     *
+     * @param request The request, a JSON object.
+     *
+     * @return The response, a JSON object without an end of line.
+     * \endenglish
+     */
+    std::string handle( const std::string& request );
+
+    /**
+     * \french
+     * Sert les requ�tes d'un flux jusqu'� sa fin.  Les fils se partagent
+     * les lignes du flux.
+     *
+     * @param in Le flux des requ�tes.
+     * @param out Le flux des r�ponses.
+     * \endfrench
+     *
+     * \english
+     * Serves the requests of a stream until its end.  The threads share
+     * the stream's lines.
+     *
+     * @param in The requests' stream.
+     * @param out The responses' stream.
+     * \endenglish
+     */
+    void serve( std::FILE* in, std::FILE* out );
+
+    /**
+     * \french
+     * Sert les connexions d'un socket local sans jamais retourner.  Chaque
+     * fil sert une connexion � la fois.  Un signal ou une connexion
+     * abandonn�e sont ignor�s ; toute autre erreur d'<code>accept</code>
+     * arr�te le serveur.
+     *
+     * @param path Le chemin du socket.
+     *
+     * @throw Exception Si le socket ne peut �tre ouvert, ou si une connexion
+     *                  ne peut plus �tre accept�e.
+     * \endfrench
+     *
+     * \english
+     * Serves the connections of a local socket without ever returning.
+     * Each thread serves one connection at a time.  A signal or an aborted
+     * connection are ignored; any other <code>accept</code> error stops the
+     * server.
+     *
+     * @param path The socket's path.
+     *
+     * @throw Exception If the socket can't be opened, or if connections
+     *                  can't be accepted anymore.
+     * \endenglish
+     */
+    void listen( const std::string& path );
+
+private :
+    /**
+     * \french
+     * Une requ�te d'alignement.
+     * \endfrench
+     *
+     * \english
+     * An alignment request.
+     * \endenglish
+     */
+    struct Request
+    {
+        std::string id;             /**< L'identificateur, en JSON */
+        std::string source;         /**< Le fichier source */
+        std::string target;         /**< Le fichier cible */
+        std::string sourceText;     /**< Le texte source */
+        std::string targetText;     /**< Le texte cible */
+        std::string output;         /**< Le fichier de la solution */
+        std::vector< std::string > options; /**< Les options ajout�es */
+    };
+
+    /**
+     * \french
+     * Sert les requ�tes d'une connexion jusqu'� sa fin.
+     *
+     * @param in Le flux des requ�tes.
+     * @param out Le flux des r�ponses.
+     * \endfrench
+     *
+     * \english
+     * Serves a connection's requests until its end.
+     *
+     * @param in The requests' stream.
+     * @param out The responses' stream.
+     * \endenglish
+     */
+    void serveConnection( std::FILE* in, std::FILE* out );
+
+    /**
+     * \french
+     * Aligne les textes d'une requ�te.  Sauf pour des fichiers align�s vers
+     * un fichier, les textes et la solution restent en m�moire : aucun
+     * fichier temporaire n'est �crit.
+     *
+     * @param request La requ�te.
+     *
+     * @return La solution, vide si elle est �crite dans un fichier.
+     *
+     * @throw Exception Si l'alignement �choue.
+     * \endfrench
+     *
+     * \english
+     * Aligns a request's texts.  Except for files aligned to a file, the
+     * texts and the solution stay in memory: no temporary file is written.
+     *
+     * @param request The request.
+     *
+     * @return The solution, empty if it is written to a file.
+     *
+     * @throw Exception If the alignment fails.
+     * \endenglish
+     */
+    std::string align( const Request& request );
+
+    /**
+     * \french
+     * Analyse une requ�te JSON.
+     *
+     * @param line La requ�te.
+     * @param request Re�oit les champs de la requ�te.
+     *
+     * @throw Exception Si la requ�te est mal form�e.
+     * \endfrench
+     *
+     * \english
+     * Parses a JSON request.
+     *
+     * @param line The request.
+     * @param request Receives the request's fields.
+     *
+     * @throw Exception If the request is malformed.
+     * \endenglish
+     */
+    static void parseRequest( const std::string& line, Request& request );
+
+    /**
+     * \french
+     * Les options communes � toutes les requ�tes.
+     * \endfrench
+     *
+     * \english
+     * The options shared by all requests.
+     * \endenglish
+     */
+    JapaOptions m_options;
+
+    /**
+     * \french
+     * Le lexique compil� au d�marrage, vide s'il n'y en a pas.
+     * \endfrench
+     *
+     * \english
+     * The lexicon compiled at startup, empty if there is none.
+     * \endenglish
+     */
+    std::string m_lexicon;
+};
+
+}// namespace japa
+
+#endif
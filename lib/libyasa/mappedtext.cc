@@ -0,0 +1,161 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+using namespace std;
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "japaexception.h"
+#include "mappedtext.h"
+
+namespace japa
+{
+
+// ------------------------------------------------------------------------ //
+MappedText::MappedText() : m_data( NULL ), m_size( 0 ), m_mapped( false )
+{}
+
+// ------------------------------------------------------------------------ //
+MappedText::~MappedText()
+{
+    close();
+}
+
+// ------------------------------------------------------------------------ //
+void MappedText::open( const std::string& filename )
+{
+    int fd;
+    struct stat st;
+
+    close();
+
+    fd = ::open( filename.c_str(), O_RDONLY );
+
+    if( fd < 0 || fstat( fd, &st ) != 0 )
+    {
+        if( fd >= 0 )
+        {
+            ::close( fd );
+        }
+
+        throw Exception( "Can't read file : " + filename );
+    }
+
+    m_size = st.st_size;
+
+    // Un fichier vide ne peut �tre projet� ; il ne contient aucune ligne.
+    if( m_size != 0 )
+    {
+        m_data = mmap( NULL, m_size, PROT_READ, MAP_SHARED, fd, 0 );
+
+        if( m_data == MAP_FAILED )
+        {
+            ::close( fd );
+            m_data = NULL;
+            m_size = 0;
+            throw Exception( "Can't map file : " + filename );
+        }
+
+        madvise( m_data, m_size, MADV_SEQUENTIAL );
+        m_mapped = true;
+    }
+
+    ::close( fd );
+    findLines();
+}
+
+// ------------------------------------------------------------------------ //
+void MappedText::assign( const std::string& text )
+{
+    close();
+
+    m_data = text.empty() ? NULL : ( void* )text.data();
+    m_size = text.size();
+    findLines();
+}
+
+// ------------------------------------------------------------------------ //
+void MappedText::close()
+{
+    if( m_mapped )
+    {
+        munmap( m_data, m_size );
+    }
+
+    m_data = NULL;
+    m_size = 0;
+    m_mapped = false;
+    m_offsets.clear();
+}
+
+// ------------------------------------------------------------------------ //
+void MappedText::findLines()
+{
+    // Rep�re le d�but de chaque ligne.  Comme pour getline, une derni�re
+    // ligne sans fin de ligne compte, mais pas le vide apr�s la derni�re fin
+    // de ligne.
+    const char* base = ( const char* )m_data;
+    const char* end = base + m_size;
+    const char* line = base;
+
+    while( line < end )
+    {
+        m_offsets.push_back( line - base );
+
+        const char* eol = ( const char* )memchr( line, '\n', end - line );
+
+        line = ( eol != NULL ) ? eol + 1 : end;
+    }
+
+    m_offsets.push_back( m_size );
+}
+
+// ------------------------------------------------------------------------ //
+size_t MappedText::getSentenceCount() const
+{
+    return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+}
+
+// ------------------------------------------------------------------------ //
+const char* MappedText::getSentence( const size_t indice, 
+                                     size_t& length ) const
+{
+    const char* begin = ( const char* )m_data + m_offsets[ indice ];
+    const char* end = ( const char* )m_data + m_offsets[ indice + 1 ];
+
+    // Retire la fin de ligne
+    if( end > begin && end[ -1 ] == '\n' )
+    {
+        end--;
+    }
+
+    if( end > begin && end[ -1 ] == '\r' )
+    {
+        end--;
+    }
+
+    length = end - begin;
+
+    return begin;
+}
+
+}// namespace japa
@@ -0,0 +1,215 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#ifndef JAPA_MAPPED_TEXT_H
+#define JAPA_MAPPED_TEXT_H
+
+#include <string>
+#include <vector>
+
+namespace japa
+{
+
+/**
+ * \french
+ * Un texte � une phrase par ligne projet� en m�moire (<code>mmap</code>).
+ *
+ * Seule la position en octets du d�but de chaque ligne est m�moris�e ; le
+ * texte d'une phrase est lu directement dans la projection, sans d�codage
+ * ni copie.  Les fins de ligne <code>\\r\\n</code> sont accept�es.
+ * \endfrench
+ *
+ * \english
+ * A one sentence per line text mapped in memory (<code>mmap</code>).
+ *
+ * Only the byte offset of each line's beginning is stored; a sentence's text
+ * is read directly from the mapping, without decoding or copying.
+ * <code>\\r\\n</code> line endings are accepted.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class MappedText
+{
+public :
+    /**
+     * \french
+     * Constructeur.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     * \endenglish
+     */
+    MappedText();
+
+    /**
+     * \french
+     * Destructeur.  Lib�re la projection du fichier.
+     * \endfrench
+     *
+     * \english
+     * Destructor.  Unmaps the file.
+     * \endenglish
+     */
+    virtual ~MappedText();
+
+    /**
+     * \french
+     * Projette un fichier en m�moire et rep�re le d�but de ses lignes.
+     *
+     * @param filename Le chemin du fichier.
+     *
+     * @throw Exception Si le fichier ne peut �tre lu.
+     * \endfrench
+     *
+     * \english
+     * Maps a file in memory and locates the beginning of its lines.
+     *
+     * @param filename The file's path.
+     *
+     * @throw Exception If the file can't be read.
+     * \endenglish
+     */
+    void open( const std::string& filename );
+
+    /**
+     * \french
+     * Rep�re le d�but des lignes d'un texte d�j� en m�moire, sans le copier.
+     * Le texte doit rester en place tant que l'objet s'en sert.
+     *
+     * @param text Le texte.
+     * \endfrench
+     *
+     * \english
+     * Locates the beginning of the lines of a text already in memory,
+     * without copying it.  The text must stay in place as long as the
+     * object uses it.
+     *
+     * @param text The text.
+     * \endenglish
+     */
+    void assign( const std::string& text );
+
+    /**
+     * \french
+     * Lib�re la projection du fichier.
+     * \endfrench
+     *
+     * \english
+     * Unmaps the file.
+     * \endenglish
+     */
+    void close();
+
+    /**
+     * \french
+     * Retourne le nombre de phrases du texte.
+     *
+     * @return Le nombre de lignes du fichier.
+     * \endfrench
+     *
+     * \english
+     * Returns the text's number of sentences.
+     *
+     * @return The file's number of lines.
+     * \endenglish
+     */
+    size_t getSentenceCount() const;
+
+    /**
+     * \french
+     * Retourne le texte d'une phrase, sans sa fin de ligne.
+     *
+     * @param indice L'indice de la phrase.
+     * @param length Re�oit la longueur de la phrase en octets.
+     *
+     * @return Un pointeur vers le premier octet de la phrase.
+     * \endfrench
+     *
+     * \english
+     * Returns a sentence's text, without its line ending.
+     *
+     * @param indice The sentence's indice.
+     * @param length Receives the sentence's length in bytes.
+     *
+     * @return A pointer to the sentence's first byte.
+     * \endenglish
+     */
+    const char* getSentence( const size_t indice, size_t& length ) const;
+
+private :
+    /**
+     * \french
+     * Rep�re le d�but de chaque ligne du texte.
+     * \endfrench
+     *
+     * \english
+     * Locates the beginning of each line of the text.
+     * \endenglish
+     */
+    void findLines();
+
+    /**
+     * \french
+     * Le d�but de la projection.
+     * \endfrench
+     *
+     * \english
+     * The mapping's beginning.
+     * \endenglish
+     */
+    void* m_data;
+
+    /**
+     * \french
+     * La taille de la projection.
+     * \endfrench
+     *
+     * \english
+     * The mapping's size.
+     * \endenglish
+     */
+    size_t m_size;
+
+    /**
+     * \french
+     * Vrai si le texte est projet� depuis un fichier, et non pr�t�.
+     * \endfrench
+     *
+     * \english
+     * True if the text is mapped from a file, and not borrowed.
+     * \endenglish
+     */
+    bool m_mapped;
+
+    /**
+     * \french
+     * La position du d�but de chaque ligne, suivie de la taille du fichier.
+     * \endfrench
+     *
+     * \english
+     * Each line's beginning offset, followed by the file's size.
+     * \endenglish
+     */
+    std::vector< size_t > m_offsets;
+};
+
+}// namespace japa
+
+#endif
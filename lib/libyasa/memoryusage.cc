@@ -0,0 +1,204 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "memoryusage.h"
+#include "toolbox.h"
+
+namespace japa
+{
+
+/**
+ * Le nombre d'allocations.
+ */
+static size_t memoryAllocations = 0;
+
+/**
+ * Les octets allou�s.
+ */
+static size_t memoryAllocated = 0;
+
+/**
+ * Les octets allou�s et non lib�r�s.
+ */
+static size_t memoryLive = 0;
+
+/**
+ * Le maximum des octets vivants depuis le d�but de l'�tape courante.
+ */
+static size_t memoryPeak = 0;
+
+// ------------------------------------------------------------------------ //
+/**
+ * Rel�ve le maximum des octets vivants.
+ *
+ * @param live Le nombre d'octets vivants.
+ */
+static void raisePeak( const size_t live )
+{
+    size_t peak = memoryPeak;
+
+    while( live > peak &&
+           !__sync_bool_compare_and_swap( &memoryPeak, peak, live ) )
+    {
+        peak = memoryPeak;
+    }
+}
+
+// ------------------------------------------------------------------------ //
+MemoryUsage::Phase::Phase( const std::string& name, std::ostream* stream )
+        : m_name( name ), m_stream( stream ), m_begin(), m_outerPeak( 0 )
+{
+    if( m_stream == NULL )
+    {
+        return;
+    }
+
+    // Le maximum de l'�tape part des octets vivants � son d�but
+    m_begin = getCounters();
+    m_outerPeak = m_begin.peak;
+    memoryPeak = m_begin.live;
+}
+
+// ------------------------------------------------------------------------ //
+MemoryUsage::Phase::~Phase()
+{
+    Counters end;
+    std::string line;
+    size_t resident;
+
+    if( m_stream == NULL )
+    {
+        return;
+    }
+
+    end = getCounters();
+
+    // Une seule lecture, pour que le maximum couvre la taille affich�e
+    resident = getResidentSize();
+    line = "Memory of " + m_name + " : resident " +
+           toMegabytes( resident ) + " ( peak " +
+           toMegabytes( std::max( getPeakResidentSize(), resident ) ) + " )";
+
+    if( isCounting() )
+    {
+        bool freed = end.live < m_begin.live;
+        std::string balance = toMegabytes( freed ? m_begin.live - end.live : 
+                                                   end.live - m_begin.live );
+
+        line += ", " + toString( end.allocations - m_begin.allocations ) +
+                " allocations of " +
+                toMegabytes( end.allocated - m_begin.allocated ) +
+                ", live " + toMegabytes( end.live ) + " ( " +
+                ( freed ? "-" : "+" ) + balance + " ), peak live " + 
+                toMegabytes( end.peak );
+    }
+
+    ( *m_stream ) << '\t' << line << std::endl;
+
+    // Les �tapes englobantes gardent leur propre maximum
+    raisePeak( m_outerPeak );
+}
+
+// ------------------------------------------------------------------------ //
+bool MemoryUsage::isCounting()
+{
+    // Toute ex�cution C++ alloue avant le premier rapport
+    return memoryAllocations != 0;
+}
+
+// ------------------------------------------------------------------------ //
+void MemoryUsage::countAllocation( const size_t size )
+{
+    __sync_add_and_fetch( &memoryAllocations, 1 );
+    __sync_add_and_fetch( &memoryAllocated, size );
+    raisePeak( __sync_add_and_fetch( &memoryLive, size ) );
+}
+
+// ------------------------------------------------------------------------ //
+void MemoryUsage::countRelease( const size_t size )
+{
+    __sync_sub_and_fetch( &memoryLive, size );
+}
+
+// ------------------------------------------------------------------------ //
+MemoryUsage::Counters MemoryUsage::getCounters()
+{
+    Counters counters;
+
+    counters.allocations = memoryAllocations;
+    counters.allocated = memoryAllocated;
+    counters.live = memoryLive;
+    counters.peak = memoryPeak;
+
+    return counters;
+}
+
+// ------------------------------------------------------------------------ //
+size_t MemoryUsage::getResidentSize()
+{
+    std::FILE* statm = std::fopen( "/proc/self/statm", "r" );
+    unsigned long size;
+    unsigned long resident = 0;
+
+    if( statm == NULL )
+    {
+        return 0;
+    }
+
+    // Le deuxi�me champ est la taille r�sidente, en pages
+    if( std::fscanf( statm, "%lu %lu", &size, &resident ) != 2 )
+    {
+        resident = 0;
+    }
+
+    std::fclose( statm );
+
+    return resident * sysconf( _SC_PAGESIZE );
+}
+
+// ------------------------------------------------------------------------ //
+size_t MemoryUsage::getPeakResidentSize()
+{
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+    {
+        return 0;
+    }
+
+    // Linux donne le maximum en kilooctets.  Il n'est relev� que de temps
+    // en temps : la taille courante peut l'avoir d�j� d�pass�.
+    return std::max( ( size_t )usage.ru_maxrss * 1024, getResidentSize() );
+}
+
+// ------------------------------------------------------------------------ //
+std::string MemoryUsage::toMegabytes( const double bytes )
+{
+    char buffer[ 32 ];
+
+    std::sprintf( buffer, "%.1f MB", bytes / ( 1024 * 1024 ) );
+
+    return buffer;
+}
+
+}// namespace japa
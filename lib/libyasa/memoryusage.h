@@ -0,0 +1,291 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_MEMORY_USAGE_H
+#define JAPA_MEMORY_USAGE_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+namespace japa
+{
+
+/**
+ * \french
+ * Mesure la m�moire utilis�e par les �tapes de l'alignement.
+ *
+ * La taille r�sidente du processus est toujours disponible.  Compil�s avec
+ * <code>JAPA_MEMORY</code>, les ex�cutables remplacent aussi les op�rateurs
+ * globaux <code>new</code> et <code>delete</code> pour compter les
+ * allocations, les octets allou�s, les octets vivants et leur maximum ; les
+ * conteneurs � n�uds (dictionnaires, espaces de recherche, tables creuses)
+ * y passent tous.  La biblioth�que ne remplace jamais l'allocation des
+ * programmes qui l'utilisent.
+ * \endfrench
+ *
+ * \english
+ * Measures the memory used by the alignment's stages.
+ *
+ * The process' resident size is always available.  Compiled with
+ * <code>JAPA_MEMORY</code>, the executables also replace the global
+ * <code>new</code> and <code>delete</code> operators to count the
+ * allocations, the allocated bytes, the live bytes and their maximum; the
+ * node based containers (dictionaries, search spaces, sparse tables) all go
+ * through them.  The library never replaces the allocation of the programs
+ * using it.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class MemoryUsage
+{
+public :
+    /**
+     * \french
+     * Les compteurs des allocations, tous nuls si elles ne sont pas
+     * compt�es.
+     * \endfrench
+     *
+     * \english
+     * The allocations' counters, all null if they aren't counted.
+     * \endenglish
+     */
+    struct Counters
+    {
+        size_t allocations; /**< Le nombre d'allocations */
+        size_t allocated;   /**< Les octets allou�s */
+        size_t live;        /**< Les octets allou�s et non lib�r�s */
+        size_t peak;        /**< Le maximum des octets vivants */
+    };
+
+    /**
+     * \french
+     * Une �tape mesur�e, de sa construction � sa destruction.  Le rapport
+     * donne la taille r�sidente � la fin de l'�tape et, si les allocations
+     * sont compt�es, celles de l'�tape, son solde d'octets vivants et leur
+     * maximum pendant l'�tape.
+     * \endfrench
+     *
+     * \english
+     * A measured stage, from its construction to its destruction.  The
+     * report gives the resident size at the end of the stage and, if the
+     * allocations are counted, the stage's ones, its balance of live bytes
+     * and their maximum during the stage.
+     * \endenglish
+     */
+    class Phase
+    {
+    public :
+        /**
+         * \french
+         * Constructeur.  L'�tape commence.
+         *
+         * @param name Le nom de l'�tape.
+         * @param stream Le flux du rapport, <code>NULL</code> pour ne rien
+         *               mesurer.
+         * \endfrench
+         *
+         * \english
+         * Constructor.  The stage begins.
+         *
+         * @param name The stage's name.
+         * @param stream The report's stream, <code>NULL</code> not to
+         *               measure anything.
+         * \endenglish
+         */
+        Phase( const std::string& name, std::ostream* stream );
+
+        /**
+         * \french
+         * Destructeur.  L'�tape se termine et son rapport est �crit.
+         * \endfrench
+         *
+         * \english
+         * Destructor.  The stage ends and its report is written.
+         * \endenglish
+         */
+        ~Phase();
+
+    private :
+        /**
+         * \french
+         * Le nom de l'�tape.
+         * \endfrench
+         *
+         * \english
+         * The stage's name.
+         * \endenglish
+         */
+        std::string m_name;
+
+        /**
+         * \french
+         * Le flux du rapport.
+         * \endfrench
+         *
+         * \english
+         * The report's stream.
+         * \endenglish
+         */
+        std::ostream* m_stream;
+
+        /**
+         * \french
+         * Les compteurs au d�but de l'�tape.
+         * \endfrench
+         *
+         * \english
+         * The counters at the beginning of the stage.
+         * \endenglish
+         */
+        Counters m_begin;
+
+        /**
+         * \french
+         * Le maximum des octets vivants avant l'�tape, r�tabli � sa fin
+         * pour les �tapes englobantes.
+         * \endfrench
+         *
+         * \english
+         * The maximum of the live bytes before the stage, restored at its
+         * end for the enclosing stages.
+         * \endenglish
+         */
+        size_t m_outerPeak;
+    };
+
+    /**
+     * \french
+     * V�rifie si les allocations sont compt�es.
+     *
+     * @return <code>true</code> si le programme remplace les op�rateurs
+     *         d'allocation, comme les ex�cutables compil�s avec
+     *         <code>JAPA_MEMORY</code>.
+     * \endfrench
+     *
+     * \english
+     * Checks if the allocations are counted.
+     *
+     * @return <code>true</code> if the program replaces the allocation
+     *         operators, as the executables compiled with
+     *         <code>JAPA_MEMORY</code> do.
+     * \endenglish
+     */
+    static bool isCounting();
+
+    /**
+     * \french
+     * Compte une allocation.  Appel� par les op�rateurs de remplacement.
+     *
+     * @param size La taille allou�e, en octets.
+     * \endfrench
+     *
+     * \english
+     * Counts an allocation.  Called by the replacement operators.
+     *
+     * @param size The allocated size, in bytes.
+     * \endenglish
+     */
+    static void countAllocation( const size_t size );
+
+    /**
+     * \french
+     * Compte une lib�ration.  Appel� par les op�rateurs de remplacement.
+     *
+     * @param size La taille lib�r�e, en octets.
+     * \endfrench
+     *
+     * \english
+     * Counts a release.  Called by the replacement operators.
+     *
+     * @param size The released size, in bytes.
+     * \endenglish
+     */
+    static void countRelease( const size_t size );
+
+    /**
+     * \french
+     * Retourne les compteurs des allocations.
+     *
+     * @return Les compteurs.
+     * \endfrench
+     *
+     * \english
+     * Returns the allocations' counters.
+     *
+     * @return The counters.
+     * \endenglish
+     */
+    static Counters getCounters();
+
+    /**
+     * \french
+     * Retourne la taille r�sidente du processus.
+     *
+     * @return La taille en octets, 0 si elle n'est pas disponible.
+     * \endfrench
+     *
+     * \english
+     * Returns the process' resident size.
+     *
+     * @return The size in bytes, 0 if it is not available.
+     * \endenglish
+     */
+    static size_t getResidentSize();
+
+    /**
+     * \french
+     * Retourne la plus grande taille r�sidente atteinte par le processus,
+     * au moins la taille courante.
+     *
+     * @return La taille en octets, 0 si elle n'est pas disponible.
+     * \endfrench
+     *
+     * \english
+     * Returns the largest resident size the process reached, at least the
+     * current size.
+     *
+     * @return The size in bytes, 0 if it is not available.
+     * \endenglish
+     */
+    static size_t getPeakResidentSize();
+
+    /**
+     * \french
+     * �crit une taille en m�gaoctets.
+     *
+     * @param bytes La taille en octets.
+     *
+     * @return La taille avec une d�cimale, suivie de l'unit�.
+     * \endfrench
+     *
+     * \english
+     * Writes a size in megabytes.
+     *
+     * @param bytes The size in bytes.
+     *
+     * @return The size with one decimal, followed by the unit.
+     * \endenglish
+     */
+    static std::string toMegabytes( const double bytes );
+};
+
+}// namespace japa
+
+#endif
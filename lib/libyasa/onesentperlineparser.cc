@@ -45,14 +45,15 @@ bool OneSentPerLineParser::operator() ( std::wistream& in, Text& text )
     text.pushDivision();
     text.pushParagraph();
 
-    in.getloc();
-
     while( getline( in, line ) )
     {
-        // Analyse chaque phrase
+        // Analyse chaque phrase, avec la locale du flux
         std::wistringstream linestream( line );
 
+        linestream.imbue( in.getloc() );
+
          text.pushSentence( toString1( id ) );
+         advance();
 
         while( linestream >> word )
         {
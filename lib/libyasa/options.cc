@@ -48,13 +48,8 @@ namespace japa
 
 // ------------------------------------------------------------------------ //
 Options::Options( const std::string& optstring, const bool handleError ) 
-        : m_optstring( optstring )
-{
-    if( !handleError )
-    {
-        ::opterr = 0;
-    }
-}
+        : m_optstring( optstring ), m_handleError( handleError )
+{}
 
 // ------------------------------------------------------------------------ //
 Options::~Options()
@@ -66,6 +61,12 @@ void Options::parse( int argc, char** argv )
     int c;  // L'option de la ligne de commande
     size_t arg = 0;
     std::string value;
+
+    // getopt n'est touch qu' l'analyse de la ligne de commande
+    if( !m_handleError )
+    {
+        ::opterr = 0;
+    }
     
     // Pour chaque options
     while( ( c = getopt( argc, argv, m_optstring.c_str() ) ) != -1 ) 
@@ -137,6 +138,12 @@ void Options::setOption( const int option, const char value )
     setOption( option, s );
 }
 
+// ------------------------------------------------------------------------ //
+void Options::removeOption( const int option )
+{
+    m_options.erase( option );
+}
+
 // ------------------------------------------------------------------------ //
 bool Options::isOption( const int option ) const
 {
@@ -126,6 +126,21 @@ public :
      * @copydoc setOption(const int,const std::string&) 
      */
     void setOption( const int option, const char value );
+
+    /**
+     * \french
+     * Retire toutes les valeurs d'une option.
+     *
+     * @param option L'option � retirer.
+     * \endfrench
+     *
+     * \english
+     * Removes all of an option's values.
+     *
+     * @param option The option to remove.
+     * \endenglish
+     */
+    void removeOption( const int option );
    
     /**
      * \french
@@ -278,6 +293,17 @@ private :
      */
     const std::string m_optstring;
 
+    /** 
+     * \french
+     * Vrai si les messages d'erreur de <code>getopt</code> sont propag�s.
+     * \endfrench
+     *
+     * \english
+     * True if the <code>getopt</code> error messages are propagated.
+     * \endenglish
+     */
+    const bool m_handleError;
+
     /** 
      * \french
      * Les options du programme. 
@@ -18,6 +18,9 @@ limitations under the License.
 
 using namespace std;
 
+#include <algorithm>
+#include <vector>
+
 #include "prefixcognatefinder.h"
 #include "toolbox.h"
 
@@ -38,24 +41,34 @@ void PrefixCognateFinder::operator()( Text& source, Text& target,
     TextDictionary& srcDict = source.getDictionary();
     TextDictionary& tgtDict = target.getDictionary();
     TextDictionary::DictionaryMap::iterator word;
+    std::vector< TextDictionary::DictionaryMap::iterator > words;
+    PrefixIndex index;
+
+    buildPrefixIndex( tgtDict, validator, index );
 
-    // Pour chaque mot du dictionnaire source
+    // Pour chaque mot du dictionnaire source qui est un cognate potentiel
     for( word = srcDict.begin(); word != srcDict.end(); word++ )
     {
-        // Si le mot est un cognate potentiel
         if( validator( word -> second ) )
         {
-        	//wcout <<  word -> first << endl;
-            if( isAlphabetic( word -> first ) )
-            {
-                addPrefixCognate( word -> first, word -> second, 
-                                  validator, tgtDict );             
-            }                
-            else
-            {
-                addWordCognate( word -> first, word -> second, 
-                                validator, tgtDict );
-            }
+            words.push_back( word );
+        }
+    }
+
+    // Chaque mot source ne modifie que sa propre liste de synonymes, les mots
+    // peuvent donc �tre trait�s en parall�le (si compil� avec OpenMP).
+    #pragma omp parallel for schedule( dynamic, 256 )
+    for( long i = 0; i < ( long )words.size(); i++ )
+    {
+        if( isAlphabetic( words[ i ] -> first ) )
+        {
+            addPrefixCognate( words[ i ] -> first, words[ i ] -> second, 
+                              index );             
+        }                
+        else
+        {
+            addWordCognate( words[ i ] -> first, words[ i ] -> second, 
+                            validator, tgtDict );
         }
     }
        
@@ -96,33 +109,68 @@ void PrefixCognateFinder::addWordCognate( const wstring& word,
 }
 
 // ------------------------------------------------------------------------ //
-void PrefixCognateFinder::addPrefixCognate( const wstring& word,
-                                            WordInfo& wi,
+void PrefixCognateFinder::buildPrefixIndex( TextDictionary& tgtDict, 
                                             Validator< WordInfo >& validator,
-                                            TextDictionary& tgtDict ) const
+                                            PrefixIndex& index ) const
 {
-    if( word.size() >= getPrefixLength() )
+    TextDictionary::DictionaryMap::iterator iter;
+    PrefixEntry entry;
+
+    for( iter = tgtDict.begin(); iter != tgtDict.end(); iter++ )
     {
-        wstring beginPrefix( word, 0, getPrefixLength() );
-        wstring endPrefix( beginPrefix );
+        // Seuls les mots assez longs peuvent partager un pr�fixe
+        if( iter -> first.size() >= getPrefixLength() && 
+            validator( iter -> second ) )
+        {
+            entry.hash = hashPrefix( iter -> first );
+            entry.word = &( iter -> first );
+            entry.info = &( iter -> second );
+            index.push_back( entry );
+        }
+    }
+
+    sort( index.begin(), index.end() );
+}
+
+// ------------------------------------------------------------------------ //
+size_t PrefixCognateFinder::hashPrefix( const wstring& word ) const
+{
+    // FNV-1a sur les points de code du pr�fixe
+    size_t hash = 2166136261u;
+
+    for( size_t i = 0; i < getPrefixLength(); i++ )
+    {
+        hash ^= ( size_t )word[ i ];
+        hash *= 16777619u;
+    }
 
-        TextDictionary::DictionaryMap::const_iterator iter; 
-        TextDictionary::DictionaryMap::const_iterator end;
-        
-        // Peut �tre mauvais si le caract�re chang� est le dernier dans la table 
+    return hash;
+}
 
-        endPrefix[ endPrefix.size() - 1 ] += 1;
+// ------------------------------------------------------------------------ //
+void PrefixCognateFinder::addPrefixCognate( const wstring& word,
+                                            WordInfo& wi,
+                                            const PrefixIndex& index ) const
+{
+    if( word.size() >= getPrefixLength() )
+    {
+        PrefixEntry key;
+        PrefixIndex::const_iterator iter;
+        PrefixIndex::const_iterator end;
 
-        iter = tgtDict.lower_bound( beginPrefix );
-        end = tgtDict.lower_bound( endPrefix );
+        key.hash = hashPrefix( word );
+        iter = lower_bound( index.begin(), index.end(), key );
+        end = upper_bound( iter, index.end(), key );
 
         // Pour chaque mot dont le pr�fixe est identique dans le texte cible
         for( ; iter != end; iter++ )
         {
-            if( validator( iter -> second ) )
+            // �limine les collisions du hachage
+            if( word.compare( 0, getPrefixLength(), *( iter -> word ), 
+                              0, getPrefixLength() ) == 0 )
             {
                 // Le mot est accept� comme cognate
-                wi.addSynonym( iter -> second );
+                wi.addSynonym( *( iter -> info ) );
             }
         } 
     }
@@ -19,6 +19,8 @@ limitations under the License.
 #ifndef JAPA_PREFIX_COGNATE_FINDER_H
 #define JAPA_PREFIX_COGNATE_FINDER_H
 
+#include <vector>
+
 #include "cognatefinder.h"
 #include "text.h"
 #include "validator.h"
@@ -128,6 +130,82 @@ private :
                          Validator< WordInfo >& validator,
                          TextDictionary& tgtDict ) const;
    
+    /**
+     * \french
+     * Une entr�e de l'index des pr�fixes du texte cible.
+     * \endfrench
+     *
+     * \english
+     * An entry of the target text's prefix index.
+     * \endenglish
+     */
+    struct PrefixEntry
+    {
+        size_t hash;            /**< Prefix hash */
+        const wstring* word;    /**< Target word */
+        WordInfo* info;         /**< Target word's object */
+
+        bool operator<( const PrefixEntry& e ) const
+        {
+            return hash < e.hash;
+        }
+    };
+
+    /**
+     * \french
+     * L'index des pr�fixes : les mots cibles tri�s par hachage de leur
+     * pr�fixe, de sorte que les mots d'un m�me pr�fixe soient contigus.
+     * \endfrench
+     *
+     * \english
+     * The prefix index : the target words sorted by the hash of their
+     * prefix, so that words sharing a prefix are contiguous.
+     * \endenglish
+     */
+    typedef std::vector< PrefixEntry > PrefixIndex;
+
+    /**
+     * \french
+     * Construit l'index des pr�fixes des mots valides du texte cible.
+     *
+     * @param tgtDict Le dictionnaire cible.
+     * @param validator Le validateur de mots
+     * @param index L'index � remplir.
+     * \endfrench
+     *
+     * \english
+     * Builds the prefix index of the valid words of the target text.
+     *
+     * @param tgtDict The target text's dictionary.
+     * @param validator The word filter.
+     * @param index The index to fill.
+     * \endenglish
+     */
+    void buildPrefixIndex( TextDictionary& tgtDict, 
+                           Validator< WordInfo >& validator,
+                           PrefixIndex& index ) const;
+
+    /**
+     * \french
+     * Calcule le hachage du pr�fixe d'un mot.
+     *
+     * @param word Un mot d'au moins <code>getPrefixLength()</code> 
+     *             caract�res.
+     *
+     * @return Le hachage du pr�fixe.
+     * \endfrench
+     *
+     * \english
+     * Computes the hash of a word's prefix.
+     *
+     * @param word A word of at least <code>getPrefixLength()</code> 
+     *             characters.
+     *
+     * @return The prefix hash.
+     * \endenglish
+     */
+    size_t hashPrefix( const wstring& word ) const;
+
     /**
      * \french
      * Ajoute des cognates � un mot source dont le pr�fixe est le m�me que
@@ -135,8 +213,7 @@ private :
      *
      * @param word Le mot dans le texte source.
      * @param wi   L'objet repr�sentant le mot.
-     * @param validator Le validateur de mots
-     * @param tgtDict Le dictionnaire cible.
+     * @param index L'index des pr�fixes du texte cible.
      * \endfrench
      *
      * \english
@@ -145,15 +222,11 @@ private :
      *
      * @param word The source text's word.
      * @param wi   The source text word's object.
-     * @param validator The word filter.
-     * @param tgtDict The target text's dictionary.
-
+     * @param index The target text's prefix index.
      * \endenglish
      */
     void addPrefixCognate( const wstring& word, WordInfo& wi,
-    //void addPrefixCognate( const UTF8::String& word, WordInfo& wi,
-                           Validator< WordInfo >& validator,
-                           TextDictionary& tgtDict ) const;
+                           const PrefixIndex& index ) const;
 
     
     /** 
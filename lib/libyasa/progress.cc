@@ -0,0 +1,238 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <locale>
+#include <sys/time.h>
+
+#include "japaexception.h"
+#include "progress.h"
+#include "toolbox.h"
+
+namespace japa
+{
+
+// ------------------------------------------------------------------------ //
+Progress::Progress() 
+        : m_interval( 0 ), m_stream( NULL ), m_total( 0 ), m_done( 0 ),
+          m_nextCheck( ( size_t )-1 ), m_stride( 1 ), m_start( 0 ),
+          m_lastCheck( 0 ), m_lastReport( 0 ), m_reported( false )
+{}
+
+// ------------------------------------------------------------------------ //
+void Progress::setInterval( const double seconds )
+{
+    m_interval = seconds;
+}
+
+// ------------------------------------------------------------------------ //
+void Progress::setStream( std::ostream* stream )
+{
+    m_stream = stream;
+}
+
+// ------------------------------------------------------------------------ //
+void Progress::setFile( const std::string& filename )
+{
+    m_filename = filename;
+
+    if( !m_filename.empty() && !writeFile( now(), true ) )
+    {
+        throw Exception( "Can't write progress file : " + m_filename );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+bool Progress::isEnabled() const
+{
+    return m_interval > 0 && ( m_stream != NULL || !m_filename.empty() );
+}
+
+// ------------------------------------------------------------------------ //
+void Progress::setTask( const std::string& task )
+{
+    m_task = task;
+}
+
+// ------------------------------------------------------------------------ //
+void Progress::start( const std::string& unit, const size_t total )
+{
+    m_unit = unit;
+    m_total = total;
+    m_done = 0;
+    m_reported = false;
+
+    // Sans rapports, l'horloge n'est jamais lue
+    if( !isEnabled() )
+    {
+        m_nextCheck = ( size_t )-1;
+        return;
+    }
+
+    m_start = m_lastCheck = m_lastReport = now();
+    // Le pas double tant que les unit�s sont rapides ; une t�che de quelques
+    // unit�s lentes, comme les paires d'une liste, est donc suivie aussi
+    m_stride = 1;
+    m_nextCheck = m_stride;
+
+    if( !m_filename.empty() )
+    {
+        writeFile( m_start, false );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void Progress::finish()
+{
+    m_nextCheck = ( size_t )-1;
+
+    if( !isEnabled() )
+    {
+        return;
+    }
+
+    if( m_reported && m_stream != NULL )
+    {
+        report( now(), true );
+    }
+    else if( !m_filename.empty() )
+    {
+        writeFile( now(), true );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void Progress::check()
+{
+    double time = now();
+
+    // Vise une dizaine de lectures de l'horloge par intervalle
+    if( time - m_lastCheck < m_interval / 10 )
+    {
+        m_stride *= 2;
+    }
+    else if( time - m_lastCheck > m_interval / 2 && m_stride > 1 )
+    {
+        m_stride /= 2;
+    }
+
+    m_lastCheck = time;
+    m_nextCheck = m_done + m_stride;
+
+    if( time - m_lastReport >= m_interval )
+    {
+        report( time, false );
+        m_lastReport = time;
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void Progress::report( const double time, const bool finished )
+{
+    double elapsed = time - m_start;
+    double rate = elapsed > 0 ? m_done / elapsed : 0;
+
+    m_reported = true;
+
+    if( m_stream != NULL )
+    {
+        std::string line = m_task + " : " + toString( m_done );
+
+        if( m_total > 0 )
+        {
+            line += " / " + toString( m_total ) + " " + m_unit + " ( " + 
+                    toString( ( int )( 100.0 * m_done / m_total ) ) + 
+                    " % )";
+        }
+        else
+        {
+            line += " " + m_unit;
+        }
+
+        line += ", " + toString( ( size_t )rate ) + " " + m_unit + "/s";
+
+        if( finished )
+        {
+            line += ", done in " + toString( ( size_t )elapsed ) + " s";
+        }
+        else if( m_total > m_done && rate > 0 )
+        {
+            line += ", ETA " + 
+                    toString( ( size_t )( ( m_total - m_done ) / rate ) ) + 
+                    " s";
+        }
+
+        *m_stream << '\t' << line << std::endl;
+    }
+
+    if( !m_filename.empty() )
+    {
+        writeFile( time, finished );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+bool Progress::writeFile( const double time, const bool finished ) const
+{
+    std::string temporary = m_filename + ".tmp";
+    std::ofstream file( temporary.c_str() );
+    double elapsed = time - m_start;
+    double rate = elapsed > 0 ? m_done / elapsed : 0;
+
+    if( file.fail() )
+    {
+        return false;
+    }
+
+    // Les noms sont en ASCII et n'ont pas � �tre �chapp�s
+    file.imbue( std::locale::classic() );
+    file << "{\"task\":\"" << m_task << "\",\"unit\":\"" << m_unit 
+         << "\",\"done\":" << m_done << ",\"total\":" << m_total 
+         << ",\"elapsed\":" << elapsed << ",\"rate\":" << rate 
+         << ",\"eta\":";
+
+    if( !finished && m_total > m_done && rate > 0 )
+    {
+        file << ( m_total - m_done ) / rate;
+    }
+    else
+    {
+        file << "null";
+    }
+
+    file << ",\"finished\":" << ( finished ? "true" : "false" ) << "}\n";
+    file.close();
+
+    // Le renommage rend chaque rapport visible d'un seul coup ; un rapport
+    // perdu n'interrompt pas l'alignement
+    return !file.fail() && 
+           std::rename( temporary.c_str(), m_filename.c_str() ) == 0;
+}
+
+// ------------------------------------------------------------------------ //
+double Progress::now()
+{
+    struct timeval tv;
+
+    gettimeofday( &tv, NULL );
+
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+}// namespace japa
@@ -0,0 +1,414 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_PROGRESS_H
+#define JAPA_PROGRESS_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+namespace japa
+{
+
+/**
+ * \french
+ * Rapporte p�riodiquement l'avancement d'une t�che : la fraction des unit�s
+ * trait�es, le d�bit et le temps restant estim�.
+ *
+ * Les rapports lisibles sont �crits dans un flux, les rapports destin�s � un
+ * autre programme dans un fichier JSON remplac� � chaque rapport.  Pour que
+ * le co�t reste n�gligeable, l'horloge n'est lue qu'apr�s un pas d'unit�s
+ * ajust� pour donner une dizaine de lectures par intervalle de rapport.
+ * \endfrench
+ *
+ * \english
+ * Periodically reports the progress of a task: the fraction of the units
+ * processed, the rate and the estimated remaining time.
+ *
+ * The readable reports are written to a stream, the reports meant for
+ * another program to a JSON file replaced at each report.  So that the cost
+ * stays negligible, the clock is only read after a stride of units adjusted
+ * to give about ten reads per report interval.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class Progress
+{
+public :
+    /**
+     * \french
+     * Constructeur.  Les rapports sont d�sactiv�s.
+     * \endfrench
+     *
+     * \english
+     * Constructor.  The reports are disabled.
+     * \endenglish
+     */
+    Progress();
+
+    /**
+     * \french
+     * Fixe l'intervalle entre deux rapports.
+     *
+     * @param seconds L'intervalle en secondes, un intervalle nul d�sactivant
+     *                les rapports.
+     * \endfrench
+     *
+     * \english
+     * Sets the interval between two reports.
+     *
+     * @param seconds The interval in seconds, a null interval disabling the
+     *                reports.
+     * \endenglish
+     */
+    void setInterval( const double seconds );
+
+    /**
+     * \french
+     * Fixe le flux des rapports lisibles.
+     *
+     * @param stream Le flux, <code>NULL</code> pour ne pas en �crire.
+     * \endfrench
+     *
+     * \english
+     * Sets the stream of the readable reports.
+     *
+     * @param stream The stream, <code>NULL</code> not to write any.
+     * \endenglish
+     */
+    void setStream( std::ostream* stream );
+
+    /**
+     * \french
+     * Fixe le fichier des rapports JSON.  Le fichier est cr�� sur-le-champ.
+     *
+     * @param filename Le nom du fichier, vide pour ne pas en �crire.
+     *
+     * @throw Exception Si le fichier ne peut �tre �crit.
+     * \endfrench
+     *
+     * \english
+     * Sets the file of the JSON reports.  The file is created right away.
+     *
+     * @param filename The file's name, empty not to write any.
+     *
+     * @throw Exception If the file can't be written.
+     * \endenglish
+     */
+    void setFile( const std::string& filename );
+
+    /**
+     * \french
+     * V�rifie si des rapports sont �crits.
+     *
+     * @return <code>true</code> si un intervalle et une destination sont
+     *         fix�s.
+     * \endfrench
+     *
+     * \english
+     * Checks if reports are written.
+     *
+     * @return <code>true</code> if an interval and a destination are set.
+     * \endenglish
+     */
+    bool isEnabled() const;
+
+    /**
+     * \french
+     * Nomme les t�ches suivantes.
+     *
+     * @param task Le nom de la t�che, en ASCII.
+     * \endfrench
+     *
+     * \english
+     * Names the following tasks.
+     *
+     * @param task The task's name, in ASCII.
+     * \endenglish
+     */
+    void setTask( const std::string& task );
+
+    /**
+     * \french
+     * Commence une t�che.
+     *
+     * @param unit Le nom des unit�s trait�es, en ASCII.
+     * @param total Le nombre d'unit�s � traiter, 0 s'il est inconnu.
+     * \endfrench
+     *
+     * \english
+     * Starts a task.
+     *
+     * @param unit The name of the processed units, in ASCII.
+     * @param total The number of units to process, 0 if unknown.
+     * \endenglish
+     */
+    void start( const std::string& unit, const size_t total );
+
+    /**
+     * \french
+     * Avance la t�che.  L'horloge n'est lue qu'une fois par pas.
+     *
+     * @param count Le nombre d'unit�s trait�es.
+     * \endfrench
+     *
+     * \english
+     * Advances the task.  The clock is only read once per stride.
+     *
+     * @param count The number of processed units.
+     * \endenglish
+     */
+    void advance( const size_t count = 1 )
+    {
+        m_done += count;
+
+        if( m_done >= m_nextCheck )
+        {
+            check();
+        }
+    }
+
+    /**
+     * \french
+     * Termine la t�che.  Un dernier rapport est �crit si la t�che en a d�j�
+     * donn� un.
+     * \endfrench
+     *
+     * \english
+     * Finishes the task.  A last report is written if the task already gave
+     * one.
+     * \endenglish
+     */
+    void finish();
+
+private :
+    /**
+     * \french
+     * Lit l'horloge, ajuste le pas et �crit un rapport si l'intervalle est
+     * �coul�.
+     * \endfrench
+     *
+     * \english
+     * Reads the clock, adjusts the stride and writes a report if the
+     * interval has elapsed.
+     * \endenglish
+     */
+    void check();
+
+    /**
+     * \french
+     * �crit un rapport.
+     *
+     * @param time L'heure du rapport, en secondes.
+     * @param finished Indique si la t�che est termin�e.
+     * \endfrench
+     *
+     * \english
+     * Writes a report.
+     *
+     * @param time The report's time, in seconds.
+     * @param finished Tells if the task is finished.
+     * \endenglish
+     */
+    void report( const double time, const bool finished );
+
+    /**
+     * \french
+     * Remplace le fichier des rapports JSON.
+     *
+     * @param time L'heure du rapport, en secondes.
+     * @param finished Indique si la t�che est termin�e.
+     *
+     * @return <code>false</code> si le fichier n'a pu �tre �crit.
+     * \endfrench
+     *
+     * \english
+     * Replaces the file of the JSON reports.
+     *
+     * @param time The report's time, in seconds.
+     * @param finished Tells if the task is finished.
+     *
+     * @return <code>false</code> if the file couldn't be written.
+     * \endenglish
+     */
+    bool writeFile( const double time, const bool finished ) const;
+
+    /**
+     * \french
+     * Retourne l'heure courante.
+     *
+     * @return Le nombre de secondes depuis l'�poque.
+     * \endfrench
+     *
+     * \english
+     * Returns the current time.
+     *
+     * @return The number of seconds since the epoch.
+     * \endenglish
+     */
+    static double now();
+
+    /**
+     * \french
+     * L'intervalle entre deux rapports, en secondes.
+     * \endfrench
+     *
+     * \english
+     * The interval between two reports, in seconds.
+     * \endenglish
+     */
+    double m_interval;
+
+    /**
+     * \french
+     * Le flux des rapports lisibles.
+     * \endfrench
+     *
+     * \english
+     * The stream of the readable reports.
+     * \endenglish
+     */
+    std::ostream* m_stream;
+
+    /**
+     * \french
+     * Le fichier des rapports JSON.
+     * \endfrench
+     *
+     * \english
+     * The file of the JSON reports.
+     * \endenglish
+     */
+    std::string m_filename;
+
+    /**
+     * \french
+     * Le nom de la t�che.
+     * \endfrench
+     *
+     * \english
+     * The task's name.
+     * \endenglish
+     */
+    std::string m_task;
+
+    /**
+     * \french
+     * Le nom des unit�s trait�es.
+     * \endfrench
+     *
+     * \english
+     * The name of the processed units.
+     * \endenglish
+     */
+    std::string m_unit;
+
+    /**
+     * \french
+     * Le nombre d'unit�s � traiter, 0 s'il est inconnu.
+     * \endfrench
+     *
+     * \english
+     * The number of units to process, 0 if unknown.
+     * \endenglish
+     */
+    size_t m_total;
+
+    /**
+     * \french
+     * Le nombre d'unit�s trait�es.
+     * \endfrench
+     *
+     * \english
+     * The number of processed units.
+     * \endenglish
+     */
+    size_t m_done;
+
+    /**
+     * \french
+     * Le nombre d'unit�s trait�es � partir duquel l'horloge sera lue.
+     * \endfrench
+     *
+     * \english
+     * The number of processed units from which the clock will be read.
+     * \endenglish
+     */
+    size_t m_nextCheck;
+
+    /**
+     * \french
+     * Le nombre d'unit�s entre deux lectures de l'horloge.
+     * \endfrench
+     *
+     * \english
+     * The number of units between two clock reads.
+     * \endenglish
+     */
+    size_t m_stride;
+
+    /**
+     * \french
+     * L'heure du d�but de la t�che.
+     * \endfrench
+     *
+     * \english
+     * The task's start time.
+     * \endenglish
+     */
+    double m_start;
+
+    /**
+     * \french
+     * L'heure de la derni�re lecture de l'horloge.
+     * \endfrench
+     *
+     * \english
+     * The time of the last clock read.
+     * \endenglish
+     */
+    double m_lastCheck;
+
+    /**
+     * \french
+     * L'heure du dernier rapport.
+     * \endfrench
+     *
+     * \english
+     * The time of the last report.
+     * \endenglish
+     */
+    double m_lastReport;
+
+    /**
+     * \french
+     * Indique si la t�che a donn� un rapport.
+     * \endfrench
+     *
+     * \english
+     * Tells if the task gave a report.
+     * \endenglish
+     */
+    bool m_reported;
+};
+
+}// namespace japa
+
+#endif
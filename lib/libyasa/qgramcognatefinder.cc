@@ -0,0 +1,446 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+using namespace std;
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "qgramcognatefinder.h"
+#include "toolbox.h"
+
+namespace japa
+{
+
+/**
+ * Les masques de bits d'un mot : pour chaque caract�re distinct du mot, les
+ * positions o� il appara�t.
+ */
+typedef std::vector< std::pair< wchar_t, unsigned long long > > CharMasks;
+
+/**
+ * Le nombre maximal de caract�res d'un mot pour le calcul parall�le.
+ */
+static const size_t MASK_BITS = 64;
+
+/**
+ * Construit les masques de bits d'un mot d'au plus <code>MASK_BITS</code>
+ * caract�res.
+ *
+ * @param word Le mot.
+ * @param masks Les masques, tri�s par caract�re.
+ */
+static void buildMasks( const wstring& word, CharMasks& masks );
+
+/**
+ * Calcule la longueur de la LCS de deux mots de fa�on parall�le au niveau
+ * des bits (Hyyr�, 2004).
+ *
+ * @param masks Les masques de bits du premier mot.
+ * @param length La longueur du premier mot.
+ * @param word Le second mot.
+ *
+ * @return La longueur de la LCS.
+ */
+static size_t lcsBitParallel( const CharMasks& masks, const size_t length,
+                              const wstring& word );
+
+/**
+ * Calcule la longueur de la LCS de deux mots par programmation dynamique.
+ *
+ * @param a Le premier mot.
+ * @param b Le second mot.
+ *
+ * @return La longueur de la LCS.
+ */
+static size_t lcsDynamic( const wstring& a, const wstring& b );
+
+/**
+ * V�rifie si deux mots atteignent le LCSR minimal.
+ *
+ * @param srcWord Le mot source.
+ * @param masks Les masques de bits du mot source, s'il a au plus
+ *              <code>MASK_BITS</code> caract�res.
+ * @param tgtWord Le mot cible.
+ * @param ratio Le LCSR minimal.
+ *
+ * @return <code>true</code> si les mots sont cognates.
+ */
+static bool reachesRatio( const wstring& srcWord, const CharMasks& masks,
+                          const wstring& tgtWord, const double ratio );
+
+// ------------------------------------------------------------------------ //
+QGramCognateFinder::QGramCognateFinder( const size_t length, 
+                                        const double ratio ) 
+        : m_qgramLength( length ), m_minRatio( ratio )
+{
+}
+
+// ------------------------------------------------------------------------ //
+void QGramCognateFinder::operator()( Text& source, Text& target, 
+                                     Validator< WordInfo >& validator )
+{
+    TextDictionary& srcDict = source.getDictionary();
+    TextDictionary& tgtDict = target.getDictionary();
+    TextDictionary::DictionaryMap::iterator word;
+    std::vector< TextDictionary::DictionaryMap::iterator > words;
+    std::vector< TargetEntry > targets;
+    std::vector< std::vector< size_t > > lengths;
+    std::vector< Posting > postings;
+    std::vector< size_t > grams;
+    TargetEntry entry;
+    Posting posting;
+
+    // Indexe les q-grammes des mots cibles valides, et les mots par longueur
+    // pour ceux que le filtre ne peut �carter
+    for( word = tgtDict.begin(); word != tgtDict.end(); word++ )
+    {
+        if( validator( word -> second ) )
+        {
+            entry.word = &( word -> first );
+            entry.info = &( word -> second );
+            
+            computeGrams( word -> first, grams );
+            posting.target = targets.size();
+
+            for( size_t i = 0; i < grams.size(); i++ )
+            {
+                posting.gram = grams[ i ];
+                postings.push_back( posting );
+            }
+
+            if( lengths.size() <= word -> first.size() )
+            {
+                lengths.resize( word -> first.size() + 1 );
+            }
+
+            lengths[ word -> first.size() ].push_back( targets.size() );
+            targets.push_back( entry );
+        }
+    }
+
+    sort( postings.begin(), postings.end() );
+
+    // Les mots source qui sont des cognates potentiels
+    for( word = srcDict.begin(); word != srcDict.end(); word++ )
+    {
+        if( validator( word -> second ) )
+        {
+            words.push_back( word );
+        }
+    }
+
+    // Chaque mot source ne modifie que sa propre liste de synonymes, les mots
+    // peuvent donc �tre trait�s en parall�le (si compil� avec OpenMP).
+    #pragma omp parallel
+    {
+        std::vector< size_t > srcGrams;
+        std::vector< size_t > counts( targets.size(), 0 );
+        std::vector< size_t > touched;
+        std::vector< Posting >::const_iterator iter;
+        std::vector< Posting >::const_iterator end;
+        CharMasks masks;
+        Posting key;
+
+        #pragma omp for schedule( dynamic, 256 )
+        for( long i = 0; i < ( long )words.size(); i++ )
+        {
+            const wstring& srcWord = words[ i ] -> first;
+            WordInfo& wi = words[ i ] -> second;
+            
+            if( !isAlphabetic( srcWord ) )
+            {
+                // Les mots non alphab�tiques doivent �tre identiques
+                TextDictionary::DictionaryMap::iterator tgtWord = 
+                        tgtDict.find( srcWord );
+
+                if( tgtWord != tgtDict.end() && 
+                    validator( tgtWord -> second ) )
+                {
+                    wi.addSynonym( tgtWord -> second );
+                }
+            }
+            else
+            {
+                size_t srcLength = srcWord.size();
+
+                // Compte les q-grammes partag�s avec chaque mot cible ; un
+                // mot plus court que q n'en a aucun
+                computeGrams( srcWord, srcGrams );
+                touched.clear();
+
+                for( size_t g = 0; g < srcGrams.size(); g++ )
+                {
+                    key.gram = srcGrams[ g ];
+                    key.target = 0;
+                    iter = lower_bound( postings.begin(), postings.end(), key );
+                    
+                    for( ; iter != postings.end() && iter -> gram == key.gram;
+                         iter++ )
+                    {
+                        if( counts[ iter -> target ]++ == 0 )
+                        {
+                            touched.push_back( iter -> target );
+                        }
+                    }
+                }
+
+                if( srcLength <= MASK_BITS )
+                {
+                    buildMasks( srcWord, masks );
+                }
+
+                // V�rifie chaque candidat qui partage assez de q-grammes
+                for( size_t t = 0; t < touched.size(); t++ )
+                {
+                    const TargetEntry& candidate = targets[ touched[ t ] ];
+                    long bound = minSharedGrams( srcLength, 
+                                                 candidate.word -> size() );
+
+                    if( bound > 0 && 
+                        ( long )counts[ touched[ t ] ] >= bound &&
+                        reachesRatio( srcWord, masks, *candidate.word, 
+                                      getMinRatio() ) )
+                    {
+                        // Le mot est accept� comme cognate
+                        wi.addSynonym( *candidate.info );
+                    }
+
+                    counts[ touched[ t ] ] = 0;
+                }
+
+                // L� o� la borne n'�carte rien, des cognates peuvent ne
+                // partager aucun q-gramme : tous les mots de la longueur sont
+                // v�rifi�s
+                for( size_t length = 0; length < lengths.size(); length++ )
+                {
+                    if( lengths[ length ].empty() || 
+                        minSharedGrams( srcLength, length ) > 0 )
+                    {
+                        continue;
+                    }
+
+                    for( size_t t = 0; t < lengths[ length ].size(); t++ )
+                    {
+                        const TargetEntry& candidate = 
+                                targets[ lengths[ length ][ t ] ];
+
+                        if( reachesRatio( srcWord, masks, *candidate.word, 
+                                          getMinRatio() ) )
+                        {
+                            wi.addSynonym( *candidate.info );
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void QGramCognateFinder::setQGramLength( const size_t length )
+{
+    m_qgramLength = length;
+}
+
+// ------------------------------------------------------------------------ //
+size_t QGramCognateFinder::getQGramLength() const
+{
+    return m_qgramLength;
+}
+
+// ------------------------------------------------------------------------ //
+void QGramCognateFinder::setMinRatio( const double ratio )
+{
+    m_minRatio = ratio;
+}
+
+// ------------------------------------------------------------------------ //
+double QGramCognateFinder::getMinRatio() const
+{
+    return m_minRatio;
+}
+
+// ------------------------------------------------------------------------ //
+size_t QGramCognateFinder::lcsLength( const wstring& a, const wstring& b )
+{
+    size_t lcs;
+    
+    if( a.size() <= MASK_BITS )
+    {
+        CharMasks masks;
+
+        buildMasks( a, masks );
+        lcs = lcsBitParallel( masks, a.size(), b );
+    }
+    else
+    {
+        lcs = lcsDynamic( a, b );
+    }
+
+    return lcs;
+}
+
+// ------------------------------------------------------------------------ //
+void QGramCognateFinder::computeGrams( const wstring& word, 
+                                       std::vector< size_t >& grams ) const
+{
+    grams.clear();
+
+    for( size_t i = 0; i + getQGramLength() <= word.size(); i++ )
+    {
+        // FNV-1a sur les points de code du q-gramme
+        size_t hash = 2166136261u;
+
+        for( size_t j = i; j < i + getQGramLength(); j++ )
+        {
+            hash ^= ( size_t )word[ j ];
+            hash *= 16777619u;
+        }
+
+        grams.push_back( hash );
+    }
+
+    sort( grams.begin(), grams.end() );
+}
+
+// ------------------------------------------------------------------------ //
+long QGramCognateFinder::minSharedGrams( const size_t lengthA, 
+                                         const size_t lengthB ) const
+{
+    // Une LCS de longueur l contient l - q + 1 q-grammes, dont au plus q - 1
+    // sont bris�s par chacun des caract�res hors de la LCS dans les deux mots.
+    // La borne est croissante en l, on l'�value donc � la LCS minimale.
+    long q = ( long )getQGramLength();
+    long lcs = ( long )ceil( getMinRatio() * max( lengthA, lengthB ) );
+    long others = ( long )lengthA + ( long )lengthB - 2 * lcs;
+    long shared = lcs - q + 1 - ( q - 1 ) * others;
+
+    return shared;
+}
+
+// ------------------------------------------------------------------------ //
+static bool reachesRatio( const wstring& srcWord, const CharMasks& masks,
+                          const wstring& tgtWord, const double ratio )
+{
+    size_t srcLength = srcWord.size();
+    size_t tgtLength = tgtWord.size();
+    size_t maxLength = max( srcLength, tgtLength );
+    size_t lcs;
+
+    // La LCS ne d�passe pas le plus court des deux mots
+    if( min( srcLength, tgtLength ) < ratio * maxLength )
+    {
+        return false;
+    }
+
+    if( srcLength <= MASK_BITS )
+    {
+        lcs = lcsBitParallel( masks, srcLength, tgtWord );
+    }
+    else
+    {
+        lcs = lcsDynamic( srcWord, tgtWord );
+    }
+
+    return lcs >= ratio * maxLength;
+}
+
+// ------------------------------------------------------------------------ //
+static void buildMasks( const wstring& word, CharMasks& masks )
+{
+    std::vector< std::pair< wchar_t, unsigned long long > >::iterator iter;
+    
+    masks.clear();
+
+    for( size_t i = 0; i < word.size(); i++ )
+    {
+        iter = lower_bound( masks.begin(), masks.end(), 
+                            std::make_pair( word[ i ], 0ULL ) );
+
+        if( iter == masks.end() || iter -> first != word[ i ] )
+        {
+            iter = masks.insert( iter, std::make_pair( word[ i ], 0ULL ) );
+        }
+        
+        iter -> second |= 1ULL << i;
+    }
+}
+
+// ------------------------------------------------------------------------ //
+static size_t lcsBitParallel( const CharMasks& masks, const size_t length,
+                              const wstring& word )
+{
+    unsigned long long v = ~0ULL;
+    unsigned long long u;
+    size_t lcs = 0;
+    CharMasks::const_iterator iter;
+
+    for( size_t i = 0; i < word.size(); i++ )
+    {
+        iter = lower_bound( masks.begin(), masks.end(), 
+                            std::make_pair( word[ i ], 0ULL ) );
+
+        if( iter != masks.end() && iter -> first == word[ i ] )
+        {
+            u = v & iter -> second;
+            v = ( v + u ) | ( v - u );
+        }
+    }
+
+    // La LCS est le nombre de bits nuls parmi les length premiers
+    for( size_t i = 0; i < length; i++ )
+    {
+        if( !( v & ( 1ULL << i ) ) )
+        {
+            lcs++;
+        }
+    }
+
+    return lcs;
+}
+
+// ------------------------------------------------------------------------ //
+static size_t lcsDynamic( const wstring& a, const wstring& b )
+{
+    std::vector< size_t > previous( b.size() + 1, 0 );
+    std::vector< size_t > current( b.size() + 1, 0 );
+
+    for( size_t i = 1; i <= a.size(); i++ )
+    {
+        for( size_t j = 1; j <= b.size(); j++ )
+        {
+            if( a[ i - 1 ] == b[ j - 1 ] )
+            {
+                current[ j ] = previous[ j - 1 ] + 1;
+            }
+            else
+            {
+                current[ j ] = max( previous[ j ], current[ j - 1 ] );
+            }
+        }
+
+        previous.swap( current );
+    }
+
+    return previous[ b.size() ];
+}
+
+}// namespace japa
@@ -0,0 +1,291 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#ifndef JAPA_QGRAM_COGNATE_FINDER_H
+#define JAPA_QGRAM_COGNATE_FINDER_H
+
+#include <vector>
+
+#include "cognatefinder.h"
+#include "text.h"
+#include "validator.h"
+
+namespace japa
+{
+
+/**
+ * \french
+ * Un foncteur qui consid�re comme cognates les mots dont le rapport de la
+ * plus longue sous-s�quence commune (LCSR) d�passe un seuil.
+ *
+ * Les candidats sont g�n�r�s � l'aide d'un index invers� des q-grammes du
+ * vocabulaire cible, puis v�rifi�s par un calcul de LCS parall�le au niveau
+ * des bits.  Le filtre ne perd aucune paire : quand le nombre minimal de
+ * q-grammes partag�s est nul, notamment pour les mots plus courts que q,
+ * tous les mots cibles de la longueur sont v�rifi�s.  Les mots non alphab�tiques ne sont cognates que s'ils sont
+ * identiques.
+ * \endfrench
+ *
+ * \english
+ * A fonctor that consider as cognates the words whose longest common
+ * subsequence ratio (LCSR) reaches a threshold.
+ *
+ * Candidates are generated with an inverted index of the target
+ * vocabulary's q-grams, then verified with a bit-parallel LCS
+ * computation.  The filter loses no pair: when the minimum number of shared
+ * q-grams is null, notably for words shorter than q, every target word of
+ * the length is verified.  Non alphabetic words are cognates only when identical.
+ * \endenglish
+ *
+ *
+ * @version 1.1
+ */
+class QGramCognateFinder : public CognateFinder
+{
+public :
+    /** 
+     * \french
+     * La longueur par d�faut des q-grammes. 
+     * \endfrench
+     *
+     * \english
+     * The default length of the q-grams. 
+     * \endenglish
+     */
+    static const size_t DEFAULT_QGRAM_LENGTH = 2;
+    
+    /** 
+     * \french
+     * Le LCSR minimal par d�faut de deux cognates. 
+     * \endfrench
+     *
+     * \english
+     * The default minimum LCSR of two cognates. 
+     * \endenglish
+     */
+    static const double DEFAULT_MIN_RATIO = 0.75;
+    
+    /**
+     * \french
+     * Constructeur.
+     *
+     * @param length La longueur des q-grammes.
+     * @param ratio Le LCSR minimal de deux cognates.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     *
+     * @param length The length of the q-grams. 
+     * @param ratio The minimum LCSR of two cognates.
+     * \endenglish
+     */
+    QGramCognateFinder( const size_t length = DEFAULT_QGRAM_LENGTH,
+                        const double ratio = DEFAULT_MIN_RATIO );
+    
+    void operator()( Text& source, Text& target, 
+                     Validator< WordInfo >& validator );
+   
+    /**
+     * \french
+     * Ajuste la longueur des q-grammes.
+     *
+     * @param length La nouvelle longueur des q-grammes.
+     * \endfrench
+     *
+     * \english
+     * Sets the q-grams length.
+     *
+     * @param length The new length of the q-grams. 
+     * \endenglish
+     */
+    void setQGramLength( const size_t length );
+
+    /**
+     * \french
+     * Retourne la longueur des q-grammes.
+     * 
+     * @return La longueur des q-grammes.
+     * \endfrench
+     *
+     * \english
+     * Gets the length of the q-grams.
+     *
+     * @return The length of the q-grams.
+     * \endenglish
+     */
+    size_t getQGramLength() const;
+    
+    /**
+     * \french
+     * Ajuste le LCSR minimal de deux cognates.
+     *
+     * @param ratio Le nouveau LCSR minimal, entre 0 et 1.
+     * \endfrench
+     *
+     * \english
+     * Sets the minimum LCSR of two cognates.
+     *
+     * @param ratio The new minimum LCSR, between 0 and 1. 
+     * \endenglish
+     */
+    void setMinRatio( const double ratio );
+
+    /**
+     * \french
+     * Retourne le LCSR minimal de deux cognates.
+     * 
+     * @return Le LCSR minimal.
+     * \endfrench
+     *
+     * \english
+     * Gets the minimum LCSR of two cognates.
+     *
+     * @return The minimum LCSR.
+     * \endenglish
+     */
+    double getMinRatio() const;
+
+    /**
+     * \french
+     * Calcule la longueur de la plus longue sous-s�quence commune de deux
+     * mots.  Le calcul est parall�le au niveau des bits lorsque le premier
+     * mot a au plus 64 caract�res.
+     *
+     * @param a Le premier mot.
+     * @param b Le second mot.
+     *
+     * @return La longueur de la LCS.
+     * \endfrench
+     *
+     * \english
+     * Computes the length of the longest common subsequence of two words.
+     * The computation is bit-parallel when the first word has at most 64
+     * characters.
+     *
+     * @param a The first word.
+     * @param b The second word.
+     *
+     * @return The length of the LCS.
+     * \endenglish
+     */
+    static size_t lcsLength( const wstring& a, const wstring& b );
+    
+private :
+    /**
+     * \french
+     * Une entr�e de la liste des mots cibles index�s.
+     * \endfrench
+     *
+     * \english
+     * An entry of the indexed target words list.
+     * \endenglish
+     */
+    struct TargetEntry
+    {
+        const wstring* word;    /**< Target word */
+        WordInfo* info;         /**< Target word's object */
+    };
+
+    /**
+     * \french
+     * Une occurrence d'un q-gramme dans un mot cible.
+     * \endfrench
+     *
+     * \english
+     * An occurrence of a q-gram in a target word.
+     * \endenglish
+     */
+    struct Posting
+    {
+        size_t gram;            /**< Q-gram hash */
+        size_t target;          /**< Target word index */
+
+        bool operator<( const Posting& p ) const
+        {
+            return gram < p.gram || ( gram == p.gram && target < p.target );
+        }
+    };
+
+    /**
+     * \french
+     * Calcule les hachages de toutes les occurrences des q-grammes d'un mot.
+     *
+     * @param word Le mot.
+     * @param grams Le vecteur o� mettre les hachages, tri�s.
+     * \endfrench
+     *
+     * \english
+     * Computes the hashes of every q-gram occurrence of a word.
+     *
+     * @param word The word.
+     * @param grams The vector where to put the hashes, sorted.
+     * \endenglish
+     */
+    void computeGrams( const wstring& word, std::vector< size_t >& grams ) const;
+
+    /**
+     * \french
+     * Calcule le nombre minimal de q-grammes que doivent partager deux mots
+     * pour que leur LCSR atteigne le seuil.
+     *
+     * @param lengthA La longueur du premier mot.
+     * @param lengthB La longueur du second mot.
+     *
+     * @return Le nombre minimal de q-grammes partag�s, n�gatif ou nul si la
+     *         borne ne peut �carter aucune paire.
+     * \endfrench
+     *
+     * \english
+     * Computes the minimum number of q-grams two words must share for their
+     * LCSR to reach the threshold.
+     *
+     * @param lengthA The length of the first word.
+     * @param lengthB The length of the second word.
+     *
+     * @return The minimum number of shared q-grams, negative or null if the
+     *         bound can't rule out any pair.
+     * \endenglish
+     */
+    long minSharedGrams( const size_t lengthA, const size_t lengthB ) const;
+    
+    /** 
+     * \french
+     * La longueur des q-grammes. 
+     * \endfrench
+     *
+     * \english
+     * The length of the q-grams. 
+     * \endenglish
+     */
+    size_t m_qgramLength;
+
+    /** 
+     * \french
+     * Le LCSR minimal de deux cognates. 
+     * \endfrench
+     *
+     * \english
+     * The minimum LCSR of two cognates. 
+     * \endenglish
+     */
+    double m_minRatio;
+};
+}// namespace japa
+
+#endif
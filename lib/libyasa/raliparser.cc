@@ -129,6 +129,7 @@ bool RaliParser::operator() ( std::wistream& in, Text& text )
         else if( tok.type == BEGIN_SENTENCE )
         {
             text.pushSentence( nextSID() );
+            advance();
         }
         else if( tok.type == BEGIN_PARAGRAPH )
         {
@@ -106,7 +106,7 @@ public :
      */
     RaliPrinter();
 
-    void operator()( std::wostream& out, const Solution& solution );
+    void operator()( Utf8Writer& out, const Solution& solution );
 };
 
 // ------------------------------------------------------------------------ //
@@ -116,7 +116,7 @@ RaliPrinter< T >::RaliPrinter()
 
 // ------------------------------------------------------------------------ //
 template< class T >
-void RaliPrinter< T >::operator()( std::wostream& out, const Solution& solution )
+void RaliPrinter< T >::operator()( Utf8Writer& out, const Solution& solution )
 {
     typename Solution::const_iterator iter;
     double oldScore = 0;
@@ -0,0 +1,215 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <unistd.h>
+#include <vector>
+
+#include "japaexception.h"
+#include "resultcache.h"
+
+namespace japa
+{
+
+const char ResultCache::MAGIC[ 8 ] = { 'Y', 'A', 'S', 'A', 'R', 'E', 'S', '1' };
+
+const uint64_t ResultCache::EMPTY_KEY = 14695981039346656037ULL;
+
+/** Le multiplicateur de l'empreinte FNV-1a */
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// ------------------------------------------------------------------------ //
+ResultCache::ResultCache( const std::string& filename ) 
+        : m_filename( filename )
+{
+    std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+    Header header;
+    Result result;
+
+    // Les enregistrements sont lus jusqu'au premier qui est incomplet
+    while( in.read( ( char* )&header, sizeof( header ) ) &&
+           memcmp( header.magic, MAGIC, sizeof( header.magic ) ) == 0 )
+    {
+        result.sourceCount = header.sourceCount;
+        result.targetCount = header.targetCount;
+        result.output.resize( header.size );
+
+        if( header.size > 0 && !in.read( &result.output[ 0 ], header.size ) )
+        {
+            break;
+        }
+
+        m_results[ header.key ] = result;
+    }
+}
+
+// ------------------------------------------------------------------------ //
+ResultCache::~ResultCache()
+{}
+
+// ------------------------------------------------------------------------ //
+bool ResultCache::find( const uint64_t key, Result& result ) const
+{
+    std::map< uint64_t, Result >::const_iterator iter = m_results.find( key );
+
+    if( iter == m_results.end() )
+    {
+        return false;
+    }
+
+    result = iter -> second;
+
+    return true;
+}
+
+// ------------------------------------------------------------------------ //
+void ResultCache::add( const uint64_t key, const Result& result )
+{
+    Header header;
+    std::vector< char > record( sizeof( header ) + result.output.size() );
+    ssize_t written;
+    int fd;
+
+    memcpy( header.magic, MAGIC, sizeof( header.magic ) );
+    header.key = key;
+    header.sourceCount = result.sourceCount;
+    header.targetCount = result.targetCount;
+    header.size = result.output.size();
+
+    memcpy( &record[ 0 ], &header, sizeof( header ) );
+    memcpy( &record[ 0 ] + sizeof( header ), result.output.data(), 
+            result.output.size() );
+
+    // Un seul appel d'�criture en mode ajout : les ex�cutions simultan�es
+    // n'entrem�lent pas leurs enregistrements
+    fd = ::open( m_filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0666 );
+
+    if( fd < 0 )
+    {
+        throw Exception( "Can't write result cache : " + m_filename );
+    }
+
+    do
+    {
+        written = ::write( fd, &record[ 0 ], record.size() );
+    }
+    while( written < 0 && errno == EINTR );
+
+    if( ::close( fd ) != 0 || written != ( ssize_t )record.size() )
+    {
+        throw Exception( "Can't write result cache : " + m_filename );
+    }
+
+    m_results[ key ] = result;
+}
+
+// ------------------------------------------------------------------------ //
+uint64_t ResultCache::hashFile( uint64_t key, const std::string& filename, 
+                                const bool normalize, uint64_t& size )
+{
+    char buffer[ 65536 ];
+    std::string normalized;
+    uint64_t length = 0;
+    bool lineStart = true;
+    bool blank = false;
+    std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+
+    if( in.fail() )
+    {
+        throw Exception( "Can't read file : " + filename );
+    }
+
+    size = 0;
+
+    while( in.read( buffer, sizeof( buffer ) ) || in.gcount() > 0 )
+    {
+        size += in.gcount();
+
+        if( !normalize )
+        {
+            key = hashBytes( key, buffer, in.gcount() );
+            length += in.gcount();
+            continue;
+        }
+
+        normalized.clear();
+
+        for( std::streamsize i = 0; i < in.gcount(); i++ )
+        {
+            char c = buffer[ i ];
+
+            if( c == '\r' )
+            {
+                continue;
+            }
+
+            // Les blancs ne sont �crits que devant un autre caract�re
+            if( c == ' ' || c == '\t' )
+            {
+                blank = !lineStart;
+                continue;
+            }
+
+            if( c == '\n' )
+            {
+                lineStart = true;
+            }
+            else
+            {
+                if( blank )
+                {
+                    normalized += ' ';
+                }
+
+                lineStart = false;
+            }
+
+            blank = false;
+            normalized += c;
+        }
+
+        key = hashBytes( key, normalized.data(), normalized.size() );
+        length += normalized.size();
+    }
+
+    // La taille s�pare le contenu des fichiers successifs
+    return hashBytes( key, ( const char* )&length, sizeof( length ) );
+}
+
+// ------------------------------------------------------------------------ //
+uint64_t ResultCache::hashValue( uint64_t key, const std::string& value )
+{
+    return hashBytes( key, value.c_str(), value.size() + 1 );
+}
+
+// ------------------------------------------------------------------------ //
+uint64_t ResultCache::hashBytes( uint64_t key, const char* data, 
+                                 const size_t size )
+{
+    for( size_t i = 0; i < size; i++ )
+    {
+        key = ( key ^ ( unsigned char )data[ i ] ) * FNV_PRIME;
+    }
+
+    return key;
+}
+
+}// namespace japa
@@ -0,0 +1,289 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_RESULT_CACHE_H
+#define JAPA_RESULT_CACHE_H
+
+#include <stdint.h>
+#include <map>
+#include <string>
+
+namespace japa
+{
+
+/**
+ * \french
+ * Un cache persistant des solutions d�j� calcul�es pour des paires de
+ * documents.
+ *
+ * La cl� d'une solution est une empreinte du contenu des deux documents et
+ * des options effectives de l'alignement.  Le cache est un seul fichier o�
+ * chaque solution est ajout�e � la fin, sous la forme d'un en-t�te suivi du
+ * texte de la solution tel qu'il a �t� imprim�.  Un enregistrement tronqu�
+ * marque la fin du cache.
+ * \endfrench
+ *
+ * \english
+ * A persistent cache of the solutions already computed for document pairs.
+ *
+ * A solution's key is a hash of both documents' content and of the
+ * alignment's effective options.  The cache is a single file to which each
+ * solution is appended, as a header followed by the solution's text as it
+ * was printed.  A truncated record marks the end of the cache.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class ResultCache
+{
+public :
+    /**
+     * \french
+     * La signature de chaque enregistrement.
+     * \endfrench
+     *
+     * \english
+     * Each record's signature.
+     * \endenglish
+     */
+    static const char MAGIC[ 8 ];
+
+    /**
+     * \french
+     * L'empreinte vide, point de d�part de toute cl�.
+     * \endfrench
+     *
+     * \english
+     * The empty hash, starting point of every key.
+     * \endenglish
+     */
+    static const uint64_t EMPTY_KEY;
+
+    /**
+     * \french
+     * Une solution enregistr�e.
+     * \endfrench
+     *
+     * \english
+     * A saved solution.
+     * \endenglish
+     */
+    struct Result
+    {
+        size_t sourceCount;     /**< Le nombre de phrases sources */
+        size_t targetCount;     /**< Le nombre de phrases cibles */
+        std::string output;     /**< La solution imprim�e */
+    };
+
+    /**
+     * \french
+     * L'en-t�te d'un enregistrement.
+     * \endfrench
+     *
+     * \english
+     * A record's header.
+     * \endenglish
+     */
+    struct Header
+    {
+        char magic[ 8 ];        /**< Signature */
+        uint64_t key;           /**< The solution's key */
+        uint64_t sourceCount;   /**< Number of source sentences */
+        uint64_t targetCount;   /**< Number of target sentences */
+        uint64_t size;          /**< Number of bytes of the solution */
+    };
+
+    /**
+     * \french
+     * Constructeur.  Charge les solutions du fichier de cache ; un fichier
+     * absent est un cache vide.
+     *
+     * @param filename Le nom du fichier de cache.
+     * \endfrench
+     *
+     * \english
+     * Constructor.  Loads the solutions of the cache file; a missing file is
+     * an empty cache.
+     *
+     * @param filename The cache file's name.
+     * \endenglish
+     */
+    explicit ResultCache( const std::string& filename );
+
+    /**
+     * \french
+     * Destructeur.
+     * \endfrench
+     *
+     * \english
+     * Destructor.
+     * \endenglish
+     */
+    virtual ~ResultCache();
+
+    /**
+     * \french
+     * Cherche la solution d'une cl�.
+     *
+     * @param key La cl�.
+     * @param result Re�oit la solution.
+     *
+     * @return <code>true</code> si la solution est dans le cache.
+     * \endfrench
+     *
+     * \english
+     * Looks up a key's solution.
+     *
+     * @param key The key.
+     * @param result Receives the solution.
+     *
+     * @return <code>true</code> if the solution is in the cache.
+     * \endenglish
+     */
+    bool find( const uint64_t key, Result& result ) const;
+
+    /**
+     * \french
+     * Ajoute une solution au cache.  L'enregistrement est �crit d'un seul
+     * bloc � la fin du fichier, de sorte que plusieurs ex�cutions peuvent
+     * partager le m�me cache.
+     *
+     * @param key La cl�.
+     * @param result La solution.
+     *
+     * @throw Exception Si le fichier ne peut �tre �crit.
+     * \endfrench
+     *
+     * \english
+     * Adds a solution to the cache.  The record is written as a single block
+     * at the end of the file, so that many runs can share the same cache.
+     *
+     * @param key The key.
+     * @param result The solution.
+     *
+     * @throw Exception If the file can't be written.
+     * \endenglish
+     */
+    void add( const uint64_t key, const Result& result );
+
+    /**
+     * \french
+     * Ajoute le contenu d'un fichier � une empreinte.  Normalis�, le contenu
+     * perd ses retours de chariot et les blancs en d�but et en fin de ligne,
+     * et chaque suite d'espaces et de tabulations devient une espace.
+     *
+     * @param key L'empreinte.
+     * @param filename Le nom du fichier.
+     * @param normalize Vrai pour normaliser le contenu.
+     * @param size Re�oit la taille du fichier, en octets.
+     *
+     * @return La nouvelle empreinte.
+     *
+     * @throw Exception Si le fichier ne peut �tre lu.
+     * \endfrench
+     *
+     * \english
+     * Adds a file's content to a hash.  When normalized, the content loses
+     * its carriage returns and the blanks at the beginning and end of lines,
+     * and each run of spaces and tabs becomes a single space.
+     *
+     * @param key The hash.
+     * @param filename The file's name.
+     * @param normalize True to normalize the content.
+     * @param size Receives the file's size, in bytes.
+     *
+     * @return The new hash.
+     *
+     * @throw Exception If the file can't be read.
+     * \endenglish
+     */
+    static uint64_t hashFile( uint64_t key, const std::string& filename, 
+                              const bool normalize, uint64_t& size );
+
+    /**
+     * \french
+     * Ajoute une valeur � une empreinte.
+     *
+     * @param key L'empreinte.
+     * @param value La valeur.
+     *
+     * @return La nouvelle empreinte.
+     * \endfrench
+     *
+     * \english
+     * Adds a value to a hash.
+     *
+     * @param key The hash.
+     * @param value The value.
+     *
+     * @return The new hash.
+     * \endenglish
+     */
+    static uint64_t hashValue( uint64_t key, const std::string& value );
+
+private :
+    /**
+     * \french
+     * Ajoute des octets � une empreinte ( FNV-1a sur 64 bits ).
+     *
+     * @param key L'empreinte.
+     * @param data Les octets.
+     * @param size Le nombre d'octets.
+     *
+     * @return La nouvelle empreinte.
+     * \endfrench
+     *
+     * \english
+     * Adds bytes to a hash ( 64 bits FNV-1a ).
+     *
+     * @param key The hash.
+     * @param data The bytes.
+     * @param size The number of bytes.
+     *
+     * @return The new hash.
+     * \endenglish
+     */
+    static uint64_t hashBytes( uint64_t key, const char* data, 
+                               const size_t size );
+
+    /**
+     * \french
+     * Le nom du fichier de cache.
+     * \endfrench
+     *
+     * \english
+     * The cache file's name.
+     * \endenglish
+     */
+    std::string m_filename;
+
+    /**
+     * \french
+     * Les solutions charg�es ou ajout�es, selon leur cl�.
+     * \endfrench
+     *
+     * \english
+     * The loaded or added solutions, by key.
+     * \endenglish
+     */
+    std::map< uint64_t, Result > m_results;
+};
+
+}// namespace japa
+
+#endif
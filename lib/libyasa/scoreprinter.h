@@ -112,7 +112,7 @@ public :
      */
     ScorePrinter( const std::wstring sourceName, const std::wstring targetName );
 
-    void operator()( std::wostream& out, const Solution& solution );
+    void operator()( Utf8Writer& out, const Solution& solution );
 
 private :
     /**
@@ -147,12 +147,14 @@ ScorePrinter< T >::ScorePrinter( const std::wstring sourceName,
 
 // ------------------------------------------------------------------------ //
 template< class T >
-void ScorePrinter< T >::operator()( std::wostream& out,
+void ScorePrinter< T >::operator()( Utf8Writer& out,
         const Solution& solution )
 {
+    // Deux textes vides donnent une solution vide, de score nul
     out << m_sourceName << FILENAME_SEPARATOR
         << m_targetName << SCORE_SEPARATOR
-        << solution.back().getScore() << ALIGNMENT_TERMINATOR;
+        << ( solution.empty() ? T() : solution.back().getScore() )
+        << ALIGNMENT_TERMINATOR;
 
 }
 
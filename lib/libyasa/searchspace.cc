@@ -22,6 +22,21 @@ limitations under the License.
 namespace japa
 {
 
+// ------------------------------------------------------------------------ //
+size_t SearchSpace::getPossibilityCount() const
+{
+    size_t count = 0;
+    SearchSpace::Iterator iter = getIterator();
+
+    while( iter.hasNext() )
+    {
+        iter.next();
+        count++;
+    }
+
+    return count;
+}
+
 // ------------------------------------------------------------------------ //
 SearchSpace::Iterator::Iterator( SearchSpaceIterator* iterator ) 
         : m_iterator( iterator )
@@ -19,6 +19,7 @@ limitations under the License.
 #ifndef JAPA_SEARCH_SPACE_H
 #define JAPA_SEARCH_SPACE_H
 
+#include <cstddef>
 #include <memory>
 
 
@@ -49,6 +50,17 @@ class SearchSpace
 public :
     class Iterator; 
         
+    /**
+     * \french
+     * Destructeur.
+     * \endfrench
+     *
+     * \english
+     * Destructor.
+     * \endenglish
+     */
+    virtual ~SearchSpace() {}
+
     /**
      * \french
      * Ajoute une possibilit� dans l'espace de recherche.
@@ -194,6 +206,23 @@ public :
      * \endenglish
      */
     virtual int getUpperBoundY() const = 0;
+
+    /**
+     * \french
+     * Retourne le nombre de possibilit�s de l'espace de recherche.  Par
+     * d�faut, les possibilit�s sont compt�es une � une.
+     * 
+     * @return Le nombre de possibilit�s.
+     * \endfrench
+     *
+     * \english
+     * Gets the number of possibilities of the search space.  By default, the
+     * possibilities are counted one by one.
+     *
+     * @return The number of possibilities.
+     * \endenglish
+     */
+    virtual size_t getPossibilityCount() const;
     
     /**
      * \french
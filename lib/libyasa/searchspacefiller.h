@@ -45,6 +45,16 @@ namespace japa
 class SearchSpaceFiller
 {
 public :
+    /**
+     * \french
+     * Destructeur.
+     * \endfrench
+     *
+     * \english
+     * Destructor.
+     * \endenglish
+     */
+    virtual ~SearchSpaceFiller() {}
 
     /**
      * \french
@@ -49,6 +49,12 @@ size_t SetSearchSpace::size() const
     return m_set.size();
 }
 
+// ------------------------------------------------------------------------ //
+size_t SetSearchSpace::getPossibilityCount() const
+{
+    return m_set.size();
+}
+
 // ------------------------------------------------------------------------ //
 bool SetSearchSpace::addPossibility( const int x, const int y )
 {
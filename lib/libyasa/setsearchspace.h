@@ -236,6 +236,8 @@ public :
      * \endenglish
      */
     size_t size() const;
+
+    size_t getPossibilityCount() const;
     
     bool addPossibility( const int x, const int y );
 
@@ -47,6 +47,17 @@ namespace japa
 class SolutionMarker
 {
 public :
+    /**
+     * \french
+     * Destructeur.
+     * \endfrench
+     *
+     * \english
+     * Destructor.
+     * \endenglish
+     */
+    virtual ~SolutionMarker() {}
+
     /**
      * \french
      * Fonction permettant de marquer une possibilit� dans l'espace de
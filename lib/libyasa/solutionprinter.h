@@ -20,9 +20,10 @@ limitations under the License.
 #define JAPA_SOLUTION_PRINTER_H
 
 #include <iostream>
-#include <list>
+#include <vector>
 
 #include "alignment.h"
+#include "utf8writer.h"
 
 namespace japa
 {
@@ -50,6 +51,17 @@ template< class T >
 class SolutionPrinter
 {
 public : 
+    /**
+     * \french
+     * Destructeur.
+     * \endfrench
+     *
+     * \english
+     * Destructor.
+     * \endenglish
+     */
+    virtual ~SolutionPrinter() {}
+
     /** 
      * \french
      * Le type de donn�e de la solution. 
@@ -59,7 +71,7 @@ public :
      * The solution's data type. 
      * \endenglish
      */
-    typedef std::list< Alignment< T > > Solution;
+    typedef std::vector< Alignment< T > > Solution;
 
     /**
      * \french
@@ -76,7 +88,7 @@ public :
      * @param solution The solution to print. 
      * \endenglish
      */
-    virtual void operator()( std::wostream& out, const Solution& solution ) = 0;
+    virtual void operator()( Utf8Writer& out, const Solution& solution ) = 0;
 };
 
 }// namespace japa
@@ -19,6 +19,11 @@ limitations under the License.
 #ifndef JAPA_SPARSE_DT_H
 #define JAPA_SPARSE_DT_H
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "bandmatrix.h"
 #include "dynamictable.h"
 #include "searchspace.h"
 #include "scorefunction.h"
@@ -30,6 +35,111 @@ using namespace std;
 namespace japa
 {
 
+/**
+ * \french
+ * Vide une matrice creuse avant la r�solution d'une table.
+ *
+ * @param table La matrice.
+ * @param searchSpace L'espace de recherche de la table.
+ * \endfrench
+ *
+ * \english
+ * Empties a sparse matrix before a table is solved.
+ *
+ * @param table The matrix.
+ * @param searchSpace The table's search space.
+ * \endenglish
+ */
+template< class C >
+void resetTable( SparseMatrix< C >& table, const SearchSpace& )
+{
+    table.clear();
+}
+
+/**
+ * \french
+ * Dimensionne une matrice par bandes selon l'espace de recherche avant la
+ * r�solution d'une table.
+ *
+ * @param table La matrice.
+ * @param searchSpace L'espace de recherche de la table.
+ * \endfrench
+ *
+ * \english
+ * Sizes a band matrix after the search space before a table is solved.
+ *
+ * @param table The matrix.
+ * @param searchSpace The table's search space.
+ * \endenglish
+ */
+template< class C >
+void resetTable( BandMatrix< C >& table, const SearchSpace& searchSpace )
+{
+    table.init( searchSpace );
+}
+
+/**
+ * \french
+ * Estime la m�moire qu'occuperait une matrice creuse pour un espace de
+ * recherche.
+ *
+ * @param table Un pointeur nul qui n'indique que le type de matrice.
+ * @param searchSpace L'espace de recherche de la table.
+ *
+ * @return Le nombre d'octets.
+ * \endfrench
+ *
+ * \english
+ * Estimates the memory a sparse matrix would take for a search space.
+ *
+ * @param table A null pointer only telling the type of matrix.
+ * @param searchSpace The table's search space.
+ *
+ * @return The number of bytes.
+ * \endenglish
+ */
+template< class C >
+size_t estimateTableMemory( const SparseMatrix< C >*, 
+                            const SearchSpace& searchSpace )
+{
+    size_t cells = searchSpace.getPossibilityCount();
+    size_t columns = searchSpace.getUpperBoundX() - 
+                     searchSpace.getLowerBoundX() + 1;
+
+    // Chaque case occupe un noeud allou� ( suivant, cl�, en-t�te
+    // d'allocation ) et des seaux qui doublent en croissant ; chaque
+    // colonne, une table de hachage.
+    return cells * ( sizeof( C ) + 8 * sizeof( void* ) ) + 
+           columns * 16 * sizeof( void* );
+}
+
+/**
+ * \french
+ * Estime la m�moire qu'occuperait une matrice par bandes pour un espace de
+ * recherche.
+ *
+ * @param table Un pointeur nul qui n'indique que le type de matrice.
+ * @param searchSpace L'espace de recherche de la table.
+ *
+ * @return Le nombre d'octets.
+ * \endfrench
+ *
+ * \english
+ * Estimates the memory a band matrix would take for a search space.
+ *
+ * @param table A null pointer only telling the type of matrix.
+ * @param searchSpace The table's search space.
+ *
+ * @return The number of bytes.
+ * \endenglish
+ */
+template< class C >
+size_t estimateTableMemory( const BandMatrix< C >*, 
+                            const SearchSpace& searchSpace )
+{
+    return BandMatrix< C >::estimateMemory( searchSpace );
+}
+
 /**
  * \french
  * Une table dynamique dont les solutions ne sont pas toutes consid�r�es.
@@ -41,6 +151,8 @@ namespace japa
  *       de recherche.
  *
  * @param T Le type de donn�e du score.
+ * @param Matrix Le type de matrice qui range les cases, une
+ *               <code>SparseMatrix</code> par d�faut.
  * 
  * \endfrench
  *
@@ -53,12 +165,14 @@ namespace japa
  *       <code>(UpperBoundX, UpperBoundY)</code> must be in the search space.
  *
  * @param T The score's data type.
+ * @param Matrix The type of matrix storing the cells, a
+ *               <code>SparseMatrix</code> by default.
  * \endenglish
  *
  *
  * @version 1.1
  */
-template< class T >
+template< class T, template< class > class Matrix = SparseMatrix >
 class SparseDT : public DynamicTable< T >
 {
 protected :
@@ -75,7 +189,7 @@ protected :
      * Dynamic table's data type. 
      * \endenglish
      */
-    typedef SparseMatrix< Cell > Table;
+    typedef Matrix< Cell > Table;
 
 public :
     /**
@@ -114,13 +228,86 @@ public :
      */
     virtual ~SparseDT();
     
+    /**
+     * \french
+     * R�sout la table.
+     *
+     * Si une marge d'�lagage est fix�e, les cases sont calcul�es par
+     * anti-diagonale et celles dont le score d�passe de plus de la marge le
+     * meilleur score de leur anti-diagonale sont �cart�es.  Si la derni�re
+     * case n'est alors plus reli�e � la premi�re, la table est r�solue de
+     * nouveau sans �lagage.
+     * \endfrench
+     *
+     * \english
+     * Solves the table.
+     *
+     * If a pruning margin is set, the cells are computed by anti-diagonal and
+     * those whose score exceeds the best score of their anti-diagonal by more
+     * than the margin are dropped.  If the last cell is then no longer
+     * connected to the first one, the table is solved again without pruning.
+     * \endenglish
+     */
     void solve();
 
     bool getScore( const int i, const int j, T& score ) const;
 
     typename DynamicTable< T >::Iterator getIterator() const;
+
+    void setPruningMargin( const T margin );
+
+    T getPruningMargin() const;
+
+    size_t getPrunedCount() const;
+
+    bool hasFallenBack() const;
+
+    size_t estimateMemory() const;
+
+    void setProgress( Progress* progress );
     
 private :
+    /**
+     * \french
+     * Calcule toutes les cases de l'espace de recherche.
+     * \endfrench
+     *
+     * \english
+     * Computes every cell of the search space.
+     * \endenglish
+     */
+    void solveExact();
+
+    /**
+     * \french
+     * Calcule les cases par anti-diagonale en �laguant les moins bonnes.
+     *
+     * @return <code>true</code> si la derni�re case est reli�e � la premi�re.
+     * \endfrench
+     *
+     * \english
+     * Computes the cells by anti-diagonal, pruning the worst ones.
+     *
+     * @return <code>true</code> if the last cell is connected to the first.
+     * \endenglish
+     */
+    bool solvePruned();
+
+    /**
+     * \french
+     * V�rifie que la derni�re case remonte jusqu'� la premi�re.
+     *
+     * @return <code>true</code> si la derni�re case est reli�e � la premi�re.
+     * \endfrench
+     *
+     * \english
+     * Checks that the last cell traces back to the first one.
+     *
+     * @return <code>true</code> if the last cell is connected to the first.
+     * \endenglish
+     */
+    bool isConnected() const;
+
     /** 
      * \french
      * R�f�rence vers l'espace de recherche. 
@@ -154,6 +341,50 @@ private :
      */
     Table m_table;
 
+    /** 
+     * \french
+     * La marge d'�lagage par anti-diagonale, nulle si l'�lagage est d�sactiv�.
+     * \endfrench
+     *
+     * \english
+     * The anti-diagonal pruning margin, null if the pruning is disabled. 
+     * \endenglish
+     */
+    T m_margin;
+
+    /** 
+     * \french
+     * Le nombre de cases �lagu�es lors de la derni�re r�solution. 
+     * \endfrench
+     *
+     * \english
+     * The number of cells pruned by the last solve. 
+     * \endenglish
+     */
+    size_t m_prunedCount;
+
+    /** 
+     * \french
+     * Vrai si la derni�re r�solution a �t� refaite sans �lagage. 
+     * \endfrench
+     *
+     * \english
+     * True if the last solve was done again without pruning. 
+     * \endenglish
+     */
+    bool m_fallback;
+
+    /** 
+     * \french
+     * Le rapport d'avancement, <code>NULL</code> s'il n'y en a pas.
+     * \endfrench
+     *
+     * \english
+     * The progress report, <code>NULL</code> if there is none.
+     * \endenglish
+     */
+    Progress* m_progress;
+
 protected :
     /**
      * \french
@@ -422,21 +653,49 @@ protected :
 };
 
 // ------------------------------------------------------------------------ //
-template< class T >
-SparseDT< T >::SparseDT( const SearchSpace& searchSpace, 
-                         ScoreFunction< T >& score ) 
+template< class T, template< class > class Matrix >
+SparseDT< T, Matrix >::SparseDT( const SearchSpace& searchSpace, 
+                                 ScoreFunction< T >& score ) 
         : m_searchSpace( searchSpace ),
-          m_score( score )
+          m_score( score ),
+          m_margin( 0 ),
+          m_prunedCount( 0 ),
+          m_fallback( false ),
+          m_progress( NULL )
 {}
 
 // ------------------------------------------------------------------------ //
-template< class T >
-SparseDT< T >::~SparseDT()
+template< class T, template< class > class Matrix >
+SparseDT< T, Matrix >::~SparseDT()
 {}
 
 // ------------------------------------------------------------------------ //
-template< class T >
-void SparseDT< T >::solve()
+template< class T, template< class > class Matrix >
+void SparseDT< T, Matrix >::solve()
+{
+    m_prunedCount = 0;
+    m_fallback = false;
+    resetTable( m_table, m_searchSpace );
+
+    if( m_margin > 0 )
+    {
+        // Les cases �cras�es par la r�solution exacte remplacent celles de
+        // la r�solution �lagu�e
+        if( !solvePruned() )
+        {
+            m_fallback = true;
+            solveExact();
+        }
+    }
+    else
+    {
+        solveExact();
+    }
+}
+
+// ------------------------------------------------------------------------ //
+template< class T, template< class > class Matrix >
+void SparseDT< T, Matrix >::solveExact()
 {
     int pi;     // La colonne de la case pr�c�dente
     int pj;     // La rang�e de la case pr�c�dente
@@ -445,6 +704,13 @@ void SparseDT< T >::solve()
     
     SearchSpace::Iterator iter = m_searchSpace.getIterator();    
 
+    // Le total n'est compt� que si l'avancement est rapport�
+    if( m_progress != NULL )
+    {
+        m_progress -> start( "cells", m_progress -> isEnabled() ? 
+                             m_searchSpace.getPossibilityCount() : 0 );
+    }
+
     // Pour chaque case de l'espace solution
     while( iter.hasNext() )
     {
@@ -465,12 +731,132 @@ void SparseDT< T >::solve()
         cell.setPreviousJ( pj );
         
         m_table.set( iter.x(), iter.y(), cell );
+
+        if( m_progress != NULL )
+        {
+            m_progress -> advance();
+        }
+    }
+
+    if( m_progress != NULL )
+    {
+        m_progress -> finish();
     }
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-bool SparseDT< T >::getScore( const int i, const int j, T& score ) const
+template< class T, template< class > class Matrix >
+bool SparseDT< T, Matrix >::solvePruned()
+{
+    int pi;     // La colonne de la case pr�c�dente
+    int pj;     // La rang�e de la case pr�c�dente
+    Cell cell;  // La cellule courante
+    T best = 0; // Le meilleur score de l'anti-diagonale
+    size_t end;
+    std::vector< std::pair< int, int > > cells; // ( i + j, i ) de chaque case
+    std::vector< Cell > diagonal;   // Les cases de l'anti-diagonale courante
+
+    SearchSpace::Iterator iter = m_searchSpace.getIterator();    
+
+    while( iter.hasNext() )
+    {
+        iter.next();
+        cells.push_back( std::make_pair( iter.x() + iter.y(), iter.x() ) );
+    }
+
+    // Une case ne d�pend que de cases d'anti-diagonales pr�c�dentes, les
+    // cases d'une m�me anti-diagonale peuvent donc �tre compar�es avant
+    // d'�tre conserv�es.
+    std::sort( cells.begin(), cells.end() );
+
+    if( m_progress != NULL )
+    {
+        m_progress -> start( "cells", cells.size() );
+    }
+
+    for( size_t begin = 0; begin < cells.size(); begin = end )
+    {
+        const int d = cells[ begin ].first;
+
+        diagonal.clear();
+
+        for( end = begin; end < cells.size() && cells[ end ].first == d; 
+             end++ )
+        {
+            pi = cells[ end ].second;
+            pj = d - pi;
+
+            cell.setScore( m_score( *this, pi, pj, pi, pj ) );
+            cell.setPreviousI( pi );
+            cell.setPreviousJ( pj );
+            diagonal.push_back( cell );
+
+            if( end == begin || cell.getScore() < best )
+            {
+                best = cell.getScore();
+            }
+        }
+
+        if( m_progress != NULL )
+        {
+            m_progress -> advance( end - begin );
+        }
+
+        for( size_t k = 0; k < diagonal.size(); k++ )
+        {
+            if( diagonal[ k ].getScore() <= best + m_margin )
+            {
+                m_table.set( cells[ begin + k ].second, 
+                             d - cells[ begin + k ].second, diagonal[ k ] );
+            }
+            else
+            {
+                m_prunedCount++;
+            }
+        }
+    }
+
+    if( m_progress != NULL )
+    {
+        m_progress -> finish();
+    }
+
+    return isConnected();
+}
+
+// ------------------------------------------------------------------------ //
+template< class T, template< class > class Matrix >
+bool SparseDT< T, Matrix >::isConnected() const
+{
+    int i = m_searchSpace.getUpperBoundX();
+    int j = m_searchSpace.getUpperBoundY();
+    Cell cell;
+
+    if( !m_table.get( i, j, cell ) )
+    {
+        return false;
+    }
+
+    // Par convention, la premi�re case pointe vers elle-m�me, tout comme
+    // une case qu'aucune pr�c�dente ne rejoint
+    while( cell.getPreviousI() != i || cell.getPreviousJ() != j )
+    {
+        i = cell.getPreviousI();
+        j = cell.getPreviousJ();
+
+        if( !m_table.get( i, j, cell ) )
+        {
+            return false;
+        }
+    }
+
+    return i == m_searchSpace.getLowerBoundX() && 
+           j == m_searchSpace.getLowerBoundY();
+}
+
+// ------------------------------------------------------------------------ //
+template< class T, template< class > class Matrix >
+bool SparseDT< T, Matrix >::getScore( const int i, const int j, T& score ) const
 {
     bool ret = false;
     Cell cell;
@@ -485,80 +871,136 @@ bool SparseDT< T >::getScore( const int i, const int j, T& score ) const
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-typename DynamicTable< T >::Iterator SparseDT< T >::getIterator() const
+template< class T, template< class > class Matrix >
+typename DynamicTable< T >::Iterator 
+SparseDT< T, Matrix >::getIterator() const
 {
     // L'it�rateur s'occupera lui-m�me de la destruction de l'objet 
     // nouvellement cr��.
     return typename DynamicTable< T >::Iterator( 
-            new typename SparseDT< T >::Iterator( m_table, 
-                                         m_searchSpace.getUpperBoundX(),
-                                         m_searchSpace.getUpperBoundY() ) );
+            new typename SparseDT< T, Matrix >::Iterator( m_table, 
+                                    m_searchSpace.getUpperBoundX(),
+                                    m_searchSpace.getUpperBoundY() ) );
+}
+
+
+// ------------------------------------------------------------------------ //
+template< class T, template< class > class Matrix >
+void SparseDT< T, Matrix >::setPruningMargin( const T margin )
+{
+    m_margin = margin;
+}
+
+// ------------------------------------------------------------------------ //
+template< class T, template< class > class Matrix >
+T SparseDT< T, Matrix >::getPruningMargin() const
+{
+    return m_margin;
+}
+
+// ------------------------------------------------------------------------ //
+template< class T, template< class > class Matrix >
+size_t SparseDT< T, Matrix >::getPrunedCount() const
+{
+    return m_prunedCount;
+}
+
+// ------------------------------------------------------------------------ //
+template< class T, template< class > class Matrix >
+bool SparseDT< T, Matrix >::hasFallenBack() const
+{
+    return m_fallback;
 }
 
+// ------------------------------------------------------------------------ //
+template< class T, template< class > class Matrix >
+void SparseDT< T, Matrix >::setProgress( Progress* progress )
+{
+    m_progress = progress;
+}
+
+// ------------------------------------------------------------------------ //
+template< class T, template< class > class Matrix >
+size_t SparseDT< T, Matrix >::estimateMemory() const
+{
+    size_t memory = estimateTableMemory( ( const Table* )NULL, 
+                                         m_searchSpace );
+
+    // La r�solution �lagu�e trie toutes les cases, dans un vecteur qui
+    // peut doubler en croissant
+    if( m_margin > 0 )
+    {
+        memory += 2 * m_searchSpace.getPossibilityCount() * 
+                  sizeof( std::pair< int, int > );
+    }
+
+    return memory;
+}
 
 // ------------------------------------------------------------------------ //
 // ------------------------------------------------------------------------ //
-template< class T >
-SparseDT< T >::Cell::Cell() : m_pi( 0 ), m_pj( 0 )
+template< class T, template< class > class Matrix >
+SparseDT< T, Matrix >::Cell::Cell() : m_pi( 0 ), m_pj( 0 )
 {}
 
 // ------------------------------------------------------------------------ //
-template< class T >
-SparseDT< T >::Cell::Cell( const T score, 
-                           const int pi, const int pj ) : m_score( score ),
-                                                          m_pi( pi ), 
-                                                          m_pj( pj )
+template< class T, template< class > class Matrix >
+SparseDT< T, Matrix >::Cell::Cell( const T score, 
+                                   const int pi, 
+                                   const int pj ) : m_score( score ),
+                                                    m_pi( pi ), 
+                                                    m_pj( pj )
 {}
 
 // ------------------------------------------------------------------------ //
-template< class T >
-void SparseDT< T >::Cell::setScore( const T& score )
+template< class T, template< class > class Matrix >
+void SparseDT< T, Matrix >::Cell::setScore( const T& score )
 {
     m_score = score;
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-void SparseDT< T >::Cell::setPreviousI( const int pi )
+template< class T, template< class > class Matrix >
+void SparseDT< T, Matrix >::Cell::setPreviousI( const int pi )
 {
     m_pi = pi;
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-void SparseDT< T >::Cell::setPreviousJ( const int pj )
+template< class T, template< class > class Matrix >
+void SparseDT< T, Matrix >::Cell::setPreviousJ( const int pj )
 {
     m_pj = pj;
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-T SparseDT< T >::Cell::getScore() const
+template< class T, template< class > class Matrix >
+T SparseDT< T, Matrix >::Cell::getScore() const
 {
     return m_score;
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-int SparseDT< T >::Cell::getPreviousI() const
+template< class T, template< class > class Matrix >
+int SparseDT< T, Matrix >::Cell::getPreviousI() const
 {
     return m_pi;
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-int SparseDT< T >::Cell::getPreviousJ() const
+template< class T, template< class > class Matrix >
+int SparseDT< T, Matrix >::Cell::getPreviousJ() const
 {
     return m_pj;
 }
 
 // ------------------------------------------------------------------------ //
 // ------------------------------------------------------------------------ //
-template< class T >
-SparseDT< T >::Iterator::Iterator( const Table& table, const int i, 
-                                   const int j ) : m_table( table ),
-                                                   m_cell( T(), i, j )
+template< class T, template< class > class Matrix >
+SparseDT< T, Matrix >::Iterator::Iterator( const Table& table, 
+                                           const int i, 
+                                           const int j ) : m_table( table ),
+                                                           m_cell( T(), i, j )
 {
     Cell c;
     
@@ -579,16 +1021,16 @@ SparseDT< T >::Iterator::Iterator( const Table& table, const int i,
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-bool SparseDT< T >::Iterator::hasNext() const
+template< class T, template< class > class Matrix >
+bool SparseDT< T, Matrix >::Iterator::hasNext() const
 {
     // Par convention, une cellule terminale pointe sur elle m�me
     return !( m_cell.getPreviousI() == i() && m_cell.getPreviousJ() == j() );
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-void SparseDT< T >::Iterator::next()
+template< class T, template< class > class Matrix >
+void SparseDT< T, Matrix >::Iterator::next()
 {
     m_i = m_cell.getPreviousI();
     m_j = m_cell.getPreviousJ();
@@ -597,29 +1039,29 @@ void SparseDT< T >::Iterator::next()
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-int SparseDT< T >::Iterator::i() const
+template< class T, template< class > class Matrix >
+int SparseDT< T, Matrix >::Iterator::i() const
 {
     return m_i;
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-int SparseDT< T >::Iterator::j() const
+template< class T, template< class > class Matrix >
+int SparseDT< T, Matrix >::Iterator::j() const
 {
     return m_j;
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-T SparseDT< T >::Iterator::score() const
+template< class T, template< class > class Matrix >
+T SparseDT< T, Matrix >::Iterator::score() const
 {
     return m_cell.getScore();
 }
 
 // ------------------------------------------------------------------------ //
-template< class T >
-DynamicTableIterator< T >* SparseDT< T >::Iterator::clone() const
+template< class T, template< class > class Matrix >
+DynamicTableIterator< T >* SparseDT< T, Matrix >::Iterator::clone() const
 {
     DynamicTableIterator< T >* ptr;
 
@@ -152,11 +152,31 @@ wstring Text::getSentenceID( const size_t indice ) const
     return id;
 }
 
+// ------------------------------------------------------------------------ //
+size_t Text::getDivisionCount() const
+{
+    return m_divisions.size();
+}
+
+// ------------------------------------------------------------------------ //
+size_t Text::getDivisionBegin( const size_t indice ) const
+{
+    size_t begin = m_sentences.size();
+
+    // Une division contient l'indice de son premier paragraphe
+    if( indice < m_divisions.size() && 
+        m_divisions[ indice ] < m_paragraphs.size() )
+    {
+        begin = m_paragraphs[ m_divisions[ indice ] ];
+    }
+
+    return begin;
+}
+
 // ------------------------------------------------------------------------ //
 wstring Text::prepareWord( wstring& word )
 {
-    stripAccents( word );
-    toUpperCase( word );
+    normalizeWord( word );
     return word;
 }
 
@@ -328,6 +328,43 @@ public :
      */
     wstring getSentenceID( const size_t indice ) const;
 
+    /**
+     * \french
+     * Retourne le nombre de divisions du texte.
+     *
+     * @return Le nombre de divisions.
+     * \endfrench
+     *
+     * \english
+     * Gets the number of divisions in the text.
+     *
+     * @return The number of divisions.
+     * \endenglish
+     */
+    size_t getDivisionCount() const;
+
+    /**
+     * \french
+     * Retourne l'indice de la premi�re phrase d'une division.
+     *
+     * @param indice L'indice de la division.
+     *
+     * @return L'indice de la premi�re phrase de la division, ou le nombre de
+     *         phrases si la division est vide ou l'indice invalide.
+     * \endfrench
+     *
+     * \english
+     * Gets the subscript of a division's first sentence.
+     *
+     * @param indice The division's subscript.
+     *
+     * @return The subscript of the division's first sentence, or the number
+     *         of sentences if the division is empty or the subscript is not
+     *         valid.
+     * \endenglish
+     */
+    size_t getDivisionBegin( const size_t indice ) const;
+
     /**
      * \french
      * Transformations apport�es � une cha�ne avant qu'elle ne soit stock�e.
@@ -516,6 +553,9 @@ private :
     
     // Permet d'afficher le l'objet
     friend std::ostream& operator<<( std::ostream& out, const Text& text );
+
+    // Le cache enregistre et restaure directement la structure du texte
+    friend class CorpusCache;
 };
 
 /**
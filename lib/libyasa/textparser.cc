@@ -22,11 +22,17 @@ namespace japa
 {
 
 // ------------------------------------------------------------------------ //
-TextParser::TextParser()
+TextParser::TextParser() : m_progress( NULL )
 {}
 
 // ------------------------------------------------------------------------ //
 TextParser::~TextParser()
 {}
 
+// ------------------------------------------------------------------------ //
+void TextParser::setProgress( Progress* progress )
+{
+    m_progress = progress;
+}
+
 } //namespace japa
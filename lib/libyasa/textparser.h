@@ -22,6 +22,7 @@ limitations under the License.
 #include <iostream>
 #include <string>
 
+#include "progress.h"
 #include "text.h"
 
 namespace japa
@@ -90,6 +91,56 @@ public :
      * \endenglish
      */
     virtual bool operator() ( std::wistream& in, Text& text ) = 0;
+
+    /**
+     * \french
+     * Fixe le rapport d'avancement, avanc� d'une unit� par phrase analys�e.
+     *
+     * @note Seule l'adresse est conserv�e.
+     *
+     * @param progress Le rapport d'avancement, <code>NULL</code> pour n'en
+     *                 donner aucun.
+     * \endfrench
+     *
+     * \english
+     * Sets the progress report, advanced by one unit per parsed sentence.
+     *
+     * @note Only the address is kept.
+     *
+     * @param progress The progress report, <code>NULL</code> to give none.
+     * \endenglish
+     */
+    void setProgress( Progress* progress );
+
+protected :
+    /**
+     * \french
+     * Avance le rapport d'avancement d'une phrase.
+     * \endfrench
+     *
+     * \english
+     * Advances the progress report by one sentence.
+     * \endenglish
+     */
+    void advance()
+    {
+        if( m_progress != NULL )
+        {
+            m_progress -> advance();
+        }
+    }
+
+private :
+    /**
+     * \french
+     * Le rapport d'avancement.
+     * \endfrench
+     *
+     * \english
+     * The progress report.
+     * \endenglish
+     */
+    Progress* m_progress;
 };
 
 }// namespace japa
@@ -19,37 +19,140 @@ limitations under the License.
 using namespace std;
 
 #include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <locale.h>
+#include <unistd.h>
+#include <vector>
 #include <wctype.h>
 #include <wchar.h>
 #include <boost/algorithm/string.hpp>
 #include <sstream>
 
+#include "japaexception.h"
 #include "toolbox.h"
 
 namespace japa {
 
-// ------------------------------------------------------------------------ //
-//std::string& stripAccents( std::string& str )
-wstring& stripAccents(wstring& str) {
+/**
+ * Nombre de points de code couverts par les tables de conversion : Latin-1,
+ * Latin �tendu A et B.
+ */
+static const size_t CHAR_TABLE_SIZE = 0x250;
+
+/**
+ * Les locales UTF-8 essay�es pour construire les tables, dans l'ordre.
+ */
+static const char* const CHAR_TABLE_LOCALES[] = { "en_US.UTF-8", "C.UTF-8",
+                                                  NULL };
+
+/**
+ * Tables de conversion des caract�res, index�es par point de code.
+ *
+ * Les tables reproduisent <code>iswalpha</code> et <code>towupper</code> dans
+ * une locale UTF-8 explicite, et non dans la locale courante : elles sont
+ * partag�es par tout le processus, y compris par les fils qui installent leur
+ * propre locale avec <code>uselocale</code>.  Les points de code hors des
+ * tables sont convertis dans la m�me locale, gard�e ouverte.  Sans locale
+ * UTF-8 disponible, la locale courante sert de repli.
+ */
+struct CharTables {
+	wchar_t stripped[CHAR_TABLE_SIZE];	/**< Sans accent */
+	wchar_t upper[CHAR_TABLE_SIZE];		/**< En majuscule */
+	wchar_t normal[CHAR_TABLE_SIZE];	/**< Sans accent, en majuscule */
+	bool asciiStandard;	/**< Seuls a-z changent parmi les caract�res ASCII */
+	locale_t utf8;		/**< La locale UTF-8, 0 pour la locale courante */
+
+	CharTables() {
+		static const wstring accents(L"ÇÑSÝÌÍÎÏÒÓÔÕÖÀÁÂÃÄÅÈÉÊËÙÚÛÜçñsýìíîïòóôõöàáâãäåèéêëùúûü«»");
+		static const wstring normals(L"CNSYIIIIOOOOOAAAAAAEEEEUUUUcnsyiiiioooooaaaaaaeeeeuuuu\"\"");
+
+		wstring::size_type pos;
+
+		utf8 = 0;
+
+		for (size_t i = 0; CHAR_TABLE_LOCALES[i] != NULL && utf8 == 0; i++)
+			utf8 = newlocale(LC_CTYPE_MASK, CHAR_TABLE_LOCALES[i], 0);
+
+		for (size_t c = 0; c < CHAR_TABLE_SIZE; c++) {
+			pos = accents.find((wchar_t) c);
+			stripped[c] = (pos != wstring::npos) ? normals[pos] : (wchar_t) c;
+			upper[c] = toUpper(c, utf8);
+		}
 
-	static const wstring accents(L"ÇÑSÝÌÍÎÏÒÓÔÕÖÀÁÂÃÄÅÈÉÊËÙÚÛÜçñsýìíîïòóôõöàáâãäåèéêëùúûü«»");
-	static const wstring normal(L"CNSYIIIIOOOOOAAAAAAEEEEUUUUcnsyiiiioooooaaaaaaeeeeuuuu\"\"");
+		asciiStandard = true;
 
-	wstring::size_type pos;
+		for (size_t c = 0; c < CHAR_TABLE_SIZE; c++) {
+			normal[c] = stripped[c];
 
-	//wcout << "str was: " << str << endl;
+			if ((size_t) normal[c] < CHAR_TABLE_SIZE)
+				normal[c] = upper[normal[c]];
+			else
+				normal[c] = toUpper(normal[c], utf8);
+
+			if (c < 0x80 && normal[c] != (wchar_t) 
+					((c >= L'a' && c <= L'z') ? c - 32 : c))
+				asciiStandard = false;
+		}
+	}
+
+	~CharTables() {
+		if (utf8 != 0)
+			freelocale(utf8);
+	}
+
+	/**
+	 * V�rifie si un caract�re est une lettre dans la locale des tables.
+	 *
+	 * @param c Le caract�re.
+	 *
+	 * @return <code>true</code> si le caract�re est une lettre.
+	 */
+	bool isAlpha(const wint_t c) const {
+		return utf8 == 0 ? iswalpha(c) != 0 : iswalpha_l(c, utf8) != 0;
+	}
+
+	/**
+	 * Met une lettre en majuscule dans une locale donn�e.
+	 *
+	 * @param c Le caract�re.
+	 * @param locale La locale, 0 pour la locale courante.
+	 *
+	 * @return La majuscule si le caract�re est une lettre, sinon le
+	 *         caract�re.
+	 */
+	static wchar_t toUpper(const wint_t c, const locale_t locale) {
+		if (locale == 0)
+			return iswalpha(c) ? (wchar_t) towupper(c) : (wchar_t) c;
+
+		return iswalpha_l(c, locale) ? (wchar_t) towupper_l(c, locale) :
+				(wchar_t) c;
+	}
+};
+
+/**
+ * Retourne les tables de conversion, construites au premier appel.
+ *
+ * @return Les tables de conversion.
+ */
+static const CharTables& charTables() {
+	static const CharTables tables;
+
+	return tables;
+}
+
+// ------------------------------------------------------------------------ //
+//std::string& stripAccents( std::string& str )
+wstring& stripAccents(wstring& str) {
+	const CharTables& tables = charTables();
 
 	// Change l'accent de chaque caract�re.
 	for (size_t i = 0; i < str.size(); i++) {
 
-		pos = accents.find( str[ i ] );
-
-		if( pos != wstring::npos )
-			// Un caract�re accentu� a �t� trouv�, il faut le remplacer.
-			str[i] = normal[pos];
+		if ((size_t) str[i] < CHAR_TABLE_SIZE)
+			str[i] = tables.stripped[str[i]];
 	}
 
-	//wcout << "str now is: " << str << endl;
 	return str;
 }
 
@@ -67,12 +170,13 @@ int stripSpaces(std::wistream& in) {
 
 // ------------------------------------------------------------------------ //
 bool isAlphabetic(const wstring& str) {
+	const CharTables& tables = charTables();
 	bool valid = true;
 
 	// On regarde si tous les caract�res sont alphab�tiques
 	for (wstring::size_type i = 0; i < str.size() && valid; i++) {
 
-		if (!iswalpha(str[i])) {
+		if (!tables.isAlpha(str[i])) {
 			valid = false;
 		}
 	}
@@ -82,11 +186,52 @@ bool isAlphabetic(const wstring& str) {
 
 // ------------------------------------------------------------------------ //
 wstring& toUpperCase(wstring& str) {
+	const CharTables& tables = charTables();
 
 	for (wstring::size_type i = 0; i < str.size(); i++) {
 
-		if (iswalpha(str[i]))
-		   str[i] = (wchar_t)towupper(str[i]);
+		if ((size_t) str[i] < CHAR_TABLE_SIZE)
+			str[i] = tables.upper[str[i]];
+		else
+			str[i] = CharTables::toUpper(str[i], tables.utf8);
+	}
+
+	return str;
+}
+
+// ------------------------------------------------------------------------ //
+wstring& normalizeWord(wstring& str) {
+	const CharTables& tables = charTables();
+	const size_t size = str.size();
+	unsigned int bits = 0;
+
+	if (size == 0)
+		return str;
+
+	wchar_t* s = &str[0];
+
+	// Cas fr�quent d'un mot purement ASCII : une boucle sans branchement que
+	// le compilateur peut vectoriser.
+	if (tables.asciiStandard) {
+
+		for (size_t i = 0; i < size; i++)
+			bits |= (unsigned int) s[i];
+
+		if (bits < 0x80) {
+
+			for (size_t i = 0; i < size; i++)
+				s[i] -= ((unsigned int) (s[i] - L'a') < 26u) ? 32 : 0;
+
+			return str;
+		}
+	}
+
+	for (size_t i = 0; i < size; i++) {
+
+		if ((size_t) s[i] < CHAR_TABLE_SIZE)
+			s[i] = tables.normal[s[i]];
+		else
+			s[i] = CharTables::toUpper(s[i], tables.utf8);
 	}
 
 	return str;
@@ -115,6 +260,135 @@ wstring strToWstr( string str )
 
     return ws;
 }
+
+// ------------------------------------------------------------------------ //
+string quoteJson( const string& s )
+{
+    string out( "\"" );
+    char escape[ 8 ];
+
+    for( size_t i = 0; i < s.size(); i++ )
+    {
+        switch( s[ i ] )
+        {
+        case '"' :  out += "\\\""; break;
+        case '\\' : out += "\\\\"; break;
+        case '\n' : out += "\\n"; break;
+        case '\r' : out += "\\r"; break;
+        case '\t' : out += "\\t"; break;
+
+        default :
+            if( ( unsigned char )s[ i ] < 0x20 )
+            {
+                sprintf( escape, "\\u%04x", ( unsigned char )s[ i ] );
+                out += escape;
+            }
+            else
+            {
+                out += s[ i ];
+            }
+            break;
+        }
+    }
+
+    return out + "\"";
+}
+
+// ------------------------------------------------------------------------ //
+wstring decodeUtf8( const char* data, const size_t size )
+{
+    const unsigned char* s = ( const unsigned char* )data;
+    wstring out;
+    size_t i = 0;
+
+    out.reserve( size );
+
+    while( i < size )
+    {
+        unsigned long code = s[ i ];
+        size_t length = 0;
+
+        if( code < 0x80 )
+        {
+            out += ( wchar_t )code;
+            i++;
+            continue;
+        }
+
+        if( code >= 0xC2 && code < 0xE0 )
+        {
+            length = 1;
+            code &= 0x1F;
+        }
+        else if( code >= 0xE0 && code < 0xF0 )
+        {
+            length = 2;
+            code &= 0x0F;
+        }
+        else if( code >= 0xF0 && code < 0xF5 )
+        {
+            length = 3;
+            code &= 0x07;
+        }
+
+        size_t k = 1;
+
+        while( length > 0 && k <= length && i + k < size && 
+               ( s[ i + k ] & 0xC0 ) == 0x80 )
+        {
+            code = ( code << 6 ) | ( s[ i + k ] & 0x3F );
+            k++;
+        }
+
+        // S�quence tronqu�e ou forme trop longue
+        if( length == 0 || k <= length || 
+            ( length == 2 && code < 0x800 ) || 
+            ( length == 3 && ( code < 0x10000 || code > 0x10FFFF ) ) ||
+            ( code >= 0xD800 && code < 0xE000 ) )
+        {
+            out += ( wchar_t )0xFFFD;
+            i += k;
+            continue;
+        }
+
+        out += ( wchar_t )code;
+        i += k;
+    }
+
+    return out;
+}
+
+// ------------------------------------------------------------------------ //
+string makeTemporary( const string& content )
+{
+    const char* directory = getenv( "TMPDIR" );
+    string pattern( directory != NULL ? directory : "/tmp" );
+    std::vector< char > name;
+    int fd;
+
+    pattern += "/yasa-XXXXXX";
+    name.assign( pattern.begin(), pattern.end() );
+    name.push_back( '\0' );
+    fd = mkstemp( &name[ 0 ] );
+
+    if( fd < 0 )
+    {
+        throw Exception( "Can't create temporary file : " + pattern );
+    }
+
+    if( !content.empty() &&
+        write( fd, content.c_str(), content.size() ) !=
+            ( ssize_t )content.size() )
+    {
+        close( fd );
+        unlink( &name[ 0 ] );
+        throw Exception( "Can't write temporary file : " + pattern );
+    }
+
+    close( fd );
+
+    return string( &name[ 0 ] );
+}
 // ------------------------------------------------------------------------ //
 
 }    // namespace japa
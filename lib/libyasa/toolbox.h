@@ -35,6 +35,7 @@ limitations under the License.
 using namespace std;
 
 #include <iostream>
+#include <locale>
 #include <string>
 #include <sstream>
 
@@ -119,6 +120,29 @@ bool isAlphabetic( const wstring& str );
  */
 wstring& toUpperCase( wstring& str );
 
+/**
+ * \french
+ * Enl�ve les accents et convertit en majuscules une cha�ne en une seule
+ * passe.  Le r�sultat est celui de <code>stripAccents</code> suivi de
+ * <code>toUpperCase</code>.
+ *
+ * @param str La cha�ne � normaliser.
+ * 
+ * @return La cha�ne normalis�e ( une r�f�rence vers le param�tre ).
+ * \endfrench
+ *
+ * \english
+ * Strips the accents and puts a string into upper case in a single pass.
+ * The result is the one of <code>stripAccents</code> followed by
+ * <code>toUpperCase</code>.
+ *
+ * @param str The string to normalize.
+ *
+ * @return The normalized string ( a reference to the parameter ). 
+ * \endenglish
+ */
+wstring& normalizeWord( wstring& str );
+
 /**
  * \french
  * V�rifie si un caract�re est un d�limiteur de mot.
@@ -185,6 +209,37 @@ template< class T > string toString( const T n )
     return oss.str();
 }
 
+/**
+ * \french
+ * Convertit une donn�e d'un type de base en cha�ne de caract�res, selon
+ * une locale donn�e plut�t que la locale globale.
+ *
+ * @param n La donn�e � convertir.
+ * @param locale La locale de la conversion.
+ *
+ * @return La cha�ne de caract�re d�finissant le type de base.
+ * \endfrench
+ *
+ * \english
+ * Converts a basic type data into a string, following a given locale
+ * instead of the global one.
+ *
+ * @param n The data to convert.
+ * @param locale The conversion's locale.
+ *
+ * @return The string representation of the data.
+ * \endenglish
+ */
+template< class T > string toString( const T n, const std::locale& locale )
+{
+    std::ostringstream oss;
+
+    oss.imbue( locale );
+    oss << n;
+
+    return oss.str();
+}
+
 /**
  *
  */
@@ -203,6 +258,72 @@ template< class T > wstring toString1( const T n )
  */
 wstring strToWstr( const string str );
 
+/**
+ * \french
+ * �crit une cha�ne JSON.
+ *
+ * @param s La cha�ne, encod�e en UTF-8.
+ *
+ * @return La cha�ne entre guillemets, avec ses caract�res sp�ciaux
+ *         �chapp�s.
+ * \endfrench
+ *
+ * \english
+ * Writes a JSON string.
+ *
+ * @param s The string, encoded in UTF-8.
+ *
+ * @return The string between quotes, with its special characters escaped.
+ * \endenglish
+ */
+string quoteJson( const string& s );
+
+/**
+ * \french
+ * D�code une cha�ne UTF-8.  Les s�quences invalides deviennent U+FFFD.
+ *
+ * @param data La cha�ne.
+ * @param size La taille de la cha�ne, en octets.
+ *
+ * @return La cha�ne d�cod�e.
+ * \endfrench
+ *
+ * \english
+ * Decodes a UTF-8 string.  Invalid sequences become U+FFFD.
+ *
+ * @param data The string.
+ * @param size The string's size, in bytes.
+ *
+ * @return The decoded string.
+ * \endenglish
+ */
+wstring decodeUtf8( const char* data, const size_t size );
+
+/**
+ * \french
+ * Cr�e un fichier temporaire dans <code>TMPDIR</code>, ou dans
+ * <code>/tmp</code>.
+ *
+ * @param content Le contenu du fichier.
+ *
+ * @return Le nom du fichier.
+ *
+ * @throw Exception Si le fichier ne peut �tre cr��.
+ * \endfrench
+ *
+ * \english
+ * Creates a temporary file in <code>TMPDIR</code>, or in
+ * <code>/tmp</code>.
+ *
+ * @param content The file's content.
+ *
+ * @return The file's name.
+ *
+ * @throw Exception If the file can't be created.
+ * \endenglish
+ */
+string makeTemporary( const string& content );
+
 
 
 }// namespace japa
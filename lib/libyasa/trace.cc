@@ -0,0 +1,168 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <cstdio>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "japaexception.h"
+#include "toolbox.h"
+#include "trace.h"
+
+namespace japa
+{
+
+/**
+ * Le fichier de la trace, <code>NULL</code> si elle est ferm�e.
+ */
+static std::FILE* traceFile = NULL;
+
+/**
+ * L'heure d'ouverture de la trace, en microsecondes depuis l'�poque.
+ */
+static double traceOrigin = 0;
+
+/**
+ * Le nombre d'ouvertures de la trace.
+ */
+static int traceOpenCount = 0;
+
+/**
+ * Le nombre de fils num�rot�s.
+ */
+static int traceThreadCount = 0;
+
+/**
+ * Le num�ro du fil courant, -1 s'il n'est pas encore num�rot�.
+ */
+static int traceThread = -1;
+
+/**
+ * L'ouverture de la trace o� le fil courant a �t� nomm�.
+ */
+static int traceThreadOpen = 0;
+#pragma omp threadprivate( traceThread, traceThreadOpen )
+
+// ------------------------------------------------------------------------ //
+Trace::Scope::Scope( const char* name, const std::string& pair )
+        : m_name( name ), m_begin( -1 )
+{
+    if( traceFile != NULL )
+    {
+        m_pair = pair;
+        m_begin = now();
+    }
+}
+
+// ------------------------------------------------------------------------ //
+Trace::Scope::~Scope()
+{
+    // Une trace ouverte pendant la port�e ne la voit pas commencer
+    if( m_begin >= 0 && traceFile != NULL )
+    {
+        write( m_name, m_pair, m_begin, now() );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+void Trace::open( const std::string& filename )
+{
+#ifndef JAPA_TRACE
+    throw Exception( "Tracing is not available, compile with -DJAPA_TRACE" );
+#endif
+
+    close();
+
+    traceFile = std::fopen( filename.c_str(), "w" );
+
+    if( traceFile == NULL )
+    {
+        throw Exception( "Can't write trace file : " + filename );
+    }
+
+    traceOrigin = 0;
+    traceOrigin = now();
+    traceOpenCount++;
+
+    std::fprintf( traceFile, "[\n{\"name\":\"process_name\",\"ph\":\"M\","
+                  "\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"yasa\"}}",
+                  ( int )getpid() );
+}
+
+// ------------------------------------------------------------------------ //
+void Trace::close()
+{
+    if( traceFile != NULL )
+    {
+        std::fprintf( traceFile, "\n]\n" );
+        std::fclose( traceFile );
+        traceFile = NULL;
+    }
+}
+
+// ------------------------------------------------------------------------ //
+bool Trace::isOpen()
+{
+    return traceFile != NULL;
+}
+
+// ------------------------------------------------------------------------ //
+double Trace::now()
+{
+    struct timeval tv;
+
+    gettimeofday( &tv, NULL );
+
+    return tv.tv_sec * 1e6 + tv.tv_usec - traceOrigin;
+}
+
+// ------------------------------------------------------------------------ //
+void Trace::write( const char* name, const std::string& pair,
+                   const double begin, const double end )
+{
+    std::string args = pair.empty() ?
+            "" : ",\"args\":{\"pair\":" + quoteJson( pair ) + "}";
+    int pid = getpid();
+
+    #pragma omp critical( JapaTrace )
+    {
+        // Chaque fil est nomm� une fois par trace, sous un num�ro qui le
+        // suit d'une ouverture � l'autre
+        if( traceThreadOpen != traceOpenCount )
+        {
+            if( traceThread < 0 )
+            {
+                traceThread = ++traceThreadCount;
+            }
+
+            traceThreadOpen = traceOpenCount;
+            std::fprintf( traceFile, ",\n{\"name\":\"thread_name\","
+                          "\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                          "\"args\":{\"name\":\"thread %d\"}}",
+                          pid, traceThread, traceThread );
+        }
+
+        std::fprintf( traceFile, ",\n{\"name\":\"%s\",\"cat\":\"yasa\","
+                      "\"ph\":\"X\",\"ts\":%.0f,\"dur\":%.0f,\"pid\":%d,"
+                      "\"tid\":%d%s}", name, begin, end - begin, pid,
+                      traceThread, args.c_str() );
+        std::fflush( traceFile );
+    }
+}
+
+}// namespace japa
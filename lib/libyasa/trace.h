@@ -0,0 +1,251 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifndef JAPA_TRACE_H
+#define JAPA_TRACE_H
+
+#include <string>
+
+/**
+ * \french
+ * Trace la port�e courante sous un nom et l'�tiquette d'une paire.  Sans
+ * <code>JAPA_TRACE</code> � la compilation, la macro ne produit aucun code.
+ * \endfrench
+ *
+ * \english
+ * Traces the current scope under a name and a pair's label.  Without
+ * <code>JAPA_TRACE</code> at compile time, the macro produces no code.
+ * \endenglish
+ */
+#ifdef JAPA_TRACE
+    #define JAPA_TRACE_SCOPE( name, pair ) \
+            japa::Trace::Scope japaTraceScope( name, pair )
+#else
+    #define JAPA_TRACE_SCOPE( name, pair )
+#endif
+
+namespace japa
+{
+
+/**
+ * \french
+ * �crit les �tapes de l'alignement dans une trace au format Chrome
+ * (<em>Trace Event Format</em>), lisible par Perfetto ou
+ * <code>chrome://tracing</code>.
+ *
+ * Chaque port�e trac�e devient un �v�nement complet avec son fil, son heure
+ * de d�but, sa dur�e et l'�tiquette de la paire trait�e.  Les �v�nements sont
+ * ajout�s au fichier � mesure qu'ils se terminent ; le crochet final est
+ * facultatif dans ce format, une trace interrompue reste donc lisible.
+ *
+ * Les port�es ne sont compil�es qu'avec <code>JAPA_TRACE</code>.  Quand la
+ * trace est ferm�e, une port�e ne co�te qu'un test.
+ * \endfrench
+ *
+ * \english
+ * Writes the alignment's stages to a trace in the Chrome format
+ * (<em>Trace Event Format</em>), readable by Perfetto or
+ * <code>chrome://tracing</code>.
+ *
+ * Each traced scope becomes a complete event with its thread, its start
+ * time, its duration and the label of the processed pair.  The events are
+ * appended to the file as they end; the closing bracket is optional in this
+ * format, so an interrupted trace stays readable.
+ *
+ * The scopes are only compiled with <code>JAPA_TRACE</code>.  When the
+ * trace is closed, a scope only costs a test.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class Trace
+{
+public :
+    /**
+     * \french
+     * Une port�e trac�e, de sa construction � sa destruction.
+     * \endfrench
+     *
+     * \english
+     * A traced scope, from its construction to its destruction.
+     * \endenglish
+     */
+    class Scope
+    {
+    public :
+        /**
+         * \french
+         * Constructeur.  La port�e commence.
+         *
+         * @param name Le nom de l'�tape, une constante en ASCII.
+         * @param pair L'�tiquette de la paire trait�e, vide s'il n'y en a
+         *             pas.
+         * \endfrench
+         *
+         * \english
+         * Constructor.  The scope begins.
+         *
+         * @param name The stage's name, an ASCII constant.
+         * @param pair The label of the processed pair, empty if there is
+         *             none.
+         * \endenglish
+         */
+        Scope( const char* name, const std::string& pair );
+
+        /**
+         * \french
+         * Destructeur.  La port�e se termine et son �v�nement est �crit.
+         * \endfrench
+         *
+         * \english
+         * Destructor.  The scope ends and its event is written.
+         * \endenglish
+         */
+        ~Scope();
+
+    private :
+        /**
+         * \french
+         * Le nom de l'�tape.
+         * \endfrench
+         *
+         * \english
+         * The stage's name.
+         * \endenglish
+         */
+        const char* m_name;
+
+        /**
+         * \french
+         * L'�tiquette de la paire trait�e, copi�e seulement si la trace est
+         * ouverte.
+         * \endfrench
+         *
+         * \english
+         * The label of the processed pair, only copied if the trace is open.
+         * \endenglish
+         */
+        std::string m_pair;
+
+        /**
+         * \french
+         * L'heure du d�but, en microsecondes depuis l'ouverture de la trace,
+         * n�gative si la trace �tait ferm�e.
+         * \endfrench
+         *
+         * \english
+         * The start time, in microseconds since the trace was opened,
+         * negative if the trace was closed.
+         * \endenglish
+         */
+        double m_begin;
+    };
+
+    /**
+     * \french
+     * Ouvre la trace.  Une trace d�j� ouverte est d'abord ferm�e.
+     *
+     * @param filename Le nom du fichier de la trace.
+     *
+     * @throw Exception Si le programme a �t� compil� sans
+     *                  <code>JAPA_TRACE</code> ou si le fichier ne peut
+     *                  �tre �crit.
+     * \endfrench
+     *
+     * \english
+     * Opens the trace.  A trace already open is closed first.
+     *
+     * @param filename The trace's file name.
+     *
+     * @throw Exception If the program was compiled without
+     *                  <code>JAPA_TRACE</code> or if the file can't be
+     *                  written.
+     * \endenglish
+     */
+    static void open( const std::string& filename );
+
+    /**
+     * \french
+     * Ferme la trace, si elle est ouverte.
+     * \endfrench
+     *
+     * \english
+     * Closes the trace, if it is open.
+     * \endenglish
+     */
+    static void close();
+
+    /**
+     * \french
+     * V�rifie si la trace est ouverte.
+     *
+     * @return <code>true</code> si les port�es sont �crites.
+     * \endfrench
+     *
+     * \english
+     * Checks if the trace is open.
+     *
+     * @return <code>true</code> if the scopes are written.
+     * \endenglish
+     */
+    static bool isOpen();
+
+private :
+    /**
+     * \french
+     * Retourne l'heure courante.
+     *
+     * @return Le nombre de microsecondes depuis l'ouverture de la trace.
+     * \endfrench
+     *
+     * \english
+     * Returns the current time.
+     *
+     * @return The number of microseconds since the trace was opened.
+     * \endenglish
+     */
+    static double now();
+
+    /**
+     * \french
+     * �crit un �v�nement complet.  Le premier �v�nement d'un fil nomme
+     * d'abord ce fil.
+     *
+     * @param name Le nom de l'�tape.
+     * @param pair L'�tiquette de la paire trait�e.
+     * @param begin L'heure du d�but, en microsecondes.
+     * @param end L'heure de la fin, en microsecondes.
+     * \endfrench
+     *
+     * \english
+     * Writes a complete event.  A thread's first event first names this
+     * thread.
+     *
+     * @param name The stage's name.
+     * @param pair The label of the processed pair.
+     * @param begin The start time, in microseconds.
+     * @param end The end time, in microseconds.
+     * \endenglish
+     */
+    static void write( const char* name, const std::string& pair,
+                       const double begin, const double end );
+};
+
+}// namespace japa
+
+#endif
@@ -0,0 +1,419 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#include <clocale>
+#include <cmath>
+#include <cstring>
+
+#include "utf8writer.h"
+
+using namespace std;
+
+namespace japa
+{
+
+const size_t Utf8Writer::BUFFER_SIZE;
+
+// ------------------------------------------------------------------------ //
+Utf8Writer::Utf8Writer( std::FILE* file, const std::locale& locale )
+        : m_file( file ), m_buffer( BUFFER_SIZE ), m_used( 0 ),
+          m_failed( false ), m_localized( false )
+{
+    const numpunct< wchar_t >& punct = 
+            use_facet< numpunct< wchar_t > >( locale );
+
+    // Une locale qui groupe les chiffres ou change le point d�cimal est
+    // respect�e � la lettre, au prix d'un formatage plus lent.
+    if( !punct.grouping().empty() || punct.decimal_point() != L'.' )
+    {
+        m_localized = true;
+        m_numbers.imbue( locale );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer::~Utf8Writer()
+{
+    flush();
+}
+
+// ------------------------------------------------------------------------ //
+bool Utf8Writer::flush()
+{
+    if( m_used != 0 )
+    {
+        if( fwrite( &m_buffer[ 0 ], 1, m_used, m_file ) != m_used )
+        {
+            m_failed = true;
+        }
+
+        m_used = 0;
+    }
+
+    if( fflush( m_file ) != 0 )
+    {
+        m_failed = true;
+    }
+
+    return !m_failed;
+}
+
+// ------------------------------------------------------------------------ //
+bool Utf8Writer::fail() const
+{
+    return m_failed;
+}
+
+// ------------------------------------------------------------------------ //
+char* Utf8Writer::reserve( const size_t size )
+{
+    if( m_used + size > m_buffer.size() )
+    {
+        if( m_used != 0 && 
+            fwrite( &m_buffer[ 0 ], 1, m_used, m_file ) != m_used )
+        {
+            m_failed = true;
+        }
+
+        m_used = 0;
+    }
+
+    char* room = &m_buffer[ m_used ];
+    m_used += size;
+
+    return room;
+}
+
+// ------------------------------------------------------------------------ //
+void Utf8Writer::appendWide( const wchar_t* str, const size_t length )
+{
+    // Au plus quatre octets par caract�re : on r�serve par blocs qui tiennent
+    // dans le tampon, puis on rend la place inutilis�e.
+    static const size_t CHUNK = BUFFER_SIZE / 4;
+
+    for( size_t begin = 0; begin < length; begin += CHUNK )
+    {
+        size_t end = ( length - begin > CHUNK ) ? begin + CHUNK : length;
+        char* start = reserve( 4 * ( end - begin ) );
+        char* out = start;
+
+        for( size_t i = begin; i < end; i++ )
+        {
+            unsigned long c = ( unsigned long )str[ i ];
+
+            if( c < 0x80 )
+            {
+                *out++ = ( char )c;
+            }
+            else if( c < 0x800 )
+            {
+                *out++ = ( char )( 0xC0 | ( c >> 6 ) );
+                *out++ = ( char )( 0x80 | ( c & 0x3F ) );
+            }
+            else if( c < 0x10000 )
+            {
+                *out++ = ( char )( 0xE0 | ( c >> 12 ) );
+                *out++ = ( char )( 0x80 | ( ( c >> 6 ) & 0x3F ) );
+                *out++ = ( char )( 0x80 | ( c & 0x3F ) );
+            }
+            else
+            {
+                *out++ = ( char )( 0xF0 | ( ( c >> 18 ) & 0x07 ) );
+                *out++ = ( char )( 0x80 | ( ( c >> 12 ) & 0x3F ) );
+                *out++ = ( char )( 0x80 | ( ( c >> 6 ) & 0x3F ) );
+                *out++ = ( char )( 0x80 | ( c & 0x3F ) );
+            }
+        }
+
+        m_used -= 4 * ( end - begin ) - ( out - start );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+template< class N >
+void Utf8Writer::appendLocalized( const N n )
+{
+    m_numbers.str( L"" );
+    m_numbers << n;
+
+    const wstring str = m_numbers.str();
+    appendWide( str.data(), str.size() );
+}
+
+// ------------------------------------------------------------------------ //
+void Utf8Writer::write( const char* data, const size_t length )
+{
+    if( length > BUFFER_SIZE )
+    {
+        // Trop gros pour le tampon : �crit directement
+        flush();
+
+        if( fwrite( data, 1, length, m_file ) != length )
+        {
+            m_failed = true;
+        }
+    }
+    else
+    {
+        memcpy( reserve( length ), data, length );
+    }
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer& Utf8Writer::operator<<( const char c )
+{
+    *reserve( 1 ) = c;
+    return *this;
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer& Utf8Writer::operator<<( const char* str )
+{
+    write( str, strlen( str ) );
+    return *this;
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer& Utf8Writer::operator<<( const wchar_t c )
+{
+    appendWide( &c, 1 );
+    return *this;
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer& Utf8Writer::operator<<( const wchar_t* str )
+{
+    appendWide( str, wcslen( str ) );
+    return *this;
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer& Utf8Writer::operator<<( const std::wstring& str )
+{
+    appendWide( str.data(), str.size() );
+    return *this;
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer& Utf8Writer::operator<<( const unsigned long n )
+{
+    if( m_localized )
+    {
+        appendLocalized( n );
+    }
+    else
+    {
+        char digits[ 24 ];
+        char* begin = digits + sizeof( digits );
+        unsigned long rest = n;
+
+        // Les chiffres sont produits du moins significatif au plus significatif
+        do
+        {
+            *--begin = ( char )( '0' + rest % 10 );
+            rest /= 10;
+        }
+        while( rest != 0 );
+
+        size_t length = digits + sizeof( digits ) - begin;
+        memcpy( reserve( length ), begin, length );
+    }
+
+    return *this;
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer& Utf8Writer::operator<<( const long n )
+{
+    if( m_localized )
+    {
+        appendLocalized( n );
+    }
+    else if( n < 0 )
+    {
+        *this << '-' << ( unsigned long )( -( n + 1 ) ) + 1;
+    }
+    else
+    {
+        *this << ( unsigned long )n;
+    }
+
+    return *this;
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer& Utf8Writer::operator<<( const int n )
+{
+    return *this << ( long )n;
+}
+
+// ------------------------------------------------------------------------ //
+Utf8Writer& Utf8Writer::operator<<( const double x )
+{
+    if( m_localized )
+    {
+        appendLocalized( x );
+    }
+    else
+    {
+        char* room = reserve( 32 );
+        m_used -= 32 - formatDouble( x, room );
+    }
+
+    return *this;
+}
+
+// ------------------------------------------------------------------------ //
+size_t Utf8Writer::formatDouble( const double x, char* buffer )
+{
+    static const double POWERS[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                      1e8, 1e9, 1e10, 1e11, 1e12 };
+    static const int PRECISION = 6;
+    const double a = fabs( x );
+
+    // Le cas courant, une notation d�cimale sans exposant, est format�
+    // directement.  Les autres cas, et les arrondis trop proches d'une
+    // demie pour �tre tranch�s avec s�ret�, passent par snprintf.
+    if( a >= 1e-4 && a < 1e6 )
+    {
+        int exponent = ( int )floor( log10( a ) );
+        double scaled = 0;
+        bool found = false;
+
+        for( int tries = 0; tries < 3 && !found; tries++ )
+        {
+            int shift = PRECISION - 1 - exponent;
+
+            scaled = ( shift >= 0 ) ? a * POWERS[ shift ] 
+                                    : a / POWERS[ -shift ];
+
+            if( scaled < 1e5 )
+            {
+                exponent--;
+            }
+            else if( scaled >= 1e6 )
+            {
+                exponent++;
+            }
+            else
+            {
+                found = true;
+            }
+        }
+
+        double whole = floor( scaled );
+        double fraction = scaled - whole;
+
+        if( found && fabs( fraction - 0.5 ) > 1e-6 )
+        {
+            unsigned long mantissa = ( unsigned long )whole;
+
+            if( fraction > 0.5 )
+            {
+                mantissa++;
+            }
+
+            if( mantissa == 1000000 )
+            {
+                mantissa = 100000;
+                exponent++;
+            }
+
+            if( exponent >= -4 && exponent < PRECISION )
+            {
+                char digits[ PRECISION ];
+                char* out = buffer;
+
+                for( int i = PRECISION - 1; i >= 0; i-- )
+                {
+                    digits[ i ] = ( char )( '0' + mantissa % 10 );
+                    mantissa /= 10;
+                }
+
+                if( x < 0 )
+                {
+                    *out++ = '-';
+                }
+
+                // Partie enti�re
+                int next = 0;
+
+                if( exponent >= 0 )
+                {
+                    for( ; next <= exponent; next++ )
+                    {
+                        *out++ = digits[ next ];
+                    }
+                }
+                else
+                {
+                    *out++ = '0';
+                }
+
+                // Partie fractionnaire, sans les z�ros de la fin
+                int last = PRECISION - 1;
+
+                while( last >= next && digits[ last ] == '0' )
+                {
+                    last--;
+                }
+
+                if( last >= next || exponent < 0 )
+                {
+                    *out++ = '.';
+
+                    for( int i = exponent + 1; i < 0; i++ )
+                    {
+                        *out++ = '0';
+                    }
+
+                    for( ; next <= last; next++ )
+                    {
+                        *out++ = digits[ next ];
+                    }
+                }
+
+                return out - buffer;
+            }
+        }
+    }
+
+    int length = snprintf( buffer, 32, "%.*g", PRECISION, x );
+
+    // snprintf suit la locale C courante : on revient au point d�cimal.
+    const char* point = localeconv() -> decimal_point;
+
+    if( point != NULL && strcmp( point, "." ) != 0 )
+    {
+        char* found = strstr( buffer, point );
+
+        if( found != NULL )
+        {
+            size_t pointLength = strlen( point );
+
+            *found = '.';
+            memmove( found + 1, found + pointLength, 
+                     strlen( found + pointLength ) + 1 );
+            length -= ( int )pointLength - 1;
+        }
+    }
+
+    return ( size_t )length;
+}
+
+}// namespace japa
@@ -0,0 +1,391 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#ifndef JAPA_UTF8_WRITER_H
+#define JAPA_UTF8_WRITER_H
+
+#include <cstdio>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace japa
+{
+
+/**
+ * \french
+ * Un flux de sortie tamponn� qui encode directement en UTF-8.
+ *
+ * Les caract�res et les nombres sont format�s dans un tampon r�utilis� qui
+ * n'est �crit dans le fichier que lorsqu'il est plein ou sur demande, plut�t
+ * qu'� chaque ligne comme avec <code>std::endl</code>.  Les nombres sont
+ * format�s comme le ferait un <code>std::wostream</code> avec la pr�cision
+ * par d�faut ; si la locale du flux groupe les chiffres ou n'utilise pas le
+ * point d�cimal, le formatage est d�l�gu� � un flux imbu de cette locale afin
+ * que les octets produits ne changent pas.
+ * \endfrench
+ *
+ * \english
+ * A buffered output stream which encodes directly to UTF-8.
+ *
+ * Characters and numbers are formatted into a reused buffer which is only
+ * written to the file when full or on request, rather than on every line as
+ * with <code>std::endl</code>.  Numbers are formatted the way a
+ * <code>std::wostream</code> with the default precision would; if the
+ * stream's locale groups digits or does not use the decimal point, the
+ * formatting is delegated to a stream imbued with that locale so the
+ * produced bytes do not change.
+ * \endenglish
+ *
+ * @version 1.1
+ */
+class Utf8Writer
+{
+public :
+    /**
+     * \french
+     * La taille du tampon, en octets.
+     * \endfrench
+     *
+     * \english
+     * The buffer's size, in bytes.
+     * \endenglish
+     */
+    static const size_t BUFFER_SIZE = 1 << 16;
+
+    /**
+     * \french
+     * Constructeur.
+     *
+     * @param file Le fichier dans lequel �crire.  Il n'est pas ferm� par
+     *             l'�crivain.
+     * @param locale La locale dont la ponctuation num�rique est respect�e.
+     * \endfrench
+     *
+     * \english
+     * Constructor.
+     *
+     * @param file The file where to write.  It is not closed by the writer.
+     * @param locale The locale whose numeric punctuation is followed.
+     * \endenglish
+     */
+    Utf8Writer( std::FILE* file,
+                const std::locale& locale = std::locale::classic() );
+
+    /**
+     * \french
+     * Destructeur.  Vide le tampon.
+     * \endfrench
+     *
+     * \english
+     * Destructor.  Flushes the buffer.
+     * \endenglish
+     */
+    virtual ~Utf8Writer();
+
+    /**
+     * \french
+     * �crit le contenu du tampon dans le fichier.
+     *
+     * @return <code>false</code> si l'�criture a �chou�.
+     * \endfrench
+     *
+     * \english
+     * Writes the buffer's content to the file.
+     *
+     * @return <code>false</code> if the write failed.
+     * \endenglish
+     */
+    bool flush();
+
+    /**
+     * \french
+     * Indique si une �criture a �chou�.
+     *
+     * @return <code>true</code> si une �criture a �chou�.
+     * \endfrench
+     *
+     * \english
+     * Tells whether a write failed.
+     *
+     * @return <code>true</code> if a write failed.
+     * \endenglish
+     */
+    bool fail() const;
+
+    /**
+     * \french
+     * Ajoute des octets tels quels, d�j� encod�s en UTF-8.
+     *
+     * @param data Les octets.
+     * @param length Le nombre d'octets.
+     * \endfrench
+     *
+     * \english
+     * Appends bytes as is, already encoded in UTF-8.
+     *
+     * @param data The bytes.
+     * @param length The number of bytes.
+     * \endenglish
+     */
+    void write( const char* data, const size_t length );
+
+    /**
+     * \french
+     * Ajoute un caract�re ASCII.
+     * \endfrench
+     *
+     * \english
+     * Appends an ASCII character.
+     * \endenglish
+     */
+    Utf8Writer& operator<<( const char c );
+
+    /**
+     * \french
+     * Ajoute une cha�ne ASCII.
+     * \endfrench
+     *
+     * \english
+     * Appends an ASCII string.
+     * \endenglish
+     */
+    Utf8Writer& operator<<( const char* str );
+
+    /**
+     * \french
+     * Ajoute un caract�re, encod� en UTF-8.
+     * \endfrench
+     *
+     * \english
+     * Appends a character, encoded in UTF-8.
+     * \endenglish
+     */
+    Utf8Writer& operator<<( const wchar_t c );
+
+    /**
+     * \french
+     * Ajoute une cha�ne, encod�e en UTF-8.
+     * \endfrench
+     *
+     * \english
+     * Appends a string, encoded in UTF-8.
+     * \endenglish
+     */
+    Utf8Writer& operator<<( const wchar_t* str );
+
+    /**
+     * \french
+     * Ajoute une cha�ne, encod�e en UTF-8.
+     * \endfrench
+     *
+     * \english
+     * Appends a string, encoded in UTF-8.
+     * \endenglish
+     */
+    Utf8Writer& operator<<( const std::wstring& str );
+
+    /**
+     * \french
+     * Ajoute un entier non sign�.
+     * \endfrench
+     *
+     * \english
+     * Appends an unsigned integer.
+     * \endenglish
+     */
+    Utf8Writer& operator<<( const unsigned long n );
+
+    /**
+     * \french
+     * Ajoute un entier.
+     * \endfrench
+     *
+     * \english
+     * Appends an integer.
+     * \endenglish
+     */
+    Utf8Writer& operator<<( const long n );
+
+    /**
+     * \french
+     * Ajoute un entier.
+     * \endfrench
+     *
+     * \english
+     * Appends an integer.
+     * \endenglish
+     */
+    Utf8Writer& operator<<( const int n );
+
+    /**
+     * \french
+     * Ajoute un nombre r�el, avec six chiffres significatifs.
+     * \endfrench
+     *
+     * \english
+     * Appends a real number, with six significant digits.
+     * \endenglish
+     */
+    Utf8Writer& operator<<( const double x );
+
+    /**
+     * \french
+     * Formate un nombre r�el comme <code>printf( "%g" )</code> dans la
+     * locale "C", sans passer par les flux.
+     *
+     * @param x Le nombre � formater.
+     * @param buffer Le tampon qui re�oit les caract�res, d'au moins 32
+     *               octets.
+     *
+     * @return Le nombre de caract�res �crits.
+     * \endfrench
+     *
+     * \english
+     * Formats a real number like <code>printf( "%g" )</code> in the "C"
+     * locale, without going through streams.
+     *
+     * @param x The number to format.
+     * @param buffer The buffer receiving the characters, at least 32 bytes
+     *               long.
+     *
+     * @return The number of characters written.
+     * \endenglish
+     */
+    static size_t formatDouble( const double x, char* buffer );
+
+private :
+    /**
+     * \french
+     * R�serve de la place dans le tampon.
+     *
+     * @param size Le nombre d'octets � r�server.
+     *
+     * @return Un pointeur vers la place r�serv�e.
+     * \endfrench
+     *
+     * \english
+     * Reserves room in the buffer.
+     *
+     * @param size The number of bytes to reserve.
+     *
+     * @return A pointer to the reserved room.
+     * \endenglish
+     */
+    char* reserve( const size_t size );
+
+    /**
+     * \french
+     * Ajoute des caract�res, encod�s en UTF-8.
+     *
+     * @param str Les caract�res.
+     * @param length Le nombre de caract�res.
+     * \endfrench
+     *
+     * \english
+     * Appends characters, encoded in UTF-8.
+     *
+     * @param str The characters.
+     * @param length The number of characters.
+     * \endenglish
+     */
+    void appendWide( const wchar_t* str, const size_t length );
+
+    /**
+     * \french
+     * Ajoute le nombre format� par le flux local.
+     * \endfrench
+     *
+     * \english
+     * Appends the number formatted by the localized stream.
+     * \endenglish
+     */
+    template< class N >
+    void appendLocalized( const N n );
+
+    /**
+     * \french
+     * Le fichier de sortie.
+     * \endfrench
+     *
+     * \english
+     * The output file.
+     * \endenglish
+     */
+    std::FILE* m_file;
+
+    /**
+     * \french
+     * Le tampon.
+     * \endfrench
+     *
+     * \english
+     * The buffer.
+     * \endenglish
+     */
+    std::vector< char > m_buffer;
+
+    /**
+     * \french
+     * Le nombre d'octets utilis�s dans le tampon.
+     * \endfrench
+     *
+     * \english
+     * The number of bytes used in the buffer.
+     * \endenglish
+     */
+    size_t m_used;
+
+    /**
+     * \french
+     * Vrai si une �criture a �chou�.
+     * \endfrench
+     *
+     * \english
+     * True if a write failed.
+     * \endenglish
+     */
+    bool m_failed;
+
+    /**
+     * \french
+     * Vrai si la locale impose son propre formatage des nombres.
+     * \endfrench
+     *
+     * \english
+     * True if the locale imposes its own number formatting.
+     * \endenglish
+     */
+    bool m_localized;
+
+    /**
+     * \french
+     * Le flux qui formate les nombres selon la locale.
+     * \endfrench
+     *
+     * \english
+     * The stream formatting numbers according to the locale.
+     * \endenglish
+     */
+    std::wostringstream m_numbers;
+};
+
+}// namespace japa
+
+#endif
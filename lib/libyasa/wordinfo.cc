@@ -18,6 +18,8 @@ limitations under the License.
 
 using namespace std;
 
+#include <algorithm>
+
 #include "wordinfo.h"
 
 namespace japa
@@ -26,11 +28,14 @@ namespace japa
 // ------------------------------------------------------------------------ //
 WordInfo::WordInfo( const wstring& word,
                     const size_t frequency ) : m_word( word ), 
-                                               m_frequency( frequency )
+                                               m_frequency( frequency ),
+                                               m_synonymFrequency( 0 ),
+                                               m_sorted( true )
 {}
 
 // ------------------------------------------------------------------------ //
-WordInfo::WordInfo() : m_frequency( 0 )
+WordInfo::WordInfo() : m_frequency( 0 ), m_synonymFrequency( 0 ),
+                       m_sorted( true )
 {}
 
 // ------------------------------------------------------------------------ //
@@ -64,19 +69,57 @@ void WordInfo::addOne()
 // ------------------------------------------------------------------------ //
 void WordInfo::addSynonym( const WordInfo& syn )
 {
-    m_synonyms.insert( &syn );
+    // Le tableau reste tri� tant que les adresses croissent
+    if( !m_synonyms.empty() && m_synonyms.back() >= &syn )
+    {
+        m_sorted = false;
+    }
+
+    m_synonyms.push_back( &syn );
+    m_synonymFrequency += syn.getFrequency();
+}
+
+// ------------------------------------------------------------------------ //
+void WordInfo::sortSynonyms()
+{
+    Synonyms::const_iterator iter;
+
+    if( m_sorted )
+    {
+        return;
+    }
+
+    sort( m_synonyms.begin(), m_synonyms.end() );
+    m_synonyms.erase( unique( m_synonyms.begin(), m_synonyms.end() ), 
+                      m_synonyms.end() );
+
+    // Les doublons avaient �t� compt�s
+    m_synonymFrequency = 0;
+
+    for( iter = m_synonyms.begin(); iter != m_synonyms.end(); iter++ )
+    {
+        m_synonymFrequency += ( *iter ) -> getFrequency();
+    }
+
+    m_sorted = true;
 }
 
 // ------------------------------------------------------------------------ //
 bool WordInfo::isSynonym( const WordInfo& w ) const
 {
-    return m_synonyms.find( &w ) != m_synonyms.end();
+    // Cas fr�quent des cognates de mots : un seul synonyme
+    if( m_synonyms.size() == 1 )
+    {
+        return m_synonyms[ 0 ] == &w;
+    }
+
+    return binary_search( m_synonyms.begin(), m_synonyms.end(), &w );
 }
 
 // ------------------------------------------------------------------------ //
 bool WordInfo::hasSynonym() const
 {
-    return m_synonyms.size() > 0;
+    return !m_synonyms.empty();
 }
 
 // ------------------------------------------------------------------------ //
@@ -85,6 +128,12 @@ const WordInfo::Synonyms& WordInfo::getSynonyms() const
     return m_synonyms;
 }
 
+// ------------------------------------------------------------------------ //
+size_t WordInfo::getSynonymFrequency() const
+{
+    return m_synonymFrequency;
+}
+
 // ------------------------------------------------------------------------ //
 std::wostream& operator<<( std::wostream& out, const WordInfo& w )
 {
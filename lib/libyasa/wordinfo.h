@@ -22,8 +22,8 @@ limitations under the License.
 using namespace std;
 
 #include <iostream>
-#include <set>
 #include <string>
+#include <vector>
 
 namespace japa
 {
@@ -61,9 +61,18 @@ public :
      *
      * \english
      * The synonyms holder's data type.
+     *
+     * \french
+     * Les synonymes sont gard�s tri�s par adresse dans un tableau contigu,
+     * ce qui permet une recherche dichotomique sans parcourir un arbre.
+     * \endfrench
+     *
+     * \english
+     * Synonyms are kept sorted by address in a contiguous array so that
+     * membership is a binary search instead of a tree walk.
      * \endenglish
      */
-    typedef std::set< const WordInfo* > Synonyms;
+    typedef std::vector< const WordInfo* > Synonyms;
    
     /**
      * \french
@@ -162,24 +171,41 @@ public :
 
     /**
      * \french
-     * Ajoute un synonyme au mot.
+     * Ajoute un synonyme au mot.  Le synonyme est mis � la suite des autres ;
+     * <code>sortSynonyms</code> doit �tre appel�e avant toute recherche.
      *
      * @param syn Le nouveau synonyme du mot.
      * \endfrench
      *
      * \english
-     * Add a synonym to the word.
+     * Add a synonym to the word.  The synonym is appended to the others;
+     * <code>sortSynonyms</code> must be called before any lookup.
      *
      * @param syn The word's synonym. 
      * \endenglish
      */
     void addSynonym( const WordInfo& syn );
 
+    /**
+     * \french
+     * Trie les synonymes et retire les doublons, une fois tous les synonymes
+     * ajout�s.  Ne fait rien si le tableau est d�j� tri�.
+     * \endfrench
+     *
+     * \english
+     * Sorts the synonyms and removes the duplicates, once all the synonyms
+     * are added.  Does nothing if the array is already sorted.
+     * \endenglish
+     */
+    void sortSynonyms();
+
     /**
      * \french
      * V�rifie si un mot est synonyme du mot courant.
      *
      * @note La relation synonyme n'est pas sym�trique.
+     * @note Les synonymes doivent avoir �t� tri�s par
+     *       <code>sortSynonyms</code>.
      *
      * @param w Le mot � tester.
      *
@@ -191,6 +217,7 @@ public :
      * Checks if a word is a synonym of the current word.
      *
      * @note The synonym relation is not symetric.
+     * @note The synonyms must have been sorted by <code>sortSynonyms</code>.
      *
      * @param w The word to check.
      *
@@ -229,6 +256,29 @@ public :
      * \endenglish
      */
     const Synonyms& getSynonyms() const;
+
+    /**
+     * \french
+     * Retourne la somme des fr�quences des synonymes du mot.
+     *
+     * @note La somme est tenue � jour par <code>addSynonym</code> et
+     *       <code>sortSynonyms</code>, elle suppose donc que les fr�quences
+     *       des synonymes ne changent plus une fois ceux-ci ajout�s.
+     *
+     * @return La somme des fr�quences des synonymes.
+     * \endfrench
+     *
+     * \english
+     * Gets the sum of the frequencies of the word's synonyms.
+     *
+     * @note The sum is maintained by <code>addSynonym</code> and
+     *       <code>sortSynonyms</code>, so it assumes the synonyms'
+     *       frequencies no longer change once they are added.
+     *
+     * @return The sum of the synonyms' frequencies.
+     * \endenglish
+     */
+    size_t getSynonymFrequency() const;
     
 private :
 
@@ -264,6 +314,28 @@ private :
      * \endenglish
      */
     size_t m_frequency;
+
+    /** 
+     * \french
+     * La somme des fr�quences des synonymes 
+     * \endfrench
+     *
+     * \english
+     * The sum of the synonyms' frequencies. 
+     * \endenglish
+     */
+    size_t m_synonymFrequency;
+
+    /** 
+     * \french
+     * Les synonymes sont tri�s et sans doublon
+     * \endfrench
+     *
+     * \english
+     * The synonyms are sorted and without duplicates. 
+     * \endenglish
+     */
+    bool m_sorted;
 };
 
 /**
@@ -41,10 +41,9 @@ SearchSpace& WordSSF::operator()( SearchSpace& s )
     // Ce code n'est pas � toute �preuve, il ne g�re pas les cas o� les mots
     // ne sont pas dans le dictionnaire.
     
-    TextDictionary& dictSrc = m_source.getDictionary();
-    WordInfo::Synonyms synonyms;
-    WordInfo::Synonyms::iterator synIter;
-    std::map< const wstring, std::vector< size_t > > t1;
+    WordInfo::Synonyms::const_iterator synIter;
+    std::map< const WordInfo*, std::vector< size_t > > t1;
+    std::map< const WordInfo*, std::vector< size_t > >::const_iterator t1Iter;
     double delta = ( ( double )m_source.getWordCount() ) / 
             m_target.getWordCount();
     size_t min;
@@ -57,16 +56,16 @@ SearchSpace& WordSSF::operator()( SearchSpace& s )
         if( m_validator( m_source.getWord( i ) ) )
         {
             // Les synonymes du mot source i
-        	//cout << "le mot est " << i << " " << m_source.getWord( i ).getWord().ToConstCharPtr() << endl;
-            synonyms = dictSrc[ m_source.getWord( i ).getWord()].getSynonyms();
+            const WordInfo::Synonyms& synonyms = 
+                    m_source.getWord( i ).getSynonyms();
             
             // Pour chaque synonyme, on indexe l'indice du mot du texte source 
-            // qui lui correspond.
+            // qui lui correspond.  Les synonymes sont des entr�es du
+            // dictionnaire cible, leur adresse suffit donc comme cl�.
             for( synIter = synonyms.begin(); synIter != synonyms.end(); 
                  synIter++ )
             {
-                //t1[ ( *synIter ) -> getWord().c_str() ].push_back( i );
-            	t1[ ( *synIter ) -> getWord()].push_back( i );
+            	t1[ *synIter ].push_back( i );
             }
         }
     }
@@ -74,54 +73,58 @@ SearchSpace& WordSSF::operator()( SearchSpace& s )
     // Construction de l'espace de recherche
     for( size_t  j = 0; j < m_target.getWordCount(); j++ )
     {
-        std::vector< size_t >& words = 
-                //t1[ m_target.getWord( j ).getWord().c_str() ];
-        		t1[ m_target.getWord( j ).getWord()];
-        
-        if( getRadius() != INFINITE_RADIUS )
+        t1Iter = t1.find( &( m_target.getWord( j ) ) );
+
+        // Seuls les mots cibles synonymes d'un mot source valide comptent
+        if( t1Iter != t1.end() )
         {
-            size_t x = ( size_t )( delta * j );
-            size_t sx = m_source.getSentenceIndice( x );
-            size_t low, high, temp; 
-            
-            if( getRadius() < sx )
-            {
-                low = sx - getRadius();
-            }
-            else
+            const std::vector< size_t >& words = t1Iter -> second;
+        
+            if( getRadius() != INFINITE_RADIUS )
             {
-                low = 0;
-            }
+                size_t x = ( size_t )( delta * j );
+                size_t sx = m_source.getSentenceIndice( x );
+                size_t low, high, temp; 
+            
+                if( getRadius() < sx )
+                {
+                    low = sx - getRadius();
+                }
+                else
+                {
+                    low = 0;
+                }
     
-            if( sx + getRadius() < m_source.getSentenceCount() )
-            {
-                high = sx + getRadius();
+                if( sx + getRadius() < m_source.getSentenceCount() )
+                {
+                    high = sx + getRadius();
+                }
+                else
+                {
+                    high = m_source.getSentenceCount() - 1;
+                }
+            
+                m_source.getSentenceBounds( low, min, temp );
+                m_source.getSentenceBounds( high, temp, max ); 
             }
             else
             {
-                high = m_source.getSentenceCount() - 1;
+                min = 0;
+                max = m_source.getWordCount();
             }
-            
-            m_source.getSentenceBounds( low, min, temp );
-            m_source.getSentenceBounds( high, temp, max ); 
-        }
-        else
-        {
-            min = 0;
-            max = m_source.getWordCount();
-        }
-        //cout << "jjjjjjjjjj " << j << endl;
+            //cout << "jjjjjjjjjj " << j << endl;
 
 
-        // Pour chaque synonymes du texte source
-        for( size_t w = 0; w < words.size(); w++ )
-        {
-            if( words[ w ] >= min && words[ w ] <= max )
+            // Pour chaque synonymes du texte source
+            for( size_t w = 0; w < words.size(); w++ )
             {
-                s.addPossibility( j, words[ w ] );
-                //nous affiche tous les cognates
-                //cout <<words[w] << " " << j << endl;
+                if( words[ w ] >= min && words[ w ] <= max )
+                {
+                    s.addPossibility( j, words[ w ] );
+                    //nous affiche tous les cognates
+                    //cout <<words[w] << " " << j << endl;
 
+                }
             }
         }
     }
@@ -0,0 +1,400 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <locale.h>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "japaprogram.h"
+#include "toolbox.h"
+#include "yasa.h"
+
+using japa::JapaOptions;
+using japa::JapaProgram;
+using japa::decodeUtf8;
+
+/**
+ * Un aligneur de l'interface C.
+ */
+struct yasa_aligner
+{
+    /**
+     * Constructeur.
+     *
+     * @param ctype La locale des fonctions C, dont l'aligneur devient
+     *              propri�taire.
+     * @param locale La locale des flux de texte.
+     */
+    yasa_aligner( locale_t ctype, const std::locale& locale )
+            : options( std::locale::classic() ), ctype( ctype ), 
+              locale( locale )
+    {}
+
+    /**
+     * Destructeur.
+     */
+    ~yasa_aligner()
+    {
+        freelocale( ctype );
+    }
+
+    JapaOptions options;                    /**< Les options d'alignement */
+    JapaProgram::SynonymList synonyms;      /**< Le lexique */
+    locale_t ctype;                         /**< La locale des fonctions C */
+    std::locale locale;                     /**< La locale des flux */
+    std::string error;                      /**< Le dernier message d'erreur */
+};
+
+namespace
+{
+
+/**
+ * Les locales essay�es pour classer les caract�res, dans l'ordre.
+ */
+const char* const LOCALES[] = { "en_US.UTF-8", "C.UTF-8", NULL };
+
+/**
+ * Installe une locale pour le fil courant seulement, le temps d'un appel ;
+ * la locale globale n'est jamais touch�e.
+ */
+class ThreadLocale
+{
+public :
+    /**
+     * Constructeur.  Installe la locale.
+     *
+     * @param locale La locale du fil.
+     */
+    explicit ThreadLocale( locale_t locale ) 
+            : m_previous( uselocale( locale ) )
+    {}
+
+    /**
+     * Destructeur.  R�tablit la locale pr�c�dente du fil.
+     */
+    ~ThreadLocale()
+    {
+        uselocale( m_previous );
+    }
+
+private :
+    locale_t m_previous;                    /**< La locale pr�c�dente */
+};
+
+// ------------------------------------------------------------------------ //
+/**
+ * Ajoute des phrases � un texte, une par ligne.  Les fins de ligne des
+ * phrases deviennent des espaces.
+ *
+ * @param sentences Les phrases, en UTF-8.
+ * @param count Le nombre de phrases.
+ * @param text Re�oit les phrases.
+ */
+void appendLines( const char* const* sentences, const size_t count, 
+                  std::wstring& text )
+{
+    for( size_t i = 0; i < count; i++ )
+    {
+        std::wstring sentence( decodeUtf8( sentences[ i ], 
+                                           strlen( sentences[ i ] ) ) );
+
+        std::replace( sentence.begin(), sentence.end(), L'\n', L' ' );
+        text += sentence;
+        text += L'\n';
+    }
+}
+
+// ------------------------------------------------------------------------ //
+/**
+ * Aligne deux textes et copie les liens de la solution.
+ *
+ * @param aligner L'aligneur.
+ * @param program Le programme, avec les options de l'appel.
+ * @param source Le texte source.
+ * @param target Le texte cible.
+ * @param links Re�oit les liens.
+ * @param capacity Le nombre de liens que peut contenir le tableau.
+ * @param count Re�oit le nombre de liens.
+ *
+ * @return Le code de retour de l'appel.
+ */
+int align( yasa_aligner* aligner, JapaProgram& program, 
+           const std::wstring& source, const std::wstring& target, 
+           yasa_link* links, const size_t capacity, size_t* count )
+{
+    japa::SolutionPrinter< double >::Solution solution;
+    std::wistringstream sourceStream( source );
+    std::wistringstream targetStream( target );
+    size_t sourceBegin = 0;
+    size_t targetBegin = 0;
+
+    sourceStream.imbue( aligner -> locale );
+    targetStream.imbue( aligner -> locale );
+
+    {
+        ThreadLocale scope( aligner -> ctype );
+
+        program.align( sourceStream, targetStream, aligner -> synonyms, 
+                       solution );
+    }
+
+    *count = solution.size();
+
+    if( solution.size() > capacity )
+    {
+        return YASA_TOO_SMALL;
+    }
+
+    for( size_t i = 0; i < solution.size(); i++ )
+    {
+        links[ i ].source_begin = sourceBegin;
+        links[ i ].source_length = solution[ i ].getSourceLength();
+        links[ i ].target_begin = targetBegin;
+        links[ i ].target_length = solution[ i ].getTargetLength();
+        links[ i ].score = solution[ i ].getScore();
+
+        sourceBegin += links[ i ].source_length;
+        targetBegin += links[ i ].target_length;
+    }
+
+    return YASA_OK;
+}
+
+}// namespace
+
+// ------------------------------------------------------------------------ //
+void yasa_config_init( yasa_config* config )
+{
+    config -> size = sizeof( yasa_config );
+    config -> input_format = JapaOptions::INPUT_FORMAT_DEFAULT;
+    config -> score_function = JapaOptions::SCORE_FUNCTION_DEFAULT;
+    config -> search_space = JapaOptions::SEARCH_SPACE_DEFAULT;
+    config -> cognate = JapaOptions::COGNATE_DEFAULT;
+    config -> felipe_mode = JapaOptions::FELIPE_MODE_DEFAULT;
+    config -> beam_radius = JapaOptions::BEAM_RADIUS_DEFAULT;
+    config -> cascade_radius = JapaOptions::CASCADE_RADIUS_DEFAULT;
+    config -> cognate_radius = JapaOptions::COGNATE_RADIUS_DEFAULT;
+    config -> cognate_min_length = JapaOptions::COGNATE_MIN_LENGTH_DEFAULT;
+    config -> cognate_prefix_length = 
+            JapaOptions::COGNATE_PREFIX_LENGTH_DEFAULT;
+    config -> pruning_margin = JapaOptions::PRUNING_MARGIN_DEFAULT;
+    config -> precompute_costs = JapaOptions::PRECOMPUTE_COSTS_DEFAULT;
+    config -> anchor_divisions = 0;
+    config -> lexicon = NULL;
+    config -> lexicon_size = 0;
+}
+
+// ------------------------------------------------------------------------ //
+yasa_aligner* yasa_create( const yasa_config* config )
+{
+    const std::locale& classic = std::locale::classic();
+    locale_t base;
+    locale_t ctype = 0;
+    std::locale locale( classic );
+    std::auto_ptr< yasa_aligner > aligner;
+
+    if( config == NULL || config -> size != sizeof( yasa_config ) )
+    {
+        return NULL;
+    }
+
+    // Les nombres suivent toujours la locale C, seul le classement des
+    // caract�res suit une locale UTF-8 lorsqu'elle existe.
+    for( size_t i = 0; LOCALES[ i ] != NULL && ctype == 0; i++ )
+    {
+        base = newlocale( LC_ALL_MASK, "C", 0 );
+
+        if( base == 0 )
+        {
+            return NULL;
+        }
+
+        ctype = newlocale( LC_CTYPE_MASK, LOCALES[ i ], base );
+
+        if( ctype == 0 )
+        {
+            freelocale( base );
+            continue;
+        }
+
+        try
+        {
+            locale = std::locale( classic, new std::ctype_byname< wchar_t >(
+                                      LOCALES[ i ] ) );
+        }
+        catch( std::exception& ex )
+        {
+            locale = classic;
+        }
+    }
+
+    if( ctype == 0 )
+    {
+        ctype = newlocale( LC_ALL_MASK, "C", 0 );
+
+        if( ctype == 0 )
+        {
+            return NULL;
+        }
+    }
+
+    try
+    {
+        aligner.reset( new yasa_aligner( ctype, locale ) );
+    }
+    catch( ... )
+    {
+        freelocale( ctype );
+
+        return NULL;
+    }
+
+    try
+    {
+        JapaOptions& options = aligner -> options;
+
+        options.setOption( JapaOptions::INPUT_FORMAT, config -> input_format );
+        options.setOption( JapaOptions::SCORE_FUNCTION, 
+                           config -> score_function );
+        options.setOption( JapaOptions::SEARCH_SPACE, config -> search_space );
+        options.setOption( JapaOptions::COGNATE, config -> cognate );
+        options.setOption( JapaOptions::FELIPE_MODE, config -> felipe_mode );
+        options.setOption( JapaOptions::BEAM_RADIUS, 
+                           japa::toString( config -> beam_radius, classic ) );
+        options.setOption( JapaOptions::CASCADE_RADIUS, 
+                           japa::toString( config -> cascade_radius, 
+                                           classic ) );
+        options.setOption( JapaOptions::COGNATE_RADIUS, 
+                           japa::toString( config -> cognate_radius, 
+                                           classic ) );
+        options.setOption( JapaOptions::COGNATE_MIN_LENGTH, 
+                           japa::toString( config -> cognate_min_length, 
+                                           classic ) );
+        options.setOption( JapaOptions::COGNATE_PREFIX_LENGTH, 
+                           japa::toString( config -> cognate_prefix_length, 
+                                           classic ) );
+        options.setOption( JapaOptions::PRUNING_MARGIN, 
+                           japa::toString( config -> pruning_margin, 
+                                           classic ) );
+
+        if( config -> precompute_costs )
+        {
+            options.setOption( JapaOptions::PRECOMPUTE_COSTS, '1' );
+        }
+
+        if( config -> anchor_divisions )
+        {
+            options.setOption( JapaOptions::ANCHOR_DIVISIONS, '1' );
+        }
+
+        // Le lexique est d�cod� une fois pour toutes
+        for( size_t i = 0; i < config -> lexicon_size; i++ )
+        {
+            const char* source = config -> lexicon[ 2 * i ];
+            const char* target = config -> lexicon[ 2 * i + 1 ];
+
+            aligner -> synonyms.push_back( 
+                std::make_pair( decodeUtf8( source, strlen( source ) ), 
+                                decodeUtf8( target, strlen( target ) ) ) );
+        }
+    }
+    catch( ... )
+    {
+        return NULL;
+    }
+
+    return aligner.release();
+}
+
+// ------------------------------------------------------------------------ //
+int yasa_align_sentences( yasa_aligner* aligner,
+                          const char* const* source, size_t source_count,
+                          const char* const* target, size_t target_count,
+                          yasa_link* links, size_t capacity, size_t* count )
+{
+    try
+    {
+        JapaProgram program( aligner -> options );
+        std::wstring sourceText;
+        std::wstring targetText;
+
+        aligner -> error.clear();
+        appendLines( source, source_count, sourceText );
+        appendLines( target, target_count, targetText );
+
+        program.setOption( JapaOptions::INPUT_FORMAT, 
+                           JapaOptions::INPUT_FORMAT_OSPL );
+
+        return align( aligner, program, sourceText, targetText, 
+                      links, capacity, count );
+    }
+    catch( std::exception& ex )
+    {
+        aligner -> error = ex.what();
+    }
+    catch( ... )
+    {
+        aligner -> error = "Unknown error";
+    }
+
+    return YASA_ERROR;
+}
+
+// ------------------------------------------------------------------------ //
+int yasa_align_buffers( yasa_aligner* aligner,
+                        const char* source, size_t source_size,
+                        const char* target, size_t target_size,
+                        yasa_link* links, size_t capacity, size_t* count )
+{
+    try
+    {
+        JapaProgram program( aligner -> options );
+
+        aligner -> error.clear();
+
+        return align( aligner, program, decodeUtf8( source, source_size ), 
+                      decodeUtf8( target, target_size ), links, capacity, 
+                      count );
+    }
+    catch( std::exception& ex )
+    {
+        aligner -> error = ex.what();
+    }
+    catch( ... )
+    {
+        aligner -> error = "Unknown error";
+    }
+
+    return YASA_ERROR;
+}
+
+// ------------------------------------------------------------------------ //
+const char* yasa_error( const yasa_aligner* aligner )
+{
+    return aligner -> error.c_str();
+}
+
+// ------------------------------------------------------------------------ //
+void yasa_destroy( yasa_aligner* aligner )
+{
+    delete aligner;
+}
@@ -0,0 +1,310 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#ifndef YASA_H
+#define YASA_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * \french
+ * Code de retour d'un appel r�ussi.
+ * \endfrench
+ *
+ * \english
+ * Return code of a successful call.
+ * \endenglish
+ */
+#define YASA_OK 0
+
+/**
+ * \french
+ * Code de retour d'un appel �chou� ; <code>yasa_error</code> en donne la
+ * raison.
+ * \endfrench
+ *
+ * \english
+ * Return code of a failed call; <code>yasa_error</code> gives the reason.
+ * \endenglish
+ */
+#define YASA_ERROR -1
+
+/**
+ * \french
+ * Code de retour d'un alignement qui ne tient pas dans le tableau de liens
+ * fourni.  Le nombre de liens n�cessaires est tout de m�me retourn�.
+ * \endfrench
+ *
+ * \english
+ * Return code of an alignment which does not fit in the given array of
+ * links.  The number of links needed is returned anyway.
+ * \endenglish
+ */
+#define YASA_TOO_SMALL -2
+
+/**
+ * \french
+ * Un aligneur, cr�� par <code>yasa_create</code> et d�truit par
+ * <code>yasa_destroy</code>.
+ *
+ * Un aligneur ne doit �tre utilis� que par un fil � la fois ; des fils
+ * diff�rents peuvent utiliser des aligneurs diff�rents en m�me temps.
+ * \endfrench
+ *
+ * \english
+ * An aligner, created by <code>yasa_create</code> and destroyed by
+ * <code>yasa_destroy</code>.
+ *
+ * An aligner must be used by only one thread at a time; different threads
+ * can use different aligners at the same time.
+ * \endenglish
+ */
+typedef struct yasa_aligner yasa_aligner;
+
+/**
+ * \french
+ * La configuration d'un aligneur.  Chaque champ correspond � une option de
+ * la ligne de commande de <code>yasa</code> et prend les m�mes valeurs.
+ * \endfrench
+ *
+ * \english
+ * An aligner's configuration.  Each field matches an option of the
+ * <code>yasa</code> command line and takes the same values.
+ * \endenglish
+ */
+typedef struct yasa_config
+{
+    size_t size;                /**< sizeof( yasa_config ) */
+    char input_format;          /**< Buffers' format ( -i ) */
+    char score_function;        /**< Score function ( -s ) */
+    char search_space;          /**< Search space ( -e ) */
+    char cognate;               /**< Cognate type ( -c ) */
+    char felipe_mode;           /**< Felipe mode ( -f ) */
+    int beam_radius;            /**< Beam radius ( -b ) */
+    int cascade_radius;         /**< Cascade beam radius ( -C ) */
+    int cognate_radius;         /**< Cognate deviance ( -d ) */
+    int cognate_min_length;     /**< Cognate minimum length ( -l ) */
+    int cognate_prefix_length;  /**< Cognate prefix length ( -p ) */
+    double pruning_margin;      /**< Pruning margin ( -B ) */
+    int precompute_costs;       /**< Non-zero to precompute costs ( -D ) */
+    int anchor_divisions;       /**< Non-zero to anchor divisions ( -H ) */
+
+    /**
+     * \french
+     * Le lexique, en UTF-8 : <code>2 * lexicon_size</code> mots, chaque mot
+     * source suivi de son mot cible.  Il est copi� par
+     * <code>yasa_create</code>.
+     * \endfrench
+     *
+     * \english
+     * The lexicon, in UTF-8: <code>2 * lexicon_size</code> words, each source
+     * word followed by its target word.  It is copied by
+     * <code>yasa_create</code>.
+     * \endenglish
+     */
+    const char* const* lexicon;
+    size_t lexicon_size;        /**< Number of lexicon pairs */
+} yasa_config;
+
+/**
+ * \french
+ * Un lien de l'alignement : un groupe de phrases sources align� avec un
+ * groupe de phrases cibles.  Les phrases sont num�rot�es � partir de 0.
+ * \endfrench
+ *
+ * \english
+ * An alignment link: a group of source sentences aligned with a group of
+ * target sentences.  The sentences are numbered from 0.
+ * \endenglish
+ */
+typedef struct yasa_link
+{
+    size_t source_begin;        /**< First source sentence */
+    size_t source_length;       /**< Number of source sentences */
+    size_t target_begin;        /**< First target sentence */
+    size_t target_length;       /**< Number of target sentences */
+    double score;               /**< Solution's score up to this link */
+} yasa_link;
+
+/**
+ * \french
+ * Remplit une configuration avec les valeurs par d�faut de
+ * <code>yasa</code>, sans lexique.
+ *
+ * @param config La configuration.
+ * \endfrench
+ *
+ * \english
+ * Fills a configuration with the <code>yasa</code> default values, without
+ * lexicon.
+ *
+ * @param config The configuration.
+ * \endenglish
+ */
+void yasa_config_init( yasa_config* config );
+
+/**
+ * \french
+ * Cr�e un aligneur.
+ *
+ * @param config La configuration, remplie d'abord par
+ *               <code>yasa_config_init</code>.
+ *
+ * @return L'aligneur, ou <code>NULL</code> si la configuration est
+ *         invalide ou la m�moire insuffisante.
+ * \endfrench
+ *
+ * \english
+ * Creates an aligner.
+ *
+ * @param config The configuration, first filled by
+ *               <code>yasa_config_init</code>.
+ *
+ * @return The aligner, or <code>NULL</code> if the configuration is invalid
+ *         or memory is short.
+ * \endenglish
+ */
+yasa_aligner* yasa_create( const yasa_config* config );
+
+/**
+ * \french
+ * Aligne deux tableaux de phrases en UTF-8.
+ *
+ * Un alignement a au plus <code>source_count + target_count</code> liens.
+ *
+ * @param aligner L'aligneur.
+ * @param source Les phrases sources.
+ * @param source_count Le nombre de phrases sources.
+ * @param target Les phrases cibles.
+ * @param target_count Le nombre de phrases cibles.
+ * @param links Re�oit les liens de l'alignement.
+ * @param capacity Le nombre de liens que peut contenir le tableau.
+ * @param count Re�oit le nombre de liens de l'alignement.
+ *
+ * @return <code>YASA_OK</code>, <code>YASA_TOO_SMALL</code> si les liens
+ *         d�passent la capacit� du tableau ou <code>YASA_ERROR</code>.
+ * \endfrench
+ *
+ * \english
+ * Aligns two arrays of UTF-8 sentences.
+ *
+ * An alignment has at most <code>source_count + target_count</code> links.
+ *
+ * @param aligner The aligner.
+ * @param source The source sentences.
+ * @param source_count The number of source sentences.
+ * @param target The target sentences.
+ * @param target_count The number of target sentences.
+ * @param links Receives the alignment's links.
+ * @param capacity The number of links the array can hold.
+ * @param count Receives the alignment's number of links.
+ *
+ * @return <code>YASA_OK</code>, <code>YASA_TOO_SMALL</code> if the links
+ *         exceed the array's capacity or <code>YASA_ERROR</code>.
+ * \endenglish
+ */
+int yasa_align_sentences( yasa_aligner* aligner,
+                          const char* const* source, size_t source_count,
+                          const char* const* target, size_t target_count,
+                          yasa_link* links, size_t capacity, size_t* count );
+
+/**
+ * \french
+ * Aligne deux textes en UTF-8, dans le format d'entr�e de la
+ * configuration.
+ *
+ * @param aligner L'aligneur.
+ * @param source Le texte source.
+ * @param source_size La taille du texte source, en octets.
+ * @param target Le texte cible.
+ * @param target_size La taille du texte cible, en octets.
+ * @param links Re�oit les liens de l'alignement.
+ * @param capacity Le nombre de liens que peut contenir le tableau.
+ * @param count Re�oit le nombre de liens de l'alignement.
+ *
+ * @return <code>YASA_OK</code>, <code>YASA_TOO_SMALL</code> si les liens
+ *         d�passent la capacit� du tableau ou <code>YASA_ERROR</code>.
+ * \endfrench
+ *
+ * \english
+ * Aligns two UTF-8 texts, in the configuration's input format.
+ *
+ * @param aligner The aligner.
+ * @param source The source text.
+ * @param source_size The source text's size, in bytes.
+ * @param target The target text.
+ * @param target_size The target text's size, in bytes.
+ * @param links Receives the alignment's links.
+ * @param capacity The number of links the array can hold.
+ * @param count Receives the alignment's number of links.
+ *
+ * @return <code>YASA_OK</code>, <code>YASA_TOO_SMALL</code> if the links
+ *         exceed the array's capacity or <code>YASA_ERROR</code>.
+ * \endenglish
+ */
+int yasa_align_buffers( yasa_aligner* aligner,
+                        const char* source, size_t source_size,
+                        const char* target, size_t target_size,
+                        yasa_link* links, size_t capacity, size_t* count );
+
+/**
+ * \french
+ * Retourne la raison du dernier �chec d'un aligneur.
+ *
+ * @param aligner L'aligneur.
+ *
+ * @return Le message, vide si aucun appel n'a �chou�.  Il reste valide
+ *         jusqu'au prochain appel sur l'aligneur.
+ * \endfrench
+ *
+ * \english
+ * Returns the reason of an aligner's last failure.
+ *
+ * @param aligner The aligner.
+ *
+ * @return The message, empty if no call failed.  It stays valid until the
+ *         next call on the aligner.
+ * \endenglish
+ */
+const char* yasa_error( const yasa_aligner* aligner );
+
+/**
+ * \french
+ * D�truit un aligneur.
+ *
+ * @param aligner L'aligneur, ou <code>NULL</code>.
+ * \endfrench
+ *
+ * \english
+ * Destroys an aligner.
+ *
+ * @param aligner The aligner, or <code>NULL</code>.
+ * \endenglish
+ */
+void yasa_destroy( yasa_aligner* aligner );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,155 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+/*
+ * Compil�s avec JAPA_MEMORY, les ex�cutables remplacent les op�rateurs
+ * globaux new et delete pour que MemoryUsage compte les allocations.  Ce
+ * fichier n'est li� qu'aux ex�cutables : la biblioth�que ne touche jamais
+ * l'allocation des programmes qui l'utilisent.
+ */
+
+#ifdef JAPA_MEMORY
+
+#include <cstdlib>
+#include <new>
+
+#include <memoryusage.h>
+
+#if __cplusplus >= 201103L
+    #define JAPA_THROW_BAD_ALLOC
+    #define JAPA_NO_THROW noexcept
+#else
+    #define JAPA_THROW_BAD_ALLOC throw( std::bad_alloc )
+    #define JAPA_NO_THROW throw()
+#endif
+
+/**
+ * La taille de l'en-t�te qui conserve la taille d'un bloc, choisie pour
+ * garder l'alignement de <code>malloc</code>.
+ */
+static const size_t MEMORY_HEADER = 16;
+
+/**
+ * Alloue un bloc compt�.  Sa taille est conserv�e juste avant lui.
+ *
+ * @param size La taille demand�e.
+ *
+ * @return Le bloc, <code>NULL</code> si la m�moire manque.
+ */
+static void* allocate( const size_t size );
+
+/**
+ * Lib�re un bloc compt�.
+ *
+ * @param p Le bloc, ou <code>NULL</code>.
+ */
+static void release( void* p );
+
+// ------------------------------------------------------------------------ //
+void* operator new( size_t size ) JAPA_THROW_BAD_ALLOC
+{
+    void* p = allocate( size );
+
+    if( p == NULL )
+    {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+// ------------------------------------------------------------------------ //
+void* operator new[]( size_t size ) JAPA_THROW_BAD_ALLOC
+{
+    void* p = allocate( size );
+
+    if( p == NULL )
+    {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+// ------------------------------------------------------------------------ //
+void* operator new( size_t size, const std::nothrow_t& ) JAPA_NO_THROW
+{
+    return allocate( size );
+}
+
+// ------------------------------------------------------------------------ //
+void* operator new[]( size_t size, const std::nothrow_t& ) JAPA_NO_THROW
+{
+    return allocate( size );
+}
+
+// ------------------------------------------------------------------------ //
+void operator delete( void* p ) JAPA_NO_THROW
+{
+    release( p );
+}
+
+// ------------------------------------------------------------------------ //
+void operator delete[]( void* p ) JAPA_NO_THROW
+{
+    release( p );
+}
+
+// ------------------------------------------------------------------------ //
+void operator delete( void* p, const std::nothrow_t& ) JAPA_NO_THROW
+{
+    release( p );
+}
+
+// ------------------------------------------------------------------------ //
+void operator delete[]( void* p, const std::nothrow_t& ) JAPA_NO_THROW
+{
+    release( p );
+}
+
+// ------------------------------------------------------------------------ //
+static void* allocate( const size_t size )
+{
+    char* block = ( char* )std::malloc( size + MEMORY_HEADER );
+
+    if( block == NULL )
+    {
+        return NULL;
+    }
+
+    *( size_t* )block = size;
+    japa::MemoryUsage::countAllocation( size );
+
+    return block + MEMORY_HEADER;
+}
+
+// ------------------------------------------------------------------------ //
+static void release( void* p )
+{
+    char* block = ( char* )p - MEMORY_HEADER;
+
+    if( p == NULL )
+    {
+        return;
+    }
+
+    japa::MemoryUsage::countRelease( *( size_t* )block );
+    std::free( block );
+}
+
+#endif
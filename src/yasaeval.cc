@@ -0,0 +1,105 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#include <iostream>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include <japaevaluator.h>
+
+namespace
+{
+    const std::string HELP = 
+"Usage : yasa-eval [-j jobs] [-q f1] reference source target [grid]\n\
+\n\
+Align a text pair with every configuration of a parameter grid and score\n\
+each alignment against a reference alignment (ARCADE or CesAlign, as\n\
+written by -o a or -o c).\n\
+\n\
+grid :\n\
+\n\
+yasa options, each followed by its values separated by commas.  An option\n\
+with several values is a dimension of the grid; an option with a single\n\
+value, or without argument, is shared by all configurations :\n\
+\n\
+yasa-eval gold.arc a.txt b.txt -i o -b 5,20,50 -s c,f\n\
+\n\
+-j jobs :\n\
+\n\
+The number of configurations aligned at once, one process each.  Default\n\
+is the number of processors; with several jobs, each alignment uses one\n\
+thread.\n\
+\n\
+-q f1 :\n\
+\n\
+Also report the configuration with the least CPU time among those whose\n\
+F-measure reaches f1.\n\
+\n\
+The report has one line per configuration, separated by tabs : the\n\
+precision, recall and F-measure of the links, the elapsed and CPU times in\n\
+seconds, the largest resident size in MB, whether the configuration is on\n\
+the Pareto frontier of F-measure and CPU time, and its options.  A link is\n\
+right if the reference holds exactly the same sentences.\n";
+}
+
+/**
+ * Fonction principale.  Lance l'�valuation.
+ *
+ * @param argc Le nombre d'arguments � la ligne de commande
+ * @param argv Les valeurs de ces arguments
+ *
+ * @return 0 si tous s'est bien d�roul�
+ */
+int main( int argc, char** argv )
+{
+    int retvalue = 0;
+    
+    try
+    {
+        // must set a UTF-8 locale
+        try
+        {
+            std::locale::global( std::locale( "en_US.UTF-8" ) );
+        }
+        catch( std::exception& ex )
+        {
+            std::locale::global( std::locale( "" ) );
+        }
+
+        if( argc < 2 || strcmp( argv[ 1 ], "-h" ) == 0 )
+        {
+            std::cerr << HELP;
+            return argc < 2 ? -1 : 0;
+        }
+
+        japa::JapaEvaluator evaluator;
+
+        evaluator.parse( argc, argv );
+        evaluator.run( std::cout );
+    }
+    catch( std::exception& ex )
+    {
+        std::cerr << ex.what() << std::endl;
+        retvalue = -1;
+    }
+    
+    return retvalue;
+}
@@ -0,0 +1,116 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#include <iostream>
+#include <clocale>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <binarylexicon.h>
+#include <binarylexiconwriter.h>
+#include <japasynonymparser.h>
+#include <toolbox.h>
+
+namespace
+{
+    const std::string HELP = 
+"Usage : yasa-lexicon compile lexicon_file... compiled_file\n\
+\n\
+Compile one or more synonym dictionaries into a binary lexicon that yasa\n\
+maps in memory when it is given with the -L option.\n\
+\n\
+lexicon_file :\n\
+\n\
+A synonym dictionary in the format read by yasa -L : one entry per line, a\n\
+source word followed by a target word.  The words are normalized (accents\n\
+stripped, upper cased) and the duplicate entries removed.\n\
+\n\
+compiled_file :\n\
+\n\
+The binary lexicon to write.\n";
+}
+
+/**
+ * Fonction principale.  Compile des lexiques bilingues.
+ *
+ * @param argc Le nombre d'arguments � la ligne de commande
+ * @param argv Les valeurs de ces arguments
+ *
+ * @return 0 si tous s'est bien d�roul�
+ */
+int main( int argc, char** argv )
+{
+    int retvalue = 0;
+    
+    try
+    {
+        // must set a UTF-8 locale
+        try
+        {
+            std::locale::global( std::locale( "en_US.UTF-8" ) );
+        }
+        catch( std::exception& ex )
+        {
+            std::locale::global( std::locale( "" ) );
+        }
+
+        if( argc < 4 || strcmp( argv[ 1 ], "compile" ) != 0 )
+        {
+            std::cerr << HELP;
+            return -1;
+        }
+
+        japa::BinaryLexiconWriter writer;
+        japa::JapaSynonymParser parser;
+        japa::BinaryLexicon lexicon;
+        std::string output( argv[ argc - 1 ] );
+
+        // Lit chaque dictionnaire texte
+        for( int i = 2; i < argc - 1; i++ )
+        {
+            std::wifstream in( argv[ i ] );
+
+            if( in.fail() )
+            {
+                throw std::runtime_error( 
+                        std::string( "Can't open synonym dictionary : " ) + 
+                        argv[ i ] );
+            }
+
+            parser( in, writer );
+        }
+
+        writer.write( output );
+
+        // V�rifie le lexique �crit
+        lexicon.open( output );
+        std::cerr << writer.getPairCount() << " entries read, " 
+                  << lexicon.getSourceCount() << " source words written to "
+                  << output << std::endl;
+    }
+    catch( std::exception& ex )
+    {
+        std::cerr << ex.what() << std::endl;
+        retvalue = -1;
+    }
+    
+    return retvalue;
+}
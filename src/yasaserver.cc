@@ -0,0 +1,105 @@
+/*
+
+Copyright 2013 RALI
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/  
+
+#include <iostream>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include <japaserver.h>
+
+namespace
+{
+    const std::string HELP = 
+"Usage : yasa-server [yasa options] [socket]\n\
+\n\
+Keep yasa loaded and align text pairs on request.  The options given here\n\
+(lexicons, scores, search space) are the defaults of every request; the\n\
+text synonym dictionaries are compiled once at startup.\n\
+\n\
+socket :\n\
+\n\
+A local socket to listen on.  Without it, the requests are read on the\n\
+standard input and the responses written on the standard output.\n\
+\n\
+Each request is a JSON object on one line :\n\
+\n\
+{\"id\":1,\"source\":\"a.txt\",\"target\":\"b.txt\",\"options\":[\"-i\",\"o\"]}\n\
+\n\
+The texts can also be given inline with source_text and target_text, and\n\
+the alignment written to a file named by output instead of being returned.\n\
+Each response is a JSON object on one line, carrying the request's id, a\n\
+status (ok or error) and the alignment or an error message.  With OpenMP,\n\
+the requests are aligned in parallel and may be answered out of order.\n\
+Requests can't use the help, verbose, trace, document list, shard, cache\n\
+and progress options.\n";
+}
+
+/**
+ * Fonction principale.  Lance le serveur d'alignement.
+ *
+ * @param argc Le nombre d'arguments � la ligne de commande
+ * @param argv Les valeurs de ces arguments
+ *
+ * @return 0 si tous s'est bien d�roul�
+ */
+int main( int argc, char** argv )
+{
+    int retvalue = 0;
+    
+    try
+    {
+        // must set a UTF-8 locale
+        try
+        {
+            std::locale::global( std::locale( "en_US.UTF-8" ) );
+        }
+        catch( std::exception& ex )
+        {
+            std::locale::global( std::locale( "" ) );
+        }
+
+        if( argc > 1 && strcmp( argv[ 1 ], "-h" ) == 0 )
+        {
+            std::cerr << HELP;
+            return 0;
+        }
+
+        japa::JapaServer server;
+
+        server.parse( argc, argv );
+
+        if( server.getSocket().empty() )
+        {
+            server.serve( stdin, stdout );
+        }
+        else
+        {
+            server.listen( server.getSocket() );
+        }
+    }
+    catch( std::exception& ex )
+    {
+        std::cerr << ex.what() << std::endl;
+        retvalue = -1;
+    }
+    
+    return retvalue;
+}